@@ -0,0 +1,111 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file accessorBenchmark.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Time reading and setting the reserved header values of an Event
+ *        through references and reused strings, against copying them into
+ *        new strings and formatting dates with asctime as the accessors did
+ *        before.
+ *
+ * usage: accessorBenchmark [iterations]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/ctrl/events.h"
+
+using lsst::daf::base::PropertySet;
+namespace dafBase = lsst::daf::base;
+namespace ctrlEvents = lsst::ctrl::events;
+
+template<typename Func>
+double timePerCall(Func func, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        func();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / iterations;
+}
+
+void report(std::string const& name, double copying, double reusing) {
+    std::cout << std::setw(12) << name
+              << std::setw(14) << std::fixed << std::setprecision(1) << copying
+              << std::setw(14) << reusing << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = (argc > 1) ? atoi(argv[1]) : 1000000;
+
+    PropertySet ps;
+    ctrlEvents::Event event("benchmark_run_with_a_long_id", ps);
+    event.setTopic("benchmark_topic_with_a_long_name");
+    event.setStatus("benchmark_status_with_a_long_name");
+
+    std::cout << std::setw(12) << "accessor"
+              << std::setw(14) << "copying (ns)"
+              << std::setw(14) << "reusing" << std::endl;
+
+    size_t total = 0;
+
+    report("getters", timePerCall([&]() {
+        std::string type = event.getType();
+        std::string status = event.getStatus();
+        std::string topic = event.getTopic();
+        std::string runId = event.getRunId();
+        total += type.size() + status.size() + topic.size() + runId.size();
+    }, iterations), timePerCall([&]() {
+        total += event.getType().size() + event.getStatus().size() +
+                 event.getTopic().size() + event.getRunId().size();
+    }, iterations));
+
+    report("setStatus", timePerCall([&]() {
+        event.setStatus(std::string("benchmark_status_set_in_a_loop"));
+    }, iterations), timePerCall([&]() {
+        event.setStatus("benchmark_status_set_in_a_loop");
+    }, iterations));
+
+    std::string date;
+    report("date", timePerCall([&]() {
+        struct tm time = dafBase::DateTime(event.getEventTime()).gmtime();
+        std::string date = asctime(&time);
+        total += date.size();
+    }, iterations), timePerCall([&]() {
+        event.getEventDate(date);
+        total += date.size();
+    }, iterations));
+
+    return (total == 0);
+}
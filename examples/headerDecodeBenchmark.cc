@@ -0,0 +1,182 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file headerDecodeBenchmark.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Time the conversion of a received message header into each type of
+ *        Event, against the decode it replaced.
+ *
+ * usage: headerDecodeBenchmark [iterations]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "activemq/commands/ActiveMQTextMessage.h"
+
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/ctrl/events.h"
+#include "lsst/ctrl/events/EventFactory.h"
+#include "lsst/ctrl/events/EventTypes.h"
+
+using lsst::daf::base::PropertySet;
+namespace ctrlEvents = lsst::ctrl::events;
+
+/* previous header decode: EventFactory fetched the property names and threw
+ * them away, Event(msg) fetched them again and walked them twice, and the
+ * subclass constructors then read their own properties a second time.  The
+ * body is not decoded here. */
+void legacyDecode(cms::Message* msg, PropertySet& ps, std::set<std::string>& keywords) {
+    std::vector<std::string> discarded = msg->getPropertyNames();
+    std::string type = msg->getStringProperty("TYPE");
+
+    std::vector<std::string> names = msg->getPropertyNames();
+    for (std::string name : names) {
+        keywords.insert(name);
+    }
+
+    ps.set(ctrlEvents::Event::EVENTTIME, msg->getCMSTimestamp());
+    for (std::string name : names) {
+        switch (msg->getPropertyValueType(name)) {
+            case cms::Message::INTEGER_TYPE:
+                ps.set(name, msg->getIntProperty(name));
+                break;
+            case cms::Message::LONG_TYPE:
+                ps.set(name, msg->getLongProperty(name));
+                break;
+            case cms::Message::DOUBLE_TYPE:
+                ps.set(name, msg->getDoubleProperty(name));
+                break;
+            case cms::Message::STRING_TYPE:
+                ps.set(name, msg->getStringProperty(name));
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (type == ctrlEvents::EventTypes::EVENT)
+        return;
+
+    keywords.insert(ctrlEvents::StatusEvent::ORIG_HOSTNAME);
+    keywords.insert(ctrlEvents::StatusEvent::ORIG_PROCESSID);
+    keywords.insert(ctrlEvents::StatusEvent::ORIG_LOCALID);
+    ps.set(ctrlEvents::StatusEvent::ORIG_HOSTNAME, (std::string)msg->getStringProperty(ctrlEvents::StatusEvent::ORIG_HOSTNAME));
+    ps.set(ctrlEvents::StatusEvent::ORIG_PROCESSID, (int)msg->getIntProperty(ctrlEvents::StatusEvent::ORIG_PROCESSID));
+    ps.set(ctrlEvents::StatusEvent::ORIG_LOCALID, (int)msg->getIntProperty(ctrlEvents::StatusEvent::ORIG_LOCALID));
+
+    if (type == ctrlEvents::EventTypes::COMMAND) {
+        keywords.insert(ctrlEvents::CommandEvent::DEST_HOSTNAME);
+        keywords.insert(ctrlEvents::CommandEvent::DEST_PROCESSID);
+        keywords.insert(ctrlEvents::CommandEvent::DEST_LOCALID);
+        ps.set(ctrlEvents::CommandEvent::DEST_HOSTNAME, (std::string)msg->getStringProperty(ctrlEvents::CommandEvent::DEST_HOSTNAME));
+        ps.set(ctrlEvents::CommandEvent::DEST_PROCESSID, (int)msg->getIntProperty(ctrlEvents::CommandEvent::DEST_PROCESSID));
+        ps.set(ctrlEvents::CommandEvent::DEST_LOCALID, (int)msg->getIntProperty(ctrlEvents::CommandEvent::DEST_LOCALID));
+    } else if (type == ctrlEvents::EventTypes::LOG) {
+        keywords.insert(ctrlEvents::LogEvent::LEVEL);
+        keywords.insert(ctrlEvents::LogEvent::LOGGER);
+        ps.set(ctrlEvents::LogEvent::LEVEL, msg->getIntProperty(ctrlEvents::LogEvent::LEVEL));
+        ps.set(ctrlEvents::LogEvent::LOGGER, msg->getStringProperty(ctrlEvents::LogEvent::LOGGER));
+    }
+}
+
+template<typename Func>
+double timePerEvent(Func func, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        func();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(stop - start).count() / iterations;
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = (argc > 1) ? atoi(argv[1]) : 100000;
+
+    PropertySet ps;
+    ps.set("myname", std::string("myname"));
+    ps.set("value", 12);
+    ps.set("logger.status", std::string("my logger special status"));
+    ps.set(ctrlEvents::LogEvent::LEVEL, 10000);
+    ps.set(ctrlEvents::LogEvent::LOGGER, std::string("ctrl.events.benchmark"));
+
+    PropertySet filterable;
+    filterable.set("FOO", std::string("bar"));
+    filterable.set("PLOUGH", 123);
+
+    ctrlEvents::LocationId originator;
+    ctrlEvents::LocationId destination;
+
+    ctrlEvents::Event event("benchmark_run", ps, filterable);
+    ctrlEvents::StatusEvent statusEvent("benchmark_run", originator, ps, filterable);
+    ctrlEvents::CommandEvent commandEvent("benchmark_run", originator, destination, ps, filterable);
+    ctrlEvents::LogEvent logEvent(originator, ps);
+
+    std::vector<std::pair<std::string, ctrlEvents::Event*> > events;
+    events.push_back(std::make_pair(std::string("Event"), &event));
+    events.push_back(std::make_pair(std::string("StatusEvent"), &statusEvent));
+    events.push_back(std::make_pair(std::string("CommandEvent"), &commandEvent));
+    events.push_back(std::make_pair(std::string("LogEvent"), &logEvent));
+
+    std::cout << std::setw(14) << "event"
+              << std::setw(18) << "previous (us)"
+              << std::setw(18) << "header (us)"
+              << std::setw(10) << "speedup"
+              << std::setw(18) << "with body (us)" << std::endl;
+
+    for (auto const& entry : events) {
+        activemq::commands::ActiveMQTextMessage msg;
+        entry.second->marshall(&msg);
+        msg.setStringProperty("TOPIC", "benchmark");
+        msg.setLongProperty("PUBTIME", 1);
+
+        double legacy = timePerEvent([&msg]() {
+            PropertySet ps;
+            std::set<std::string> keywords;
+            legacyDecode(&msg, ps, keywords);
+        }, iterations);
+        double header = timePerEvent([&msg]() {
+            PTR(ctrlEvents::Event) ev = ctrlEvents::EventFactory::createEvent(&msg);
+        }, iterations);
+        double body = timePerEvent([&msg]() {
+            PTR(ctrlEvents::Event) ev = ctrlEvents::EventFactory::createEvent(&msg);
+            ev->getCustomPropertySet();
+        }, iterations);
+
+        std::cout << std::setw(14) << entry.first
+                  << std::setw(18) << std::fixed << std::setprecision(2) << legacy
+                  << std::setw(18) << header
+                  << std::setw(9) << legacy / header << "x"
+                  << std::setw(18) << body << std::endl;
+    }
+    return 0;
+}
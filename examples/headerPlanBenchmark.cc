@@ -0,0 +1,184 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file headerPlanBenchmark.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Time writing the message header of an Event of each type with its
+ *        HeaderPlan, against looking up the type of every header property
+ *        and writing the subclass properties a second time, as before.
+ *
+ * usage: headerPlanBenchmark [iterations]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "activemq/commands/ActiveMQTextMessage.h"
+
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/ctrl/events.h"
+
+using lsst::daf::base::PropertySet;
+namespace ctrlEvents = lsst::ctrl::events;
+
+/* a message which only counts the header properties set, so that the
+ * times are those of the event rather than of the message */
+class CountingMessage : public activemq::commands::ActiveMQTextMessage {
+public:
+    CountingMessage() : properties(0) {}
+
+    virtual void setBooleanProperty(std::string const&, bool) { properties++; }
+    virtual void setShortProperty(std::string const&, short) { properties++; }
+    virtual void setIntProperty(std::string const&, int) { properties++; }
+    virtual void setLongProperty(std::string const&, long long) { properties++; }
+    virtual void setDoubleProperty(std::string const&, double) { properties++; }
+    virtual void setFloatProperty(std::string const&, float) { properties++; }
+    virtual void setStringProperty(std::string const&, std::string const&) { properties++; }
+
+    long properties;
+};
+
+/* previous header: the type of every header property was looked up in
+ * the property set, and StatusEvent, CommandEvent and LogEvent then set
+ * their own properties again */
+void legacyHeader(PropertySet const& ps, std::vector<std::string> const& names,
+                  std::vector<std::string> const& extra, cms::Message* msg) {
+    for (std::vector<std::string> const* list : {&names, &extra}) {
+        for (std::string const& name : *list) {
+            std::type_info const& t = ps.typeOf(name);
+            if (t == typeid(bool))
+                msg->setBooleanProperty(name, ps.get<bool>(name));
+            else if (t == typeid(short))
+                msg->setShortProperty(name, ps.get<short>(name));
+            else if (t == typeid(int))
+                msg->setIntProperty(name, ps.get<int>(name));
+            else if (t == typeid(long))
+                msg->setLongProperty(name, ps.get<long>(name));
+            else if (t == typeid(long long))
+                msg->setLongProperty(name, ps.get<long long>(name));
+            else if (t == typeid(double))
+                msg->setDoubleProperty(name, ps.get<double>(name));
+            else if (t == typeid(float))
+                msg->setFloatProperty(name, ps.get<float>(name));
+            else if (t == typeid(std::string))
+                msg->setStringProperty(name, ps.get<std::string>(name));
+        }
+    }
+}
+
+template<typename Func>
+double timePerEvent(Func func, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        func();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(stop - start).count() / iterations;
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = (argc > 1) ? atoi(argv[1]) : 100000;
+
+    PropertySet ps;
+    ps.set("myname", std::string("myname"));
+    ps.set("value", 12);
+    ps.set(ctrlEvents::LogEvent::LEVEL, 10000);
+    ps.set(ctrlEvents::LogEvent::LOGGER, std::string("ctrl.events.benchmark"));
+
+    PropertySet filterable;
+    filterable.set("FOO", std::string("bar"));
+    filterable.set("PLOUGH", 123);
+
+    ctrlEvents::LocationId originator;
+    ctrlEvents::LocationId destination;
+
+    ctrlEvents::Event event("benchmark_run", ps, filterable);
+    ctrlEvents::StatusEvent statusEvent("benchmark_run", originator, ps, filterable);
+    ctrlEvents::CommandEvent commandEvent("benchmark_run", originator, destination, ps, filterable);
+    ctrlEvents::LogEvent logEvent(originator, ps);
+
+    std::vector<std::string> status = {
+        ctrlEvents::StatusEvent::ORIG_HOSTNAME, ctrlEvents::StatusEvent::ORIG_PROCESSID,
+        ctrlEvents::StatusEvent::ORIG_LOCALID
+    };
+    std::vector<std::string> command = status;
+    command.push_back(ctrlEvents::CommandEvent::DEST_HOSTNAME);
+    command.push_back(ctrlEvents::CommandEvent::DEST_PROCESSID);
+    command.push_back(ctrlEvents::CommandEvent::DEST_LOCALID);
+    std::vector<std::string> log = status;
+    log.push_back(ctrlEvents::LogEvent::LEVEL);
+    log.push_back(ctrlEvents::LogEvent::LOGGER);
+
+    struct Entry {
+        std::string name;
+        ctrlEvents::Event* event;
+        std::vector<std::string> extra;
+    };
+    std::vector<Entry> events = {
+        {"Event", &event, {}},
+        {"StatusEvent", &statusEvent, status},
+        {"CommandEvent", &commandEvent, command},
+        {"LogEvent", &logEvent, log}
+    };
+
+    std::cout << std::setw(14) << "event"
+              << std::setw(18) << "previous (us)"
+              << std::setw(14) << "plan (us)"
+              << std::setw(10) << "speedup"
+              << std::setw(12) << "written"
+              << std::setw(12) << "was" << std::endl;
+
+    long total = 0;
+    for (Entry const& entry : events) {
+        entry.event->setTopic("benchmark");
+        CONST_PTR(PropertySet) properties = entry.event->getPropertySet();
+        std::vector<std::string> names = entry.event->getFilterablePropertyNames();
+
+        CountingMessage previousMsg;
+        double previous = timePerEvent([&]() {
+            legacyHeader(*properties, names, entry.extra, &previousMsg);
+        }, iterations);
+
+        CountingMessage planMsg;
+        double plan = timePerEvent([&]() {
+            entry.event->populateHeader(&planMsg);
+        }, iterations);
+        total += planMsg.properties;
+
+        std::cout << std::setw(14) << entry.name
+                  << std::setw(18) << std::fixed << std::setprecision(3) << previous
+                  << std::setw(14) << plan
+                  << std::setw(9) << std::setprecision(2) << previous / plan << "x"
+                  << std::setw(12) << planMsg.properties / iterations
+                  << std::setw(12) << previousMsg.properties / iterations << std::endl;
+    }
+    return (total == 0);
+}
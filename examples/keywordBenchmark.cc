@@ -0,0 +1,172 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file keywordBenchmark.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Time the keyword handling of a received Event of each type,
+ *        using the KeywordSet against the std::set it replaced.
+ *
+ * usage: keywordBenchmark [iterations]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "activemq/commands/ActiveMQTextMessage.h"
+
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/ctrl/events.h"
+#include "lsst/ctrl/events/EventFactory.h"
+#include "lsst/ctrl/events/KeywordSet.h"
+
+using lsst::daf::base::PropertySet;
+namespace ctrlEvents = lsst::ctrl::events;
+
+/* previous keywords: every event type inserted its own names into a
+ * std::set, Event(msg) inserted every header name, and the custom names
+ * were found by a lookup and an erase for each property. */
+size_t legacyKeywords(std::vector<std::string> const& header, std::vector<std::string> names) {
+    std::set<std::string> keywords;
+    keywords.insert(ctrlEvents::Event::TYPE);
+    keywords.insert(ctrlEvents::Event::EVENTTIME);
+    keywords.insert(ctrlEvents::Event::STATUS);
+    keywords.insert(ctrlEvents::Event::TOPIC);
+    keywords.insert(ctrlEvents::Event::PUBTIME);
+    for (std::string const& name : header) {
+        keywords.insert(name);
+    }
+
+    std::vector<std::string> filterable;
+    for (std::string const& name : keywords) {
+        filterable.push_back(name);
+    }
+
+    for (std::vector<std::string>::iterator it = names.begin(); it != names.end();) {
+        if (keywords.find(*it) == keywords.end())
+            it++;
+        else
+            names.erase(it);
+    }
+    return filterable.size() + names.size();
+}
+
+size_t keywordSet(std::vector<std::string> const& header, std::vector<std::string> names) {
+    ctrlEvents::KeywordSet keywords;
+    keywords.add(ctrlEvents::KeywordSet::EVENT_KEYWORDS);
+    for (std::string const& name : header) {
+        keywords.insert(name);
+    }
+
+    std::vector<std::string> filterable;
+    filterable.reserve(keywords.size());
+    keywords.forEach([&filterable](std::string const& name) { filterable.push_back(name); });
+
+    names.erase(std::remove_if(names.begin(), names.end(),
+                               [&keywords](std::string const& name) { return keywords.contains(name); }),
+                names.end());
+    return filterable.size() + names.size();
+}
+
+template<typename Func>
+double timePerEvent(Func func, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        func();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(stop - start).count() / iterations;
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = (argc > 1) ? atoi(argv[1]) : 100000;
+
+    PropertySet ps;
+    ps.set("myname", std::string("myname"));
+    ps.set("value", 12);
+    ps.set("logger.status", std::string("my logger special status"));
+    ps.set(ctrlEvents::LogEvent::LEVEL, 10000);
+    ps.set(ctrlEvents::LogEvent::LOGGER, std::string("ctrl.events.benchmark"));
+
+    PropertySet filterable;
+    filterable.set("FOO", std::string("bar"));
+    filterable.set("PLOUGH", 123);
+
+    ctrlEvents::LocationId originator;
+    ctrlEvents::LocationId destination;
+
+    ctrlEvents::Event event("benchmark_run", ps, filterable);
+    ctrlEvents::StatusEvent statusEvent("benchmark_run", originator, ps, filterable);
+    ctrlEvents::CommandEvent commandEvent("benchmark_run", originator, destination, ps, filterable);
+    ctrlEvents::LogEvent logEvent(originator, ps);
+
+    std::vector<std::pair<std::string, ctrlEvents::Event*> > events;
+    events.push_back(std::make_pair(std::string("Event"), &event));
+    events.push_back(std::make_pair(std::string("StatusEvent"), &statusEvent));
+    events.push_back(std::make_pair(std::string("CommandEvent"), &commandEvent));
+    events.push_back(std::make_pair(std::string("LogEvent"), &logEvent));
+
+    std::cout << std::setw(14) << "event"
+              << std::setw(18) << "previous (us)"
+              << std::setw(18) << "keywords (us)"
+              << std::setw(10) << "speedup"
+              << std::setw(18) << "receive (us)" << std::endl;
+
+    size_t total = 0;
+    for (auto const& entry : events) {
+        activemq::commands::ActiveMQTextMessage msg;
+        entry.second->marshall(&msg);
+        msg.setStringProperty("TOPIC", "benchmark");
+        msg.setLongProperty("PUBTIME", 1);
+
+        std::vector<std::string> header = msg.getPropertyNames();
+        std::vector<std::string> names = entry.second->getPropertySet()->names();
+
+        double legacy = timePerEvent([&]() {
+            total += legacyKeywords(header, names);
+        }, iterations);
+        double keywords = timePerEvent([&]() {
+            total += keywordSet(header, names);
+        }, iterations);
+        double receive = timePerEvent([&]() {
+            PTR(ctrlEvents::Event) ev = ctrlEvents::EventFactory::createEvent(&msg);
+            total += ev->getFilterablePropertyNames().size();
+        }, iterations);
+
+        std::cout << std::setw(14) << entry.first
+                  << std::setw(18) << std::fixed << std::setprecision(2) << legacy
+                  << std::setw(18) << keywords
+                  << std::setw(9) << legacy / keywords << "x"
+                  << std::setw(18) << receive << std::endl;
+    }
+    return (total == 0);
+}
@@ -0,0 +1,177 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file marshallBenchmark.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Compare the JSONWriter with the boost::property_tree based
+ *        marshalling it replaced, for status events of typical sizes.
+ *
+ * usage: marshallBenchmark [iterations]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "boost/property_tree/ptree.hpp"
+#include "boost/property_tree/json_parser.hpp"
+
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/ctrl/events/JSONWriter.h"
+
+using lsst::daf::base::PropertySet;
+namespace ctrlEvents = lsst::ctrl::events;
+namespace dafBase = lsst::daf::base;
+
+/* previous marshalling: build a ptree, then serialize it with write_json */
+template<typename T>
+void legacyAdd(std::string const& name, std::string const& tag, PropertySet const& ps, boost::property_tree::ptree& child) {
+    std::vector<T> vec = ps.getArray<T>(name);
+
+    boost::property_tree::ptree children;
+    for (auto iter: vec) {
+        boost::property_tree::ptree pt;
+        pt.put("", iter);
+        children.push_back(std::make_pair(tag, pt));
+    }
+    child.put_child(name, children);
+}
+
+std::string legacyMarshall(PropertySet const& ps) {
+    std::vector<std::string> names = ps.paramNames(false);
+
+    boost::property_tree::ptree child;
+
+    for (std::string name : names) {
+        if (ps.typeOf(name) == typeid(bool)) {
+            legacyAdd<bool>(name, "bool", ps, child);
+        } else if (ps.typeOf(name) == typeid(long)) {
+            legacyAdd<long>(name, "long", ps, child);
+        } else if (ps.typeOf(name) == typeid(long long)) {
+            legacyAdd<long long>(name, "long long", ps, child);
+        } else if (ps.typeOf(name) == typeid(int)) {
+            legacyAdd<int>(name, "int", ps, child);
+        } else if (ps.typeOf(name) == typeid(float)) {
+            legacyAdd<float>(name, "float", ps, child);
+        } else if (ps.typeOf(name) == typeid(double)) {
+            legacyAdd<double>(name, "double", ps, child);
+        } else if (ps.typeOf(name) == typeid(std::string)) {
+            legacyAdd<std::string>(name, "string", ps, child);
+        } else if (ps.typeOf(name) == typeid(dafBase::DateTime)) {
+            std::vector<dafBase::DateTime> vec  = ps.getArray<dafBase::DateTime>(name);
+            for (dafBase::DateTime dateTime : vec) {
+                boost::property_tree::ptree pt;
+                pt.put("datetime", (dateTime).nsecs());
+                child.put_child(name, pt);
+            }
+        }
+    }
+    std::ostringstream payload;
+    write_json(payload, child, false);
+
+    return payload.str();
+}
+
+/* a status event payload with count properties: mostly scalars, some
+ * strings, a few short arrays and a nested PropertySet */
+PTR(PropertySet) createStatusProperties(int count) {
+    PTR(PropertySet) psp(new PropertySet);
+    for (int i = 0; i < count; i++) {
+        std::ostringstream name;
+        name << "property" << i;
+        switch (i % 10) {
+            case 0:
+            case 1:
+            case 2:
+            case 3:
+                psp->set(name.str(), 1.0/(i+3));
+                break;
+            case 4:
+            case 5:
+                psp->set(name.str(), i * 1000);
+                break;
+            case 6:
+                psp->set(name.str(), (long long)i * 1000000007LL);
+                break;
+            case 7:
+                psp->set(name.str(), std::string("visit processing stage complete"));
+                break;
+            case 8:
+                for (int j = 0; j < 8; j++) {
+                    psp->add(name.str(), j * 0.125 + i);
+                }
+                break;
+            case 9:
+                psp->set("ccd." + name.str(), i);
+                break;
+        }
+    }
+    return psp;
+}
+
+template<typename Func>
+double timePerEvent(Func func, PropertySet const& ps, int iterations, size_t& bytes) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        bytes = func(ps).size();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(stop - start).count() / iterations;
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = (argc > 1) ? atoi(argv[1]) : 20000;
+
+    std::cout << std::setw(12) << "properties"
+              << std::setw(12) << "bytes"
+              << std::setw(16) << "ptree (us)"
+              << std::setw(16) << "JSONWriter (us)"
+              << std::setw(10) << "speedup" << std::endl;
+
+    int sizes[] = { 20, 50, 100, 200 };
+    for (int count : sizes) {
+        PTR(PropertySet) psp = createStatusProperties(count);
+
+        size_t legacyBytes, writerBytes;
+        double legacy = timePerEvent(legacyMarshall, *psp, iterations, legacyBytes);
+        double writer = timePerEvent(
+            [](PropertySet const& ps) { return ctrlEvents::JSONWriter::write(ps); },
+            *psp, iterations, writerBytes);
+
+        std::cout << std::setw(12) << count
+                  << std::setw(12) << writerBytes
+                  << std::setw(16) << std::fixed << std::setprecision(2) << legacy
+                  << std::setw(16) << writer
+                  << std::setw(9) << legacy / writer << "x" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,145 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file originatorBenchmark.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Compare the message headers of a StatusEvent, CommandEvent and
+ *        LogEvent with their originators and destinations sent as packed
+ *        IDs against the three properties each they replace.
+ *
+ * usage: originatorBenchmark [iterations]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "activemq/commands/ActiveMQTextMessage.h"
+
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/ctrl/events.h"
+
+using lsst::daf::base::PropertySet;
+namespace ctrlEvents = lsst::ctrl::events;
+
+/* a message which only adds up the header properties set, and the bytes
+ * of their names and values */
+class SizingMessage : public activemq::commands::ActiveMQTextMessage {
+public:
+    SizingMessage() : properties(0), bytes(0) {}
+
+    virtual void setBooleanProperty(std::string const& name, bool) { add(name, 1); }
+    virtual void setShortProperty(std::string const& name, short) { add(name, 2); }
+    virtual void setIntProperty(std::string const& name, int) { add(name, 4); }
+    virtual void setLongProperty(std::string const& name, long long) { add(name, 8); }
+    virtual void setDoubleProperty(std::string const& name, double) { add(name, 8); }
+    virtual void setFloatProperty(std::string const& name, float) { add(name, 4); }
+    virtual void setStringProperty(std::string const& name, std::string const& value) { add(name, value.size()); }
+
+    void add(std::string const& name, size_t size) {
+        properties++;
+        bytes += name.size() + size;
+    }
+
+    long properties;
+    long bytes;
+};
+
+template<typename Func>
+double timePerEvent(Func func, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        func();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(stop - start).count() / iterations;
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = (argc > 1) ? atoi(argv[1]) : 100000;
+
+    PropertySet ps;
+    ps.set("myname", std::string("myname"));
+    ps.set(ctrlEvents::LogEvent::LEVEL, 10000);
+    ps.set(ctrlEvents::LogEvent::LOGGER, std::string("ctrl.events.benchmark"));
+
+    ctrlEvents::LocationId originator;
+    ctrlEvents::LocationId destination;
+
+    ctrlEvents::StatusEvent statusEvent("benchmark_run", originator, ps);
+    ctrlEvents::CommandEvent commandEvent("benchmark_run", originator, destination, ps);
+    ctrlEvents::LogEvent logEvent(originator, ps);
+
+    std::vector<std::pair<std::string, ctrlEvents::Event*> > events;
+    events.push_back(std::make_pair(std::string("StatusEvent"), &statusEvent));
+    events.push_back(std::make_pair(std::string("CommandEvent"), &commandEvent));
+    events.push_back(std::make_pair(std::string("LogEvent"), &logEvent));
+
+    std::cout << std::setw(14) << "event"
+              << std::setw(14) << "properties"
+              << std::setw(10) << "compact"
+              << std::setw(10) << "bytes"
+              << std::setw(10) << "compact"
+              << std::setw(16) << "header (us)"
+              << std::setw(12) << "compact" << std::endl;
+
+    long total = 0;
+    for (auto const& entry : events) {
+        entry.second->setTopic("benchmark");
+
+        SizingMessage legacy;
+        double legacyTime = timePerEvent([&]() {
+            entry.second->populateHeader(&legacy);
+        }, iterations);
+
+        SizingMessage compact;
+        double compactTime = timePerEvent([&]() {
+            entry.second->populateHeader(&compact, true);
+        }, iterations);
+        total += compact.properties;
+
+        std::cout << std::setw(14) << entry.first
+                  << std::setw(14) << legacy.properties / iterations
+                  << std::setw(10) << compact.properties / iterations
+                  << std::setw(10) << legacy.bytes / iterations
+                  << std::setw(10) << compact.bytes / iterations
+                  << std::setw(16) << std::fixed << std::setprecision(3) << legacyTime
+                  << std::setw(12) << compactTime << std::endl;
+    }
+
+    double locationTime = timePerEvent([&]() {
+        ctrlEvents::LocationId location;
+        total += location.getId() & 1;
+    }, iterations);
+    std::cout << std::endl << "LocationId construction: " << std::setprecision(3)
+              << locationTime << " us" << std::endl;
+
+    return (total == 0);
+}
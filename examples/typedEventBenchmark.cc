@@ -0,0 +1,154 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file typedEventBenchmark.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Time sending and receiving an event with a fixed set of fields as
+ *        a TypedEvent, against the same event built from a PropertySet.
+ *
+ * usage: typedEventBenchmark [iterations]
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <tuple>
+
+#include "activemq/commands/ActiveMQTextMessage.h"
+
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/ctrl/events.h"
+#include "lsst/ctrl/events/EventFactory.h"
+#include "lsst/ctrl/events/TypedEvent.h"
+
+using lsst::daf::base::PropertySet;
+namespace ctrlEvents = lsst::ctrl::events;
+
+/* the schema of a CCD telemetry event; ccd and raft are filterable */
+struct CcdTelemetry {
+    typedef std::tuple<int, int, double, double, long long, std::string, bool> Types;
+
+    static std::array<ctrlEvents::TypedField, 7> const& fields() {
+        static constexpr std::array<ctrlEvents::TypedField, 7> f = {{
+            { "ccd", true },
+            { "raft", true },
+            { "temperature", false },
+            { "voltage", false },
+            { "exposure", false },
+            { "state", false },
+            { "shutterOpen", false }
+        }};
+        return f;
+    }
+};
+
+template<typename Func>
+double timePerEvent(Func func, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        func();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(stop - start).count() / iterations;
+}
+
+void print(std::string const& step, double generic, double typed) {
+    std::cout << std::setw(10) << step
+              << std::setw(18) << std::fixed << std::setprecision(2) << generic
+              << std::setw(18) << typed
+              << std::setw(9) << generic / typed << "x" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = (argc > 1) ? atoi(argv[1]) : 100000;
+
+    std::cout << std::setw(10) << "step"
+              << std::setw(18) << "PropertySet (us)"
+              << std::setw(18) << "TypedEvent (us)"
+              << std::setw(10) << "speedup" << std::endl;
+
+    double generic = timePerEvent([]() {
+        PropertySet ps;
+        ps.set("temperature", -98.5);
+        ps.set("voltage", 3.3);
+        ps.set("exposure", 1234567890123LL);
+        ps.set("state", std::string("integrating"));
+        ps.set("shutterOpen", true);
+        PropertySet filterable;
+        filterable.set("ccd", 12);
+        filterable.set("raft", 3);
+        ctrlEvents::Event event("benchmark_run", ps, filterable);
+        activemq::commands::ActiveMQTextMessage msg;
+        event.marshall(&msg);
+    }, iterations);
+    double typed = timePerEvent([]() {
+        ctrlEvents::TypedEvent<CcdTelemetry> event("benchmark_run");
+        event.set<0>(12);
+        event.set<1>(3);
+        event.set<2>(-98.5);
+        event.set<3>(3.3);
+        event.set<4>(1234567890123LL);
+        event.set<5>(std::string("integrating"));
+        event.set<6>(true);
+        activemq::commands::ActiveMQTextMessage msg;
+        event.marshall(&msg);
+    }, iterations);
+    print("send", generic, typed);
+
+    ctrlEvents::TypedEvent<CcdTelemetry> sent("benchmark_run");
+    sent.set<0>(12);
+    sent.set<1>(3);
+    sent.set<2>(-98.5);
+    sent.set<3>(3.3);
+    sent.set<4>(1234567890123LL);
+    sent.set<5>(std::string("integrating"));
+    sent.set<6>(true);
+    activemq::commands::ActiveMQTextMessage msg;
+    sent.marshall(&msg);
+
+    double sum = 0;
+    generic = timePerEvent([&msg, &sum]() {
+        PTR(ctrlEvents::Event) event = ctrlEvents::EventFactory::createEvent(&msg);
+        CONST_PTR(PropertySet) ps = event->getPropertySet();
+        sum += ps->get<int>("ccd") + ps->get<int>("raft") + ps->get<double>("temperature") +
+               ps->get<double>("voltage") + ps->getAsInt64("exposure") + ps->get<bool>("shutterOpen") +
+               ps->get<std::string>("state").size();
+    }, iterations);
+    typed = timePerEvent([&msg, &sum]() {
+        ctrlEvents::TypedEvent<CcdTelemetry> event;
+        event.unmarshall(&msg);
+        sum += event.get<0>() + event.get<1>() + event.get<2>() + event.get<3>() + event.get<4>() +
+               event.get<6>() + event.get<5>().size();
+    }, iterations);
+    print("receive", generic, typed);
+
+    // keep the field reads from being optimized away
+    return (sum == 0) ? 1 : 0;
+}
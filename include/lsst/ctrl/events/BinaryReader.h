@@ -0,0 +1,113 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file BinaryReader.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the BinaryReader class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_BINARYREADER_H
+#define LSST_CTRL_EVENTS_BINARYREADER_H
+
+#include <string>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/PropertySet.h"
+
+using lsst::daf::base::PropertySet;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class BinaryReader
+ * @brief Decode the binary encoding written by BinaryWriter into a PropertySet.
+ */
+class BinaryReader {
+public:
+    /**
+     * @brief decode a binary encoded body into a new PropertySet
+     * @param data the encoded bytes
+     * @return a PTR(PropertySet) containing the decoded values
+     * @throws lsst::pex::exceptions::RuntimeError if the data can not be decoded
+     */
+    static PTR(PropertySet) read(std::string const& data);
+
+    /**
+     * @brief decode a binary encoded body, adding its values to a PropertySet
+     * @param data the encoded bytes
+     * @param length the number of bytes in data
+     * @param ps the PropertySet the values are added to
+     * @throws lsst::pex::exceptions::RuntimeError if the data can not be decoded
+     */
+    static void read(unsigned char const* data, size_t length, PropertySet& ps);
+
+    /**
+     * @brief Constructor for a reader positioned at the start of data
+     * @param data the encoded bytes
+     * @param length the number of bytes in data
+     */
+    BinaryReader(unsigned char const* data, size_t length);
+
+    /**
+     * @brief read the count and values of a property, whose type tag is tag,
+     *        and add them to ps
+     */
+    void readValues(unsigned char tag, std::string const& name, PropertySet& ps);
+
+    void readPropertySet(PropertySet& ps);
+    unsigned char readByte();
+    unsigned long long readVarint();
+    long long readZigzag();
+    unsigned long long readFixed(int size);
+    void readFixedArray(void* values, size_t count, int size);
+    void readString(std::string& out);
+
+    /**
+     * @brief check that all of the data has been read
+     * @throws lsst::pex::exceptions::RuntimeError if it has not
+     */
+    void finish();
+
+    /**
+     * @brief throw a RuntimeError which includes the current offset in the data
+     */
+    void error(std::string const& reason);
+
+private:
+    unsigned char const* _begin;
+    unsigned char const* _pos;
+    unsigned char const* _end;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_BINARYREADER_H*/
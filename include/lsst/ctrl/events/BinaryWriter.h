@@ -0,0 +1,125 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file BinaryWriter.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the BinaryWriter class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_BINARYWRITER_H
+#define LSST_CTRL_EVENTS_BINARYWRITER_H
+
+#include <string>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/PropertySet.h"
+
+using lsst::daf::base::PropertySet;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class BinaryWriter
+ * @brief Serialize a PropertySet into the typed binary encoding carried in
+ *        the body of a cms::BytesMessage.
+ *
+ * The encoding is:
+ * @code
+ * body        := VERSION propertySet
+ * propertySet := count entry*
+ * entry       := string tag count value*
+ * string      := length byte*
+ * @endcode
+ * where count and length are unsigned LEB128 varints and tag is one byte
+ * naming the type of the values that follow.  int, long, long long and
+ * DateTime (nanoseconds) values are zigzag varints, float and double values
+ * are little-endian IEEE, bool values are one byte, and PropertySet values
+ * are nested propertySets.  The float and double values of a property are
+ * contiguous, and are copied in and out as a single block.
+ */
+class BinaryWriter {
+public:
+    static const unsigned char VERSION = 1;
+
+    /// type tags of encoded values
+    enum Tag {
+        BOOL = 1,
+        INT = 2,
+        LONG = 3,
+        LONGLONG = 4,
+        FLOAT = 5,
+        DOUBLE = 6,
+        STRING = 7,
+        DATETIME = 8,
+        PROPERTYSET = 9
+    };
+
+    /**
+     * @brief write a PropertySet in the binary encoding
+     * @param ps the PropertySet to write
+     * @return a std::string containing the encoded bytes
+     * @throws lsst::pex::exceptions::RuntimeError if a value has a type which can not be marshalled
+     */
+    static std::string write(PropertySet const& ps);
+
+    /**
+     * @brief write a PropertySet in the binary encoding into a caller supplied buffer
+     * @param ps the PropertySet to write
+     * @param out buffer the encoded bytes are written into; its previous contents are discarded
+     * @throws lsst::pex::exceptions::RuntimeError if a value has a type which can not be marshalled
+     */
+    static void write(PropertySet const& ps, std::string& out);
+
+    /**
+     * @brief get the type tag of a property
+     * @throws lsst::pex::exceptions::RuntimeError if the type can not be marshalled
+     */
+    static unsigned char tagOf(PropertySet const& ps, std::string const& name);
+
+    /**
+     * @brief write the count and values of a property, whose type tag is tag
+     */
+    static void writeValues(PropertySet const& ps, std::string const& name, unsigned char tag, std::string& out);
+
+    static void writeVarint(unsigned long long value, std::string& out);
+    static void writeZigzag(long long value, std::string& out);
+    static void writeFixed(unsigned long long value, int size, std::string& out);
+    static void writeFixedArray(void const* values, size_t count, int size, std::string& out);
+    static void writeString(std::string const& value, std::string& out);
+
+private:
+    static void writePropertySet(PropertySet const& ps, std::string& out);
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_BINARYWRITER_H*/
@@ -0,0 +1,159 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file ChunkReader.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the ChunkReader class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_CHUNKREADER_H
+#define LSST_CTRL_EVENTS_CHUNKREADER_H
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <cms/Message.h>
+#include <cms/Session.h>
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class ChunkReader
+ * @brief Put the bodies of events sent in chunks by a ChunkWriter back
+ *        together.
+ *
+ * Chunks are kept until every chunk of their set has arrived, in a buffer
+ * of bounded size.  A set which is not complete within the timeout is
+ * dropped, as are the oldest sets when the buffer is full, and a set too
+ * large for the buffer, or with more chunks than could fit in it; the
+ * remaining chunks of a dropped set are ignored.
+ * Events sent whole never wait behind a set being put together.
+ *
+ * Each Receiver owns one ChunkReader.
+ */
+class ChunkReader {
+public:
+    /// default size of the buffer, in bytes
+    static const size_t DEFAULT_BUFFER_SIZE = 64 * 1024 * 1024;
+
+    /// default time allowed for all of the chunks of a set to arrive, in milliseconds
+    static const long DEFAULT_TIMEOUT = 60000;
+
+    /// number of dropped sets remembered, so that their remaining chunks are ignored
+    static const size_t MAX_DROPPED = 64;
+
+    ChunkReader();
+
+    /**
+     * @brief keep a chunk, and put its event back together once every chunk
+     *        of its set has arrived
+     * @param message a message with the CHUNKSET, CHUNK and CHUNKS header
+     *        properties
+     * @param now the current time in milliseconds
+     * @param session the session which creates the whole message
+     * @return the whole message, which the caller deletes, or NULL if chunks
+     *         of its set are still missing or the set was dropped
+     * @throws lsst::pex::exceptions::RuntimeError if message is not a
+     *         BytesMessage, or its chunk header properties are inconsistent
+     */
+    cms::Message* read(cms::Message const* message, long long now, cms::Session* session);
+
+    /**
+     * @brief drop the sets which have run out of time
+     * @param now the current time in milliseconds
+     */
+    void expire(long long now);
+
+    /**
+     * @brief get the largest number of chunks a set may have, which is the
+     *        number of the smallest chunks a ChunkWriter sends that fit in
+     *        the buffer
+     */
+    size_t getMaxChunks() const;
+
+    /**
+     * @brief set the largest number of bytes of chunks kept
+     */
+    void setBufferSize(size_t size);
+
+    /**
+     * @brief get the largest number of bytes of chunks kept
+     */
+    size_t getBufferSize() const;
+
+    /**
+     * @brief set the time allowed for all of the chunks of a set to arrive
+     * @param timeout the time in milliseconds
+     * @throws lsst::pex::exceptions::RuntimeError if timeout is not positive
+     */
+    void setTimeout(long timeout);
+
+    /**
+     * @brief get the time allowed for all of the chunks of a set to arrive,
+     *        in milliseconds
+     */
+    long getTimeout() const;
+
+    /**
+     * @brief get the number of bytes of chunks kept
+     */
+    size_t getBufferedSize() const;
+
+    /**
+     * @brief drop every set
+     */
+    void reset();
+
+private:
+    // the chunks of one set which have arrived; missing chunks are empty
+    struct ChunkSet {
+        std::vector<std::string> chunks;
+        int received;
+        long long started;
+    };
+
+    void drop(std::map<std::string, ChunkSet>::iterator it);
+    void remember(std::string const& chunkSet);
+    bool isDropped(std::string const& chunkSet) const;
+
+    size_t _bufferSize;
+    long _timeout;
+    size_t _buffered;
+    std::map<std::string, ChunkSet> _sets;
+    std::deque<std::string> _dropped;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_CHUNKREADER_H*/
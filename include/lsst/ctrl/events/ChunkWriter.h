@@ -0,0 +1,109 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file ChunkWriter.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the ChunkWriter class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_CHUNKWRITER_H
+#define LSST_CTRL_EVENTS_CHUNKWRITER_H
+
+#include <cstddef>
+#include <string>
+
+#include <cms/Message.h>
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class ChunkWriter
+ * @brief Decide which event bodies are split into chunks, and name each set
+ *        of chunks.
+ *
+ * A body larger than the chunk size is sent as a numbered set of
+ * BytesMessages, each holding at most the chunk size of it.  Every chunk
+ * carries the whole message header of the event, so that selectors match
+ * all of the chunks of a set or none of them, along with the CHUNKSET,
+ * CHUNK and CHUNKS header properties which a ChunkReader uses to put the
+ * body back together.
+ *
+ * Each Transmitter owns one ChunkWriter.
+ */
+class ChunkWriter {
+public:
+    /// the smallest chunk size which may be set
+    static const size_t MIN_CHUNK_SIZE = 1024;
+
+    ChunkWriter();
+
+    /**
+     * @brief set the largest body which is sent whole
+     * @param size the size in bytes, or 0 to never split bodies
+     * @throws lsst::pex::exceptions::RuntimeError if size is below
+     *         MIN_CHUNK_SIZE, but not 0
+     */
+    void setChunkSize(size_t size);
+
+    /**
+     * @brief get the largest body which is sent whole, or 0 if bodies are
+     *        never split
+     */
+    size_t getChunkSize() const;
+
+    /**
+     * @brief get the number of chunks a body of length bytes is sent in
+     * @return 1 if the body is sent whole
+     */
+    int getChunkCount(size_t length) const;
+
+    /**
+     * @brief get the CHUNKSET header property of the next set of chunks,
+     *        which is unique to this ChunkWriter
+     */
+    std::string nextChunkSet();
+
+    /**
+     * @brief copy the header properties of from to to, other than those
+     *        which describe a single chunk
+     */
+    static void copyProperties(cms::Message const* from, cms::Message* to);
+
+private:
+    size_t _chunkSize;
+    std::string _id;
+    long long _sets;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_CHUNKWRITER_H*/
@@ -0,0 +1,156 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file ClaimCheckReader.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the ClaimCheckReader class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_CLAIMCHECKREADER_H
+#define LSST_CTRL_EVENTS_CLAIMCHECKREADER_H
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "lsst/ctrl/events/Event.h"
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class ClaimCheckReader
+ * @brief Check the paths of events sent by claim check, and remove the
+ *        files written by ClaimCheckWriters, under a retention policy.
+ *
+ * The path of an event sent by claim check comes from its message header,
+ * which any sender can set, so it is only accepted if it names a claim
+ * check file directly in one of the directories added to the reader.
+ * The body of an accepted event is mapped from its file when it is first
+ * needed.  Files are kept for the retention time after they were written,
+ * so that every receiver of a topic can read them, and are then removed
+ * from the added directories.  A receiver which is the only one reading
+ * the files, such as that of a queue, can instead remove each file as soon
+ * as its event is received.
+ *
+ * Each Receiver owns one ClaimCheckReader.
+ */
+class ClaimCheckReader {
+public:
+    /// default time files are kept, in milliseconds
+    static const long DEFAULT_RETENTION = 600000;
+
+    ClaimCheckReader();
+
+    /**
+     * @brief add a directory from which claim check files are read
+     * @param directory the directory, as set on the ClaimCheckWriters
+     * @throws lsst::pex::exceptions::RuntimeError if directory is not a
+     *         directory
+     */
+    void addDirectory(std::string const& directory);
+
+    /**
+     * @brief get the directories from which claim check files are read,
+     *        with all symbolic links resolved
+     */
+    std::vector<std::string> getDirectories() const;
+
+    /**
+     * @brief check whether path names a claim check file directly in one of
+     *        the added directories, once all symbolic links are resolved
+     */
+    bool accepts(std::string const& path) const;
+
+    /**
+     * @brief note a received event sent by claim check, and remove the files
+     *        past their retention time, at most once every tenth of it
+     * @param event the event
+     * @param path the CLAIMCHECK header property of the event
+     * @param now the current time in milliseconds since the epoch
+     * @return false if the path is not accepted, in which case the event
+     *         must be discarded
+     */
+    bool read(Event& event, std::string const& path, long long now);
+
+    /**
+     * @brief remove the file of a received event, if files are removed on
+     *        receipt, once the body has been decoded
+     * @param event the event, which must already have been given the name
+     *        codes and earlier properties its body is decoded with
+     * @param path the CLAIMCHECK header property of the event, which read
+     *        accepted
+     * @throws lsst::pex::exceptions::RuntimeError if the body can not be read
+     */
+    void release(Event& event, std::string const& path);
+
+    /**
+     * @brief remove the files past their retention time from every added
+     *        directory
+     * @param now the current time in milliseconds since the epoch
+     */
+    void sweep(long long now);
+
+    /**
+     * @brief set the time files are kept after they were written
+     * @param retention the time in milliseconds
+     * @throws lsst::pex::exceptions::RuntimeError if retention is not positive
+     */
+    void setRetention(long retention);
+
+    /**
+     * @brief get the time files are kept after they were written, in
+     *        milliseconds
+     */
+    long getRetention() const;
+
+    /**
+     * @brief set whether each file is removed as soon as its event is
+     *        received, which decodes the body at once
+     */
+    void setRemoveOnRead(bool remove);
+
+    /**
+     * @brief check whether each file is removed as soon as its event is
+     *        received
+     */
+    bool getRemoveOnRead() const;
+
+private:
+    long _retention;
+    bool _removeOnRead;
+    long long _lastSweep;
+    std::set<std::string> _directories;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_CLAIMCHECKREADER_H*/
@@ -0,0 +1,118 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file ClaimCheckWriter.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the ClaimCheckWriter class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_CLAIMCHECKWRITER_H
+#define LSST_CTRL_EVENTS_CLAIMCHECKWRITER_H
+
+#include <cstddef>
+#include <string>
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class ClaimCheckWriter
+ * @brief Write large event bodies to files, which are sent by reference.
+ *
+ * A body at least as large as the threshold is written to a new file in the
+ * claim check directory, and the event is sent with only the path of the
+ * file, in its CLAIMCHECK header property.  The directory must be readable
+ * by the receivers under the same path: a node-local directory such as
+ * /dev/shm for processes on the same host, or a shared filesystem.  Files
+ * are written under a temporary name and then renamed, so receivers never
+ * see one partly written.  Receivers remove the files (see ClaimCheckReader).
+ *
+ * Each Transmitter owns one ClaimCheckWriter.
+ */
+class ClaimCheckWriter {
+public:
+    /// default size in bytes at or above which bodies are written to files
+    static const size_t DEFAULT_THRESHOLD = 1024 * 1024;
+
+    /// the end of the name of every file written
+    static const std::string SUFFIX;
+
+    ClaimCheckWriter();
+
+    /**
+     * @brief set the directory bodies are written to
+     * @param directory the directory, or "", the default, to send every body
+     *        in its message
+     * @throws lsst::pex::exceptions::RuntimeError if directory is not a
+     *         directory
+     */
+    void setDirectory(std::string const& directory);
+
+    /**
+     * @brief get the directory bodies are written to, or "" if they are not
+     */
+    std::string const& getDirectory() const;
+
+    /**
+     * @brief set the size in bytes at or above which bodies are written to
+     *        files
+     */
+    void setThreshold(size_t threshold);
+
+    /**
+     * @brief get the size in bytes at or above which bodies are written to
+     *        files
+     */
+    size_t getThreshold() const;
+
+    /**
+     * @brief check whether a body of length bytes is written to a file
+     */
+    bool isClaimed(size_t length) const;
+
+    /**
+     * @brief write body to a new file in the directory
+     * @return the path of the file
+     * @throws lsst::pex::exceptions::RuntimeError if the file can not be
+     *         written
+     */
+    std::string write(std::string const& body);
+
+private:
+    std::string _directory;
+    size_t _threshold;
+    std::string _id;
+    long long _written;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_CLAIMCHECKWRITER_H*/
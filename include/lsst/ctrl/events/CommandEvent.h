@@ -70,6 +70,12 @@ public:
     static const std::string DEST_PROCESSID;
     static const std::string DEST_LOCALID;
 
+    /// the header properties holding the packed originator and destination,
+    /// when a Transmitter sends compact originators; received events have
+    /// the ORIG_* and DEST_* properties above instead
+    static const std::string ORIG_ID;
+    static const std::string DEST_ID;
+
     /** @brief Creates CommandEvent which contains a PropertySet
      *        consisting of an origination location ID and 
      *        a destination location ID, plus additional
@@ -135,11 +141,56 @@ public:
     CommandEvent(std::string const& runid, LocationId const& originator, LocationId const& destination, 
                     PropertySet const& ps, PropertySet const& filterable);
 
+#ifndef SWIG
+    /**
+     * @brief Constructor for CommandEvent which takes over its PropertySet
+     * @param originator originating location of this event
+     * @param destination destination location for this event
+     * @param psp PropertySet to pass in this event, which becomes part of
+     *        the event and must not be used afterwards
+     */
+    CommandEvent(LocationId const& originator, LocationId const& destination, PTR(PropertySet)&& psp);
+
+    /**
+     * @brief Constructor for CommandEvent which takes over its PropertySet
+     * @param originator originating location of this event
+     * @param destination destination location for this event
+     * @param psp PropertySet to pass in this event, which becomes part of
+     *        the event and must not be used afterwards
+     * @param filterable additional, broker-filterable, PropertySet parameters
+     */
+    CommandEvent(LocationId const& originator, LocationId const& destination, PTR(PropertySet)&& psp,
+                    PropertySet const& filterable);
+
+    /**
+     * @brief Constructor for CommandEvent which takes over its PropertySet
+     * @param runid name of the run which this event is used in
+     * @param originator originating location of this event
+     * @param destination destination location for this event
+     * @param psp PropertySet to pass in this event, which becomes part of
+     *        the event and must not be used afterwards
+     */
+    CommandEvent(std::string const& runid, LocationId const& originator, LocationId const& destination, 
+                    PTR(PropertySet)&& psp);
+
+    /**
+     * @brief Constructor for CommandEvent which takes over its PropertySet
+     * @param runid name of the run which this event is used in
+     * @param originator originating location of this event
+     * @param destination destination location for this event
+     * @param psp PropertySet to pass in this event, which becomes part of
+     *        the event and must not be used afterwards
+     * @param filterable additional, broker-filterable, PropertySet parameters
+     */
+    CommandEvent(std::string const& runid, LocationId const& originator, LocationId const& destination, 
+                    PTR(PropertySet)&& psp, PropertySet const& filterable);
+#endif
+
     /**
      * @brief Constructor for CommandEvent
-     * @param msg a cms::TextMessage to convert into a CommandEvent
+     * @param msg a cms::Message to convert into a CommandEvent
      */
-    CommandEvent(cms::TextMessage *msg);
+    CommandEvent(cms::Message *msg);
 
     /** 
      * @brief destructor
@@ -147,20 +198,22 @@ public:
     virtual ~CommandEvent();
 
     /**
-     * @brief retrieve an object containing the Originator LocationId
+     * @brief retrieve an object containing the Originator LocationId; its
+     *        host name is empty if the event was received with the ID left
+     *        packed, because two hosts share its code
      */
     PTR(LocationId) getOriginator() const;
 
     /**
-     * @brief retrieve an object containing the Desination LocationId
+     * @brief retrieve an object containing the Desination LocationId; its
+     *        host name is empty if the event was received with the ID left
+     *        packed, because two hosts share its code
      */
     PTR(LocationId) getDestination() const;
 
 
 private:
     void _constructor(LocationId const& originator, LocationId const& destination);
-    virtual void populateHeader(cms::TextMessage *msg) const;
-
     void _init();
 
 };
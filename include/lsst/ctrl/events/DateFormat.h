@@ -0,0 +1,78 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file DateFormat.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the DateFormat class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_DATEFORMAT_H
+#define LSST_CTRL_EVENTS_DATEFORMAT_H
+
+#include <cstddef>
+#include <string>
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class DateFormat
+ * @brief Conversion of event times to the dates returned by
+ *        Event::getEventDate and Event::getPubDate.
+ *
+ * Dates are written as asctime writes them, "Thu Jan  1 00:00:00 1970\n",
+ * in UTC, but into a buffer of the caller instead of the static buffer of
+ * asctime, so the conversion may run in several threads at once and
+ * allocates nothing.
+ */
+class DateFormat {
+public:
+    /// the size of a buffer which holds any formatted date
+    static const size_t MAX_LENGTH = 48;
+
+    /**
+     * @brief write the date of nsecs, a time in nanoseconds as kept by
+     *        dafBase::DateTime, into buf, which is at least MAX_LENGTH
+     *        characters
+     * @return the number of characters written; buf is not terminated
+     */
+    static size_t format(long long nsecs, char* buf);
+
+    /**
+     * @brief replace the contents of date with the date of nsecs, reusing
+     *        its storage
+     */
+    static void format(long long nsecs, std::string& date);
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_DATEFORMAT_H*/
@@ -0,0 +1,105 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file DeltaReader.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the DeltaReader class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_DELTAREADER_H
+#define LSST_CTRL_EVENTS_DELTAREADER_H
+
+#include <map>
+#include <string>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/PropertySet.h"
+
+#include "lsst/ctrl/events/Event.h"
+
+using lsst::daf::base::PropertySet;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class DeltaReader
+ * @brief Rebuild the full StatusEvents sent by a DeltaWriter, from the last
+ *        known properties of each originator.
+ *
+ * A keyframe replaces the properties kept for its originator.  A delta is
+ * applied to them if it directly follows the last event seen from its
+ * originator; a delta which does not, because events were missed or
+ * because the receiver subscribed after the last keyframe, can not be
+ * rebuilt, and the originator is ignored until its next keyframe.  Events
+ * filtered out by the selector of a Receiver are missed in the same way.
+ *
+ * Each Receiver owns one DeltaReader.
+ */
+class DeltaReader {
+public:
+    /// maximum number of originators whose properties are kept
+    static const size_t MAX_ORIGINATORS = 1024;
+
+    DeltaReader();
+
+    /**
+     * @brief rebuild the full custom properties of a received event
+     * @param event the event, whose body holds a keyframe or a delta
+     * @param sequence the SEQUENCE header property of the event
+     * @param delta the DELTA header property of the event
+     * @return false if the event is a delta which can not be rebuilt
+     * @throws lsst::pex::exceptions::RuntimeError if the body can not be decoded
+     */
+    bool read(Event& event, long long sequence, bool delta);
+
+    /**
+     * @brief forget every originator
+     */
+    void reset();
+
+private:
+    // the properties last seen from an originator
+    struct State {
+        long long sequence;
+        long long lastUsed;
+        PTR(PropertySet) properties;
+    };
+
+    void evict();
+
+    long long _clock;
+    std::map<std::string, State> _originators;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_DELTAREADER_H*/
@@ -0,0 +1,131 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file DeltaWriter.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the DeltaWriter class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_DELTAWRITER_H
+#define LSST_CTRL_EVENTS_DELTAWRITER_H
+
+#include <map>
+#include <string>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/PropertySet.h"
+
+#include "lsst/ctrl/events/Event.h"
+
+using lsst::daf::base::PropertySet;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class DeltaWriter
+ * @brief Reduce successive StatusEvents from the same originator to the
+ *        properties which changed since the previous one.
+ *
+ * Every event from an originator is numbered, in the SEQUENCE header
+ * property.  Each keyframe carries all of the custom properties of its
+ * event; the events in between are deltas, marked by a true DELTA header
+ * property, which carry only the properties which were added or changed.
+ * A keyframe is sent for the first event of an originator, every
+ * getKeyframeInterval() events after that, and whenever a property has been
+ * removed.  DeltaReader rebuilds the full events on the receiving side.
+ *
+ * Each Transmitter owns one DeltaWriter, so each originator should publish
+ * to a destination through a single Transmitter.
+ */
+class DeltaWriter {
+public:
+    static const int DEFAULT_KEYFRAME_INTERVAL = 20;
+
+    /// maximum number of originators whose last event is kept
+    static const size_t MAX_ORIGINATORS = 1024;
+
+    DeltaWriter();
+
+    /**
+     * @brief get the key which identifies the originator of an event
+     * @param event the event
+     * @param originator set to the key
+     * @return false if the event is not a StatusEvent, and has no originator
+     */
+    static bool getOriginator(Event& event, std::string& originator);
+
+    /**
+     * @brief reduce the custom properties of an event to a delta
+     * @param originator the key which identifies the originator of the event
+     * @param properties the custom properties of the event
+     * @param sequence set to the number of the event in the originator's sequence
+     * @return the properties which were added or changed, which may be none,
+     *         if the event is sent as a delta, or null if it is a keyframe
+     */
+    PTR(PropertySet) write(std::string const& originator, PropertySet const& properties, long long& sequence);
+
+    /**
+     * @brief set the number of events from an originator between keyframes
+     * @throws lsst::pex::exceptions::RuntimeError if interval is less than 1
+     */
+    void setKeyframeInterval(int interval);
+
+    /**
+     * @brief get the number of events from an originator between keyframes
+     */
+    int getKeyframeInterval() const { return _interval; }
+
+    /**
+     * @brief forget every originator, so that the next event from each is
+     *        a keyframe
+     */
+    void reset();
+
+private:
+    // what was last sent for an originator
+    struct State {
+        long long sequence;
+        long long lastUsed;
+        // binary encoded values of each property, for comparison
+        std::map<std::string, std::string> values;
+    };
+
+    void evict();
+
+    int _interval;
+    long long _clock;
+    std::map<std::string, State> _originators;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_DELTAWRITER_H*/
@@ -37,16 +37,21 @@
 #include <cms/Connection.h>
 #include <cms/Session.h>
 #include <cms/Message.h>
+#include <cms/TextMessage.h>
+#include <cms/BytesMessage.h>
 
 #include <stdlib.h>
 #include <iostream>
-#include <set>
+#include <mutex>
+#include <vector>
 
 #include "lsst/base.h"
 #include "lsst/daf/base/PropertySet.h"
 
 #include "boost/shared_ptr.hpp"
-#include "boost/property_tree/ptree.hpp"
+
+#include "lsst/ctrl/events/KeywordSet.h"
+#include "lsst/ctrl/events/SchemaWriter.h"
 
 using lsst::daf::base::PropertySet;
 
@@ -54,9 +59,37 @@ namespace lsst {
 namespace ctrl {
 namespace events { 
 
+class HeaderPlan;
+class LocationId;
+
 /**
  * @class Event
  * @brief Representation of an LSST Event
+ *
+ * The reserved header values, EVENTTIME, PUBTIME, TYPE, STATUS, TOPIC and
+ * RUNID, are kept as members rather than in the PropertySet, and are only
+ * added to a PropertySet by getPropertySet().
+ *
+ * The properties of an Event are shared, not copied, with the callers of
+ * getPropertySet() and getCustomPropertySet(); the Event takes a copy of
+ * its own before it changes them, so the sets handed out never change.
+ * copyPropertySet() and copyCustomPropertySet() give a caller a copy of its
+ * own, which it may change; Python callers are always given one, since
+ * Python can not be kept from changing a shared set.
+ *
+ * The marshalled body of an Event is kept after it is first published, so
+ * that publishing it again, to the same or to other destinations, does not
+ * marshall it again, and is discarded by every method which changes the
+ * properties of the Event.  Its header properties are written by a
+ * HeaderPlan, which is shared by the events of the same type and
+ * filterable properties.
+ *
+ * The const methods of an Event may be called by several threads at once.
+ * What they fill in on first use, which is the decoded body of a received
+ * event, the PropertySets they return, a RUNID given as a custom property
+ * and the HeaderPlan, is guarded by a mutex of the event's own.  The other
+ * methods change the Event, and must not be called while another thread
+ * is using it.
  */
 
 class Event
@@ -69,6 +102,17 @@ public:
     static const std::string TOPIC;
     static const std::string QUEUE;
     static const std::string PUBTIME;
+    static const std::string ENCODING;
+    static const std::string COMPRESSION;
+    static const std::string SEQUENCE;
+    static const std::string DELTA;
+    static const std::string DICTIONARY;
+    static const std::string NAMES;
+    static const std::string CHUNKSET;
+    static const std::string CHUNK;
+    static const std::string CHUNKS;
+    static const std::string CLAIMCHECK;
+    static const std::string HOSTS;
     static const std::string UNINITIALIZED;
 
     /**
@@ -112,33 +156,121 @@ public:
      *          so they can be filtered.
      */
     Event(std::string const& runid, PropertySet const& properties, PropertySet const& filterable);
+
+#ifndef SWIG
+    /**
+     * @brief Constructor for Event which takes over its PropertySet, instead
+     *        of copying it
+     * @param[in] properties the PropertySet to use to populate the event;
+     *          it becomes part of the event, and must not be used afterwards
+     * @note If another PTR still holds the PropertySet, it is copied
+     *       instead, and left as it was.  The same holds for the other
+     *       constructors which take over a PropertySet.
+     */
+    Event(PTR(PropertySet)&& properties);
+
+    /**
+     * @brief Constructor for Event which takes over its PropertySet
+     * @param[in] properties the PropertySet to use to populate the event;
+     *          it becomes part of the event, and must not be used afterwards
+     * @param[in] filterable PropertySet of types to be added to the header 
+     *          so they can be filtered.
+     */
+    Event(PTR(PropertySet)&& properties, PropertySet const& filterable);
+
+    /**
+     * @brief Constructor for Event which takes over its PropertySet
+     * @param[in] runid A "run id" to place in the header of this event
+     * @param[in] properties the PropertySet to use to populate the event;
+     *          it becomes part of the event, and must not be used afterwards
+     */
+    Event(std::string const& runid, PTR(PropertySet)&& properties);
+
+    /**
+     * @brief Constructor for Event which takes over its PropertySet
+     * @param[in] runid A "run id" to place in the header of this event
+     * @param[in] properties the PropertySet to use to populate the event;
+     *          it becomes part of the event, and must not be used afterwards
+     * @param[in] filterable PropertySet of types to be added to the header 
+     *          so they can be filtered.
+     */
+    Event(std::string const& runid, PTR(PropertySet)&& properties, PropertySet const& filterable);
+#endif
+
     /**
      * @brief Constructor for Event
-     * @param[in] msg A cms::TextMessage to convert into an Event object
+     * @param[in] msg A cms::TextMessage or cms::BytesMessage to convert into an Event object
+     * @note The header properties are read immediately.  The message body is
+     *       kept as it is, and only decoded on the first call to
+     *       getPropertySet(), getCustomPropertySet() or getCustomPropertyNames(),
+     *       which throw lsst::pex::exceptions::RuntimeError if it is malformed.
      */
-    Event(cms::TextMessage *msg);
+    Event(cms::Message *msg);
 
     /**
      * @brief destructor
      */
     virtual ~Event();
 
+    /**
+     * @brief return this Event to the state of one constructed without
+     *        properties, keeping its storage, so that it can be filled
+     *        and published again
+     * @note The type of the event, and the header properties which the type
+     *       defines, such as the originator of a StatusEvent, are kept.  The
+     *       status is reset to "unknown", the event time to now, and the
+     *       run id is removed.
+     */
+    void reset();
+
+    /**
+     * @brief reset this Event, and fill it with new properties
+     * @param[in] properties the PropertySet to use to populate the event
+     */
+    void reset(PropertySet const& properties);
+
+    /**
+     * @brief reset this Event, and fill it with new properties
+     * @param[in] properties the PropertySet to use to populate the event
+     * @param[in] filterable PropertySet of types to be added to the header 
+     *          so they can be filtered.
+     */
+    void reset(PropertySet const& properties, PropertySet const& filterable);
+
     /**
      * @brief retrieve the PropertySet for this Event
-     * @return PTR(PropertySet) to this PropertySet
+     * @return CONST_PTR(PropertySet) to the properties of this Event, which
+     *         is shared with it and must not be changed
      */
-    PTR(PropertySet) getPropertySet() const;
+    CONST_PTR(PropertySet) getPropertySet() const;
+
+    /**
+     * @brief get a copy of the PropertySet for this Event, which the caller
+     *        may change; this copies the properties once, whether or not
+     *        getPropertySet() has already been called
+     */
+    PTR(PropertySet) copyPropertySet() const;
 
     /**
      * @brief get the publication date of this Event, in ASCII
+     * @return the date as asctime writes it, or an empty string if the
+     *         Event has not been published
+     */
+    std::string getPubDate() const;
+
+#ifndef SWIG
+    /**
+     * @brief get the publication date of this Event into date, reusing
+     *        its storage
      */
-    std::string getPubDate();
+    void getPubDate(std::string& date) const;
+#endif
 
     /**
      * @brief get the publication time of this Event
      * @return time in nanoseconds
      */
-    long long getPubTime();
+    long long getPubTime() const;
 
     /**
      * @brief set the publication time of this Event
@@ -149,7 +281,7 @@ public:
      * @brief get the event creation time
      * @return time in nanoseconds
      */
-    long long getEventTime();
+    long long getEventTime() const;
 
     /**
      * @brief set the event creation time
@@ -165,49 +297,68 @@ public:
      * @brief get the Event Date
      * @return a formatted date string representing the Event creation time
      */
-    std::string getEventDate();
+    std::string getEventDate() const;
+
+#ifndef SWIG
+    /**
+     * @brief get the Event Date into date, reusing its storage
+     */
+    void getEventDate(std::string& date) const;
+#endif
 
     /**
      * @brief get the RunId for this Event
-     * @return string representation of the run id
+     * @return string representation of the run id, which is valid until
+     *         the run id is next set or the Event is reset
      */
-    std::string getRunId();
+    std::string const& getRunId() const;
 
     /**
      * @brief set the RunId for this Event
      * @param[in] runid string representation of run identifier
      */
-    void setRunId(std::string runid);
+    void setRunId(std::string const& runid);
+#ifndef SWIG
+    void setRunId(char const* runid);
+#endif
 
     /**
      * @brief get the Event type
      * @return string representation of the Event type
      */
-    std::string getType();
+    std::string const& getType() const;
 
     /**
      * @brief get the Event status
-     * @return string representation of the Event status
+     * @return string representation of the Event status, which is valid
+     *         until the status is next set
      */
-    std::string getStatus();
+    std::string const& getStatus() const;
 
     /**
      * @brief set the Event status
      * @param[in] status string representation of the Event status
      */
-    void setStatus(std::string status);
+    void setStatus(std::string const& status);
+#ifndef SWIG
+    void setStatus(char const* status);
+#endif
 
     /**
      * @brief set the Event topic
      * @param[in] topic string representation of the Event topic
      */
-    void setTopic(std::string topic);
+    void setTopic(std::string const& topic);
+#ifndef SWIG
+    void setTopic(char const* topic);
+#endif
 
     /**
      * @brief get the Event topic
-     * @return string representation of the Event topic
+     * @return string representation of the Event topic, which is valid
+     *         until the topic is next set
      */
-    std::string getTopic();
+    std::string const& getTopic() const;
 
     /**
      * @brief return all filterable property names
@@ -223,37 +374,158 @@ public:
 
     /**
      * @brief return all custom property set
-     * @return a PTR(PropertySet) of custom properties
+     * @return a CONST_PTR(PropertySet) of custom properties, which is kept
+     *         until this Event is changed and must not be changed
      */
-    PTR(PropertySet) getCustomPropertySet() const;
+    CONST_PTR(PropertySet) getCustomPropertySet() const;
 
     /**
-     * @brief populate a cms::TextMessage header with properties
-     * @param[in] msg a cms::TextMessage
+     * @brief get a copy of the custom properties, which the caller may change;
+     *        this copies the properties once, whether or not
+     *        getCustomPropertySet() has already been called
      */
-    virtual void populateHeader(cms::TextMessage* msg) const;
+    PTR(PropertySet) copyCustomPropertySet() const;
 
     /**
-     * @brief marshall values in this event into a cms::TextMessage
+     * @brief populate a cms::Message header with properties
+     * @param[in] msg a cms::Message
+     * @param[in] compact whether to send the originator and destination of
+     *            the event as packed IDs, in the ORIG_ID and DEST_ID
+     *            properties; see LocationId::getId()
+     */
+    virtual void populateHeader(cms::Message* msg, bool compact = false) const;
+
+    /**
+     * @brief marshall values in this event into a cms::TextMessage as JSON
      */
     void marshall(cms::TextMessage *msg);
 
+    /**
+     * @brief marshall values in this event into a cms::BytesMessage, using
+     *        the binary encoding
+     */
+    void marshall(cms::BytesMessage *msg);
+
+    /**
+     * @brief marshall values in this event into a cms::BytesMessage, using
+     *        the schema encoding
+     * @param msg the message
+     * @param writer the SchemaWriter which tracks which schema definitions
+     *        have been sent
+     */
+    void marshall(cms::BytesMessage *msg, SchemaWriter& writer);
+
+    /**
+     * @brief marshall the custom properties of this event into a message body
+     * @param encoding the EventEncodings name of the encoding to use
+     * @param writer the SchemaWriter used for EventEncodings::SCHEMA
+     * @param pack whether long numeric arrays are packed in JSON
+     * @return the body, which is valid until the next call, or until this
+     *         event is changed
+     */
+    std::string const& marshallPayload(std::string const& encoding, SchemaWriter& writer, bool pack = false);
+
 protected:
-    PTR(PropertySet) _psp;
+    mutable PTR(PropertySet) _psp;
     PTR(PropertySet) _filterable;
-    std::set<std::string> _keywords;
+    KeywordSet _keywords;
     void _init();
-    void _constructor(std::string const& runid, PropertySet const& properties, PropertySet const& filterable);
+    void _constructor(std::string const& runid, PTR(PropertySet) properties, PropertySet const& filterable);
 
-    template<typename T>void add(std::string const& name, std::string const& tag, PropertySet const& properties, boost::property_tree::ptree& child);
+    /**
+     * @brief make _psp a copy of its own if it is shared; subclasses call
+     *        this before they change _psp after construction
+     */
+    void _detach() const;
 
+    /**
+     * @brief get the properties, with the body of a received event decoded;
+     *        subclasses read _psp through this in their const methods
+     */
+    CONST_PTR(PropertySet) _properties() const;
+
+    /**
+     * @brief set the Event type; subclasses call this instead of setting
+     *        TYPE in _psp, which does not hold the reserved header values
+     */
+    void _setType(std::string const& type);
+
+    /**
+     * @brief discard the kept header plan and body; subclasses call this
+     *        whenever they change _psp or _keywords after construction
+     */
+    void _invalidate();
 
 private:
+    friend class DeltaReader;
+    friend class NameDecoder;
+    friend class HeaderPlan;
+
+    // the reserved header values, and the KeywordSet::Keyword bits of
+    // those which are set
+    long long _eventTime;
+    long long _pubTime;
+    std::string _type;
+    std::string _status;
+    std::string _topic;
+    std::string _runId;
+    KeywordSet::Mask _reserved;
+
+    // a mutex which copies of an Event do not share
+    struct Mutex {
+        Mutex() {}
+        Mutex(Mutex const&) {}
+        Mutex& operator=(Mutex const&) { return *this; }
+        std::recursive_mutex mutex;
+    };
+
+    // guards _psp while the body is decoded, and the members below which
+    // const methods fill in on first use
+    mutable Mutex _lazy;
+
+    // properties with the reserved header values added, made by getPropertySet()
+    mutable CONST_PTR(PropertySet) _view;
+
+    // the plan which writes the header properties, and the storage of the
+    // key used to look it up
+    mutable CONST_PTR(HeaderPlan) _plan;
+    mutable std::string _planKey;
+
+    // a RUNID which was given as a custom property, kept for getRunId()
+    mutable std::string _customRunId;
+
+    // custom properties and marshalled body kept from the last publication
+    mutable CONST_PTR(PropertySet) _custom;
+    std::string _payload;
+    std::string _payloadEncoding;
+    bool _payloadPacked;
+
+    // message body which has not been decoded yet, and its encoding
+    mutable std::string _body;
+    std::string _bodyEncoding;
+    std::string _bodyCompression;
+    mutable bool _bodyPending;
+
+    // file holding the body of an event sent by claim check, if any
+    std::string _bodyClaim;
+
+    // dictionary of the property name codes used in the body, if any
+    CONST_PTR(std::vector<std::string>) _bodyNames;
+
     std::string marshall(PropertySet const& properties);
-    PTR(PropertySet) processTextMessage(cms::TextMessage *textMessage);
-    PTR(PropertySet) unmarshall(std::string const& text);
-    PTR(PropertySet) parsePropertySet(boost::property_tree::ptree child);
-    bool addDataItem(std::string const& typeInfo, boost::property_tree::ptree& item, std::string const& key, PropertySet& properties);
+    void invalidateView();
+    void takeReserved();
+    void reserveRunId();
+    void checkReserved(int keyword) const;
+    void addLocation(long long id, std::string const& idName, int hostname, int pid, int local);
+    void addCustomProperties(PTR(PropertySet) properties);
+    void copyProperty(PropertySet const& source, std::string const& name);
+    std::string const& cachedPayload(std::string const& encoding, bool pack = false);
+    void processMessage(cms::Message *msg);
+    void decodeBody() const;
+    PTR(PropertySet) makeView() const;
+    PTR(PropertySet) makeCustom() const;
+    PTR(PropertySet) unmarshall(char const* text, size_t length) const;
 };
 
 }
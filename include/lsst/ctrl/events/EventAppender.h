@@ -43,6 +43,7 @@
 
 #include "lsst/ctrl/events/EventTransmitter.h"
 #include "lsst/ctrl/events/EventBroker.h"
+#include "lsst/ctrl/events/LocationId.h"
 
 using namespace log4cxx;
 using namespace log4cxx::helpers;
@@ -126,6 +127,7 @@ protected:
     LogString _topic;  /* name of the topic where events are sent */
     int _port;         /* port number used by the broker */
     LogString _runid;  /* run id which can be used for selectors */
+    LocationId _originatorId; /* originator of every event sent, so that a packed ID is kept */
 
 };
     LOG4CXX_PTR_DEF(EventAppender);
@@ -0,0 +1,94 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file EventBatch.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the EventBatch class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_EVENTBATCH_H
+#define LSST_CTRL_EVENTS_EVENTBATCH_H
+
+#include <vector>
+
+#include "lsst/base.h"
+
+#include "lsst/ctrl/events/Event.h"
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+class Receiver;
+
+/**
+ * @class EventBatch
+ * @brief Events received together by Receiver::receiveEvents
+ *
+ * A batch saves the wait for each event after the first, and the Python
+ * calls between them; it does not save allocations.  Its Events are
+ * ordinary PTR(Event)s, each allocated on its own, with their PropertySets
+ * and strings on the heap, as from Receiver::receiveEvent; there is no
+ * arena behind a batch.  One which is kept after the batch is dropped
+ * keeps nothing else alive.
+ *
+ * Each Receiver::receiveEvents call returns one EventBatch.
+ */
+class EventBatch {
+public:
+    /**
+     * @brief Constructor for an empty batch
+     * @param capacity the number of events expected
+     */
+    explicit EventBatch(int capacity = 0);
+
+    ~EventBatch();
+
+    /**
+     * @brief get the number of events in this batch
+     */
+    int size() const { return static_cast<int>(_events.size()); }
+
+    /**
+     * @brief get an event of this batch
+     * @param i the position of the event, from 0 to size() - 1
+     * @throws lsst::pex::exceptions::RuntimeError if i is out of range
+     */
+    PTR(Event) getEvent(int i) const;
+
+private:
+    friend class Receiver;
+
+    std::vector<PTR(Event)> _events;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_EVENTBATCH_H*/
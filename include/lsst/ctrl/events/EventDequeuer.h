@@ -72,7 +72,10 @@ public:
      * @param destinationName the queue to receive events from
      * @param selector the message selector expression to use.  A selector value of "" is equivalent to no selector.
      * @param hostPort the port the message broker is listening on
-     * @note The selector allows filtering of messages on the broker before the event is received
+     * @note The selector allows filtering of messages on the broker before the event is received.
+     *       A delta encoded StatusEvent which follows one that was filtered
+     *       out, or an event with name codes defined in one that was, is
+     *       discarded, as it is by a receiver which missed that event.
      * \throw throws lsst::pex::exceptions::RuntimeError if connection fails to initialize
      */
     EventDequeuer(const std::string& hostName, const std::string& destinationName, const std::string& selector, int hostPort = EventBroker::DEFAULTHOSTPORT);
@@ -0,0 +1,58 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file EventEncodings.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines EventEncodings
+ */
+
+#ifndef LSST_CTRL_EVENTS_EVENTENCODINGS_H
+#define LSST_CTRL_EVENTS_EVENTENCODINGS_H
+
+#include <string>
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class EventEncodings
+ * @brief strings naming the encodings of event bodies; the encoding is
+ *        announced in the ENCODING header property of each message.  Messages
+ *        without that property carry JSON.
+ */
+class EventEncodings {
+public:
+    static const std::string JSON;
+    static const std::string BINARY;
+    static const std::string SCHEMA;
+};
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_EVENTENCODINGS_H*/
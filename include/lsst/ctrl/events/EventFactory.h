@@ -61,7 +61,12 @@ public:
 
     ~EventFactory();
 
-    static PTR(Event) createEvent(cms::TextMessage* msg);
+    /**
+     * @brief create an Event of the type named in the message header
+     * @param msg a cms::TextMessage or cms::BytesMessage; the ENCODING header
+     *        property selects the decoder used for the body.
+     */
+    static PTR(Event) createEvent(cms::Message* msg);
 
 };
 }
@@ -0,0 +1,124 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file EventPool.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the EventPool class template
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_EVENTPOOL_H
+#define LSST_CTRL_EVENTS_EVENTPOOL_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "lsst/base.h"
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class EventPool
+ * @brief A pool of Events of one type, which are reset and used again
+ *        rather than constructed for each publication
+ *
+ * New Events are copies of a prototype, such as a StatusEvent with the
+ * originator of the process; acquire() returns an Event in the state
+ * reset() leaves it, ready to be filled and published, and release()
+ * hands it back.  An Event which is released keeps the storage of its
+ * strings, header and body, so a loop which publishes events of the same
+ * shape reaches a steady state in which the Events allocate nothing.  The
+ * values of custom and filterable properties are still allocated by the
+ * PropertySet which holds them.
+ *
+ * @code
+ * EventPool<StatusEvent> pool(StatusEvent(originator, PropertySet()));
+ * for (;;) {
+ *     PTR(StatusEvent) event = pool.acquire();
+ *     event->setStatus(status);
+ *     transmitter.publishEvent(*event);
+ *     pool.release(std::move(event));
+ * }
+ * @endcode
+ *
+ * An EventPool is not thread safe.  Each publishing thread owns one EventPool.
+ */
+template<typename EventT>
+class EventPool {
+public:
+    /**
+     * @brief Constructor
+     * @param prototype the Event which new Events are copied from
+     * @param capacity the number of released Events which are kept
+     */
+    explicit EventPool(EventT const& prototype, size_t capacity = 16) : _prototype(prototype) {
+        _prototype.reset();
+        _free.reserve(capacity);
+    }
+
+    /**
+     * @brief get an Event, reset, from the pool, or a new copy of the
+     *        prototype if the pool is empty
+     */
+    PTR(EventT) acquire() {
+        if (_free.empty())
+            return PTR(EventT)(new EventT(_prototype));
+        PTR(EventT) event = std::move(_free.back());
+        _free.pop_back();
+        return event;
+    }
+
+    /**
+     * @brief reset an Event and return it to the pool
+     * @param event an Event from acquire(); it is dropped instead if it is
+     *        still shared, or if the pool is full
+     */
+    void release(PTR(EventT) event) {
+        if (!event || !event.unique() || (_free.size() == _free.capacity()))
+            return;
+        event->reset();
+        _free.push_back(std::move(event));
+    }
+
+    /**
+     * @brief get the number of Events in the pool
+     */
+    size_t size() const { return _free.size(); }
+
+private:
+    EventT _prototype;
+    std::vector<PTR(EventT)> _free;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_EVENTPOOL_H*/
@@ -0,0 +1,124 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file EventSchema.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the EventSchema class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_EVENTSCHEMA_H
+#define LSST_CTRL_EVENTS_EVENTSCHEMA_H
+
+#include <string>
+#include <vector>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/PropertySet.h"
+
+using lsst::daf::base::PropertySet;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+class BinaryReader;
+
+/**
+ * @class EventSchema
+ * @brief The shape of an event body: the names of its properties and the
+ *        BinaryWriter type tag of each, in name order.
+ *
+ * Nested PropertySets are flattened into hierarchical names.  Arrays of
+ * PropertySets, and empty nested PropertySets, are kept as single fields
+ * tagged BinaryWriter::PROPERTYSET.  The number of values in each property
+ * is not part of the shape, so events whose arrays vary in length share a
+ * schema.
+ *
+ * The schema ID is a 64 bit FNV-1a hash of the fields, so every process
+ * computes the same ID for the same shape without coordination.
+ */
+class EventSchema {
+public:
+    /// a single property of the schema
+    struct Field {
+        std::string name;
+        unsigned char tag;
+    };
+
+    /**
+     * @brief Constructor for a schema of the given fields
+     * @param fields the fields, which are sorted by name
+     */
+    explicit EventSchema(std::vector<Field> const& fields);
+
+    /**
+     * @brief create the schema describing the shape of a PropertySet
+     * @throws lsst::pex::exceptions::RuntimeError if a property has a type
+     *         which can not be marshalled
+     */
+    static PTR(EventSchema) create(PropertySet const& ps);
+
+    /**
+     * @brief read a schema definition written by write()
+     */
+    static PTR(EventSchema) read(BinaryReader& reader);
+
+    /**
+     * @brief append the definition of this schema to out
+     */
+    void write(std::string& out) const;
+
+    /**
+     * @brief get the schema ID
+     */
+    unsigned long long getId() const { return _id; }
+
+    /**
+     * @brief get the fields of this schema, in name order
+     */
+    std::vector<Field> const& getFields() const { return _fields; }
+
+    /**
+     * @brief get the number of fields in this schema
+     */
+    size_t size() const { return _fields.size(); }
+
+    bool operator==(EventSchema const& other) const;
+
+private:
+    static void addFields(PropertySet const& ps, std::string const& prefix, std::vector<Field>& fields);
+
+    std::vector<Field> _fields;
+    unsigned long long _id;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_EVENTSCHEMA_H*/
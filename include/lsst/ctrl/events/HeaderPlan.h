@@ -0,0 +1,148 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file HeaderPlan.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the HeaderPlan class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_HEADERPLAN_H
+#define LSST_CTRL_EVENTS_HEADERPLAN_H
+
+#include <string>
+#include <vector>
+
+#include <cms/Message.h>
+
+#include "lsst/base.h"
+#include "lsst/ctrl/events/KeywordSet.h"
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+class Event;
+
+/**
+ * @class HeaderPlan
+ * @brief The steps which write the header properties of an Event to a message
+ *
+ * A plan holds one step for each header property, in the order of the
+ * KeywordSet, and each step calls the cms::Message setter for the type of
+ * its value directly, so that the types are only looked up when the plan is
+ * compiled.  Plans are compiled once for each shape of header: the header
+ * property names of the event, and the types of the values of those which
+ * are not reserved header values.  They are kept in a process-wide cache,
+ * which is shared by events of the same type and filterable properties.
+ * A compact plan writes the originator and destination of a StatusEvent,
+ * CommandEvent or LogEvent as one packed ID each, in ORIG_ID and DEST_ID,
+ * unless the location does not fit in an ID, or its host shares its code
+ * with another (see HostTable), in which case it writes its properties.
+ *
+ * Each Event owns a reference to one HeaderPlan, until its header properties change.
+ */
+class HeaderPlan {
+public:
+    /**
+     * @brief the largest number of plans which are cached; events of
+     *        shapes beyond these compile a plan of their own
+     */
+    static const size_t MAX_CACHED = 1024;
+
+    /**
+     * @brief get the plan for the header properties of an event
+     * @param event the event
+     * @param key storage for the lookup key, which callers keep between
+     *        calls, so that looking up a cached plan allocates nothing
+     * @param compact whether to write locations as packed IDs
+     * @throws RuntimeError if a reserved header value is not set, or a
+     *         header property has a type which a message can not hold
+     */
+    static CONST_PTR(HeaderPlan) get(Event const& event, std::string& key, bool compact = false);
+
+    /**
+     * @brief get the number of cached plans
+     */
+    static size_t getCacheSize();
+
+    /**
+     * @brief write the header properties of an event to a message
+     * @param event an event of the shape this plan was compiled for
+     * @param msg the message
+     */
+    void write(Event const& event, cms::Message* msg) const {
+        for (Step const& step : _steps) {
+            step.writer(event, step.name, msg);
+        }
+    }
+
+    /**
+     * @brief get the number of header properties which are written
+     */
+    size_t size() const { return _steps.size(); }
+
+    /**
+     * @brief check whether this plan writes locations as packed IDs
+     */
+    bool isCompact() const { return _compact; }
+
+private:
+    typedef void (*Writer)(Event const& event, std::string const& name, cms::Message* msg);
+
+    struct Step {
+        std::string name;
+        Writer writer;
+    };
+
+    std::vector<Step> _steps;
+    bool _compact;
+
+    HeaderPlan(Event const& event, bool compact);
+
+    static KeywordSet::Mask packedLocations(Event const& event);
+
+    static Writer propertyWriter(Event const& event, std::string const& name);
+
+    template<typename T, typename V, void (cms::Message::*setter)(std::string const&, V)>
+    static void writeProperty(Event const& event, std::string const& name, cms::Message* msg);
+
+    template<long long Event::*member>
+    static void writeTime(Event const& event, std::string const& name, cms::Message* msg);
+
+    template<std::string Event::*member>
+    static void writeText(Event const& event, std::string const& name, cms::Message* msg);
+
+    template<int hostname, int pid, int local>
+    static void writeLocation(Event const& event, std::string const& name, cms::Message* msg);
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_HEADERPLAN_H*/
@@ -0,0 +1,157 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file HostTable.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the HostTable class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_HOSTTABLE_H
+#define LSST_CTRL_EVENTS_HOSTTABLE_H
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class HostTable
+ * @brief The per-process table of the host names in packed LocationIds.
+ *
+ * A packed LocationId holds the code of its host name rather than the
+ * name.  Codes are a hash of the name, so that every process gives a host
+ * the same code without asking any other, and a receiver can build the
+ * packed ID of any LocationId to select the events it sends.  Transmitters
+ * send the definitions of the codes they use in the HOSTS header property,
+ * and receivers add them to this table, so that the names of the hosts can
+ * be put back.
+ *
+ * Codes are the full 32 bit hash, so two of a thousand hosts share one only
+ * about once in ten thousand fleets.  Should a table learn of two names
+ * with the same code, the code is marked as conflicting: lookup() no longer
+ * knows it, so receivers deliver the events which use it with the ID left
+ * packed in ORIG_ID or DEST_ID rather than give them the wrong host, and
+ * transmitters send the locations of both hosts as properties again.
+ */
+class HostTable {
+public:
+    /// the number of bits in a host code
+    static const int CODE_BITS = 32;
+
+    /// the number of events a transmitter sends between definitions of a host
+    static const int DEFINITION_INTERVAL = 100;
+
+    HostTable();
+
+    /**
+     * @brief get the HostTable used by LocationIds, Transmitters and Receivers
+     */
+    static HostTable& getDefaultHostTable();
+
+    /**
+     * @brief get the code of a host name, without adding it to a table
+     */
+    static unsigned int getCode(std::string const& hostname);
+
+    /**
+     * @brief add a host name to this table
+     * @return the code of hostname
+     */
+    unsigned int intern(std::string const& hostname);
+
+#ifndef SWIG
+    /**
+     * @brief add a host name to this table, as intern(hostname) does, and
+     *        check that no other host has its code.  The last name checked
+     *        by each thread is remembered, and is not checked again while
+     *        no conflict is found, so this does not lock the table when a
+     *        thread keeps using the same host.
+     * @param hostname the host name
+     * @param code set to the code of hostname
+     * @return false if another host has the same code
+     */
+    bool intern(std::string const& hostname, unsigned int& code);
+#endif
+
+    /**
+     * @brief check whether two hosts known to this table have the code
+     */
+    bool isConflicting(unsigned int code);
+
+    /**
+     * @brief get the number of codes found to be conflicting
+     */
+    size_t getConflictCount() const;
+
+    /**
+     * @brief get the name of a host
+     * @param code the code of the host
+     * @param hostname set to the name of the host, if it is known
+     * @return false if no host with that code is known, or the code is
+     *         conflicting
+     */
+    bool lookup(unsigned int code, std::string& hostname);
+
+    /**
+     * @brief get the definition of a code, as it is sent in the HOSTS header
+     *        property: the code in decimal, a space, and the host name
+     * @return the definition, or an empty string if no host with that code
+     *         is known, or the code is conflicting
+     */
+    std::string getDefinition(unsigned int code);
+
+    /**
+     * @brief add the definitions of a HOSTS header property, one to a line
+     * @throws lsst::pex::exceptions::RuntimeError if definitions is malformed
+     */
+    void define(std::string const& definitions);
+
+    /**
+     * @brief get the number of hosts known
+     */
+    size_t size();
+
+private:
+    std::mutex _mutex;
+    std::map<unsigned int, std::string> _names;
+    std::set<unsigned int> _conflicts;
+    std::atomic<size_t> _conflictCount;
+
+    void add(unsigned int code, std::string const& hostname);
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_HOSTTABLE_H*/
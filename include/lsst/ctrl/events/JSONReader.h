@@ -0,0 +1,122 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file JSONReader.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the JSONReader class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_JSONREADER_H
+#define LSST_CTRL_EVENTS_JSONREADER_H
+
+#include <string>
+#include <vector>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/PropertySet.h"
+
+using lsst::daf::base::PropertySet;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class JSONReader
+ * @brief Decode the JSON text carried in an Event body into a PropertySet.
+ *
+ * The text is read once, front to back, and each value is added to the
+ * PropertySet as soon as it is decoded; no intermediate tree is built.  Text
+ * written by JSONWriter, and by the boost::property_tree marshalling used by
+ * earlier releases, is accepted.  Strings are scanned, and numbers converted,
+ * by JSONScanner.  Packed numeric arrays written by JSONWriter are decoded
+ * and added to the PropertySet as a single vector.
+ */
+class JSONReader {
+public:
+    /**
+     * @brief decode JSON text into a new PropertySet
+     * @param text the JSON text
+     * @return a PTR(PropertySet) containing the decoded values
+     * @throws lsst::pex::exceptions::RuntimeError if the text can not be decoded
+     */
+    static PTR(PropertySet) read(std::string const& text);
+
+    /**
+     * @brief decode JSON text, adding its values to a PropertySet
+     * @param text the JSON text
+     * @param length the length of text
+     * @param ps the PropertySet the values are added to
+     * @throws lsst::pex::exceptions::RuntimeError if the text can not be decoded
+     */
+    static void read(char const* text, size_t length, PropertySet& ps);
+
+    /**
+     * @brief decode JSON text whose property names may be codes written by
+     *        NameEncoder, adding its values to a PropertySet
+     * @param text the JSON text
+     * @param length the length of text
+     * @param names the dictionary the codes are expanded with; if NULL,
+     *        names are read as they are
+     * @param ps the PropertySet the values are added to
+     * @throws lsst::pex::exceptions::RuntimeError if the text can not be decoded
+     */
+    static void read(char const* text, size_t length, std::vector<std::string> const* names, PropertySet& ps);
+
+private:
+    JSONReader(char const* text, size_t length, std::vector<std::string> const* names);
+
+    void parseObject(PropertySet& ps);
+    void parseMembers(PropertySet& ps, std::string& key);
+    void parseMember(PropertySet& ps, std::string const& name);
+    void parsePacked(PropertySet& ps, std::string const& name);
+    template<typename T, typename W>
+    void addPacked(PropertySet& ps, std::string const& name);
+    void parseString(std::string& out);
+    void parseScalar(std::string& out);
+    void parseUnicodeEscape(std::string& out);
+    bool addDataItem(std::string const& tag, std::string const& value, std::string const& name, PropertySet& ps);
+    void skipWhitespace();
+    void expect(char c);
+    void error(std::string const& reason);
+
+    char const* _begin;
+    char const* _pos;
+    char const* _end;
+    std::vector<std::string> const* _names;
+
+    std::string _tag;
+    std::string _value;
+    std::vector<unsigned char> _packed;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_JSONREADER_H*/
@@ -0,0 +1,109 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file JSONScanner.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the JSONScanner class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_JSONSCANNER_H
+#define LSST_CTRL_EVENTS_JSONSCANNER_H
+
+#include <atomic>
+#include <string>
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class JSONScanner
+ * @brief Scanning and number conversion primitives used by JSONReader.
+ *
+ * The search for the end of a string is vectorized.  The implementation is
+ * chosen when it is first used, from the best one the CPU supports: "avx2"
+ * scans 32 bytes at a time, "sse2" 16 bytes, and "scalar" one byte.
+ *
+ * The number conversions are exact fast paths for the common cases; they
+ * return false for anything else, which the caller converts with strtoll or
+ * strtod instead, so the results never differ from those functions.
+ */
+class JSONScanner {
+public:
+    /**
+     * @brief find the first double quote or backslash in [pos, end)
+     * @return a pointer to it, or end if there is none
+     */
+    static char const* findQuoteOrEscape(char const* pos, char const* end) {
+        return _findQuoteOrEscape.load(std::memory_order_acquire)(pos, end);
+    }
+
+    /**
+     * @brief convert text which is an optional minus sign followed by at most
+     *        18 decimal digits
+     * @return false, leaving result unchanged, if the text is any other form
+     */
+    static bool parseInteger(char const* begin, char const* end, long long& result);
+
+    /**
+     * @brief convert decimal text whose value is exactly the product or
+     *        quotient of an integer below 2^53 and a power of ten up to 10^22,
+     *        so that one correctly rounded operation gives the same result
+     *        as strtod
+     * @return false, leaving result unchanged, if the text is any other form
+     */
+    static bool parseDouble(char const* begin, char const* end, double& result);
+
+    /**
+     * @brief get the name of the string search in use
+     */
+    static std::string getImplementation();
+
+    /**
+     * @brief choose the string search, for testing and benchmarking; threads
+     *        which are decoding events switch to it with their next string
+     * @param name "avx2", "sse2" or "scalar"
+     * @throws lsst::pex::exceptions::RuntimeError if the CPU does not
+     *         support name
+     */
+    static void setImplementation(std::string const& name);
+
+private:
+    typedef char const* (*FindFunction)(char const* pos, char const* end);
+
+    static char const* findFirst(char const* pos, char const* end);
+
+    // swapped by setImplementation while other threads may be scanning
+    static std::atomic<FindFunction> _findQuoteOrEscape;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_JSONSCANNER_H*/
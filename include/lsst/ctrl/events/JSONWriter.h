@@ -0,0 +1,135 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file JSONWriter.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the JSONWriter class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_JSONWRITER_H
+#define LSST_CTRL_EVENTS_JSONWRITER_H
+
+#include <string>
+#include <vector>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/PropertySet.h"
+
+#include "lsst/ctrl/events/NameEncoder.h"
+
+using lsst::daf::base::PropertySet;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class JSONWriter
+ * @brief Serialize a PropertySet into the JSON text carried in an Event body.
+ *
+ * The PropertySet is written in a single pass directly into one output
+ * buffer; no intermediate tree is built.  Each value is written as an object
+ * of type-tagged strings, i.e. {"name":{"int":"1","int":"2"}}, and nested
+ * PropertySets are written as nested objects.  This is the same text the
+ * event unmarshaller has always accepted.
+ *
+ * If packing is asked for, arrays of at least PACK_THRESHOLD int, long,
+ * long long, float or double values are instead written as one packed
+ * block, i.e. {"name":{"packed double":"..."}}, holding the base64 encoding
+ * of the little-endian values; long values are packed as 8 bytes.  Only
+ * JSONReader decodes packed blocks; receivers from releases before they
+ * were added read them as empty PropertySets, so packing is off unless a
+ * Transmitter turns it on.
+ */
+class JSONWriter {
+public:
+    static const size_t PACK_THRESHOLD = 16;
+
+    JSONWriter();
+
+    ~JSONWriter();
+
+    /**
+     * @brief write a PropertySet as JSON
+     * @param ps the PropertySet to write
+     * @param pack whether long numeric arrays are written as packed blocks
+     * @return a std::string containing the JSON text
+     * @throws lsst::pex::exceptions::RuntimeError if a value has a type which can not be marshalled
+     */
+    static std::string write(PropertySet const& ps, bool pack = false);
+
+    /**
+     * @brief write a PropertySet as JSON into a caller supplied buffer
+     * @param ps the PropertySet to write
+     * @param out buffer the JSON text is written into; its previous contents are discarded,
+     *        but its capacity is kept, so reusing the same buffer avoids reallocation.
+     * @param pack whether long numeric arrays are written as packed blocks
+     * @throws lsst::pex::exceptions::RuntimeError if a value has a type which can not be marshalled
+     */
+    static void write(PropertySet const& ps, std::string& out, bool pack = false);
+
+    /**
+     * @brief write a PropertySet as JSON, replacing repeated property names
+     *        by the codes assigned by a NameEncoder
+     * @param ps the PropertySet to write
+     * @param encoder the NameEncoder which assigns the codes
+     * @param out buffer the JSON text is written into; its previous contents are discarded
+     * @param pack whether long numeric arrays are written as packed blocks
+     * @throws lsst::pex::exceptions::RuntimeError if a value has a type which can not be marshalled
+     */
+    static void write(PropertySet const& ps, NameEncoder& encoder, std::string& out, bool pack = false);
+
+    /**
+     * @brief append a value as a quoted JSON string, escaping characters as
+     *        boost::property_tree::write_json does
+     * @param value the string to write
+     * @param out buffer the JSON string is appended to
+     */
+    static void writeString(std::string const& value, std::string& out);
+
+private:
+    static size_t estimateSize(PropertySet const& ps);
+    static void writePropertySet(PropertySet const& ps, NameEncoder* encoder, bool pack, std::string& out);
+    static void writeValues(PropertySet const& ps, std::string const& name, bool pack, std::string& out);
+
+    template<typename T>
+    static void writeArray(std::vector<T> const& vec, char const* tag, std::string& out);
+
+    template<typename T, typename W>
+    static void writeNumbers(PropertySet const& ps, std::string const& name, char const* tag, char const* packedTag,
+                             bool pack, std::string& out);
+
+    template<typename T, typename W>
+    static void writePacked(std::vector<T> const& vec, char const* tag, std::string& out);
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_JSONWRITER_H*/
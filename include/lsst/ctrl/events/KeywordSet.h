@@ -0,0 +1,180 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file KeywordSet.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the KeywordSet class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_KEYWORDSET_H
+#define LSST_CTRL_EVENTS_KEYWORDSET_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class KeywordSet
+ * @brief The names of the header properties of an Event
+ *
+ * The header properties which the event types define themselves are held
+ * in a single process-wide table, and a KeywordSet records which of them it
+ * contains as bits of a mask, so that setting up the keywords of a new
+ * event allocates nothing.  Only the names of filterable properties given
+ * by the application are kept by each KeywordSet, in a sorted vector.
+ * Names are visited in the same sorted order as the std::set this replaces.
+ *
+ * Each Event owns one KeywordSet.
+ */
+class KeywordSet {
+public:
+    typedef uint32_t Mask;
+
+    /// the header properties defined by the event types, in sorted order
+    enum Keyword {
+        DEST_HOSTNAME, DEST_LOCALID, DEST_PROCESSID, EVENTTIME, LEVEL, LOGGER,
+        ORIG_HOSTNAME, ORIG_LOCALID, ORIG_PROCESSID, PUBTIME, RUNID, STATUS,
+        TOPIC, TYPE, KEYWORD_COUNT
+    };
+
+    /// the keywords of every Event
+    static const Mask EVENT_KEYWORDS =
+        (1u << TYPE) | (1u << EVENTTIME) | (1u << STATUS) | (1u << TOPIC) | (1u << PUBTIME);
+
+    /// the keywords whose values Event keeps as members, rather than in its PropertySet
+    static const Mask RESERVED_KEYWORDS = EVENT_KEYWORDS | (1u << RUNID);
+
+    /// the keywords which StatusEvent adds
+    static const Mask STATUS_KEYWORDS =
+        (1u << ORIG_HOSTNAME) | (1u << ORIG_PROCESSID) | (1u << ORIG_LOCALID);
+
+    /// the keywords which CommandEvent adds
+    static const Mask COMMAND_KEYWORDS = STATUS_KEYWORDS |
+        (1u << DEST_HOSTNAME) | (1u << DEST_PROCESSID) | (1u << DEST_LOCALID);
+
+    /// the keywords which LogEvent adds
+    static const Mask LOG_KEYWORDS = (1u << LEVEL) | (1u << LOGGER);
+
+    KeywordSet() : _mask(0), _types(0) {}
+
+    /**
+     * @brief add the keywords of an event type
+     * @param mask the keywords, one of the *_KEYWORDS masks
+     */
+    void add(Mask mask) {
+        _mask |= mask;
+        _types |= mask;
+    }
+
+    /**
+     * @brief remove every name but the keywords of the event types added,
+     *        keeping the storage of the other names
+     */
+    void clear() {
+        _mask = _types;
+        _others.clear();
+    }
+
+    /**
+     * @brief get the keywords of the event types added
+     */
+    Mask types() const { return _types; }
+
+    /**
+     * @brief get the keywords in the table which this set contains
+     */
+    Mask mask() const { return _mask; }
+
+    /**
+     * @brief get the names which are not in the table, sorted
+     */
+    std::vector<std::string> const& others() const { return _others; }
+
+    /**
+     * @brief add a name; names which are not in the table are kept in order
+     */
+    void insert(std::string const& name);
+
+    /**
+     * @brief check whether a name is one of these keywords
+     */
+    bool contains(std::string const& name) const;
+
+    /**
+     * @brief get the number of keywords
+     */
+    size_t size() const;
+
+    /**
+     * @brief call func with each keyword, in sorted order
+     */
+    template<typename Func>
+    void forEach(Func func) const {
+        std::string const* table = names();
+        std::vector<std::string>::const_iterator other = _others.begin();
+        for (int i = 0; i < KEYWORD_COUNT; i++) {
+            if ((_mask & (1u << i)) == 0)
+                continue;
+            for (; (other != _others.end()) && (*other < table[i]); ++other)
+                func(*other);
+            func(table[i]);
+        }
+        for (; other != _others.end(); ++other)
+            func(*other);
+    }
+
+    /**
+     * @brief get the position of a name in the table of keywords
+     * @return the Keyword, or -1 if name is not in the table
+     */
+    static int find(std::string const& name);
+
+    /**
+     * @brief get the table of keywords, indexed by Keyword
+     */
+    static std::string const* names();
+
+private:
+    Mask _mask;
+
+    // the keywords of the event types added
+    Mask _types;
+
+    // names which are not in the table, sorted
+    std::vector<std::string> _others;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_KEYWORDSET_H*/
@@ -35,6 +35,8 @@
 #define LSST_CTRL_EVENTS_LOCATIONID_H
 
 #include <stdlib.h>
+#include <atomic>
+#include <string>
 
 #include "boost/shared_ptr.hpp"
 
@@ -45,9 +47,23 @@ namespace events {
 /**
  * @class LocationId
  * @brief Represent process that created an event
+ *
+ * A LocationId can also be packed into a single 63 bit ID, which holds the
+ * HostTable code of its host name, its process id in 22 bits, and its local
+ * id in 9 bits.  Transmitters using compact originators send this ID in the
+ * ORIG_ID and DEST_ID header properties, in place of three properties for
+ * each location.  A LocationId whose process id or local id does not fit
+ * has no ID, and is always sent as three properties.  Each new LocationId
+ * takes the next local id, so only the first 512 a process creates have an
+ * ID; a process which sends many events should reuse its LocationIds.
  */
 class LocationId {
 public:
+    /// the number of bits of the process id in a packed ID
+    static const int PID_BITS = 22;
+
+    /// the number of bits of the local id in a packed ID
+    static const int LOCAL_BITS = 9;
 
     /** 
      * @brief LocationId object. This object represents the originating process
@@ -70,6 +86,12 @@ public:
      */
     LocationId(std::string const& hostname, int pid, int localID);
 
+    /** 
+     * @brief LocationId object. This object represents the originating process
+     *        of an event.  When created, this represents an ID unpacked from
+     *        getId(); its host name is empty if the HostTable does not know it.
+     */
+    explicit LocationId(long long id);
 
     /** 
      * @brief Retrieve the host name
@@ -89,11 +111,38 @@ public:
      */
     int getLocalID() const;
 
+    /** 
+     * @brief Retrieve the packed ID
+     * @return a long long holding the host code, process id and local id,
+     *         which can be compared to ORIG_ID and DEST_ID in selectors, or
+     *         -1 if the process id or local id does not fit in it
+     */
+    long long getId() const;
+
+    /** 
+     * @brief check whether a process id and local id fit in a packed ID
+     */
+    static bool fits(int pid, int localID);
+
+    /** 
+     * @brief pack the parts of a LocationId into an ID
+     * @param hostCode the HostTable code of the host name
+     * @param pid the process id, which must fit in PID_BITS
+     * @param localID the local id, which must fit in LOCAL_BITS
+     */
+    static long long pack(unsigned int hostCode, int pid, int localID);
+
+    /** 
+     * @brief get the HostTable code of the host name in a packed ID
+     */
+    static unsigned int getHostCode(long long id);
+
 protected:
-    static int _localCounter; /// used for localID & is unique for instances of LocationId in a process
+    static std::atomic<int> _localCounter; /// used for localID & is unique for instances of LocationId in a process
     std::string _hostname;    /// host name
     int _pid;                 /// process id
     int _localID;             /// local id
+    long long _id;            /// packed ID
 
 };
 }
@@ -80,16 +80,22 @@ public:
 
     LogEvent();
     LogEvent(LocationId const& originatorId, PropertySet const& ps);
-    LogEvent(cms::TextMessage *msg);
+#ifndef SWIG
+    /// takes over psp, which must not be used afterwards, instead of copying it
+    LogEvent(LocationId const& originatorId, PTR(PropertySet)&& psp);
+    LogEvent(LocationId const& originatorId, PTR(PropertySet)&& psp, PropertySet const& filterable);
+    LogEvent(std::string const& runid, LocationId const& originatorId, PTR(PropertySet)&& psp);
+    LogEvent(std::string const& runid, LocationId const& originatorId, PTR(PropertySet)&& psp,
+             PropertySet const& filterable);
+#endif
+    LogEvent(cms::Message *msg);
 
     virtual ~LogEvent();
 
-    virtual void populateHeader(cms::TextMessage *msg) const;
+    int getLevel() const;
 
-    int getLevel();
-
-    std::string getLoggingTopic();
-    std::string getLogger();
+    std::string const& getLoggingTopic() const;
+    std::string getLogger() const;
 
 private:
     static const std::string DELIMITER;
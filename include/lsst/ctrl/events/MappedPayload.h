@@ -0,0 +1,81 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file MappedPayload.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the MappedPayload class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_MAPPEDPAYLOAD_H
+#define LSST_CTRL_EVENTS_MAPPEDPAYLOAD_H
+
+#include <cstddef>
+#include <string>
+
+#include "boost/noncopyable.hpp"
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class MappedPayload
+ * @brief The contents of a claim check file, mapped read-only into memory
+ *        for as long as the MappedPayload exists.
+ */
+class MappedPayload : private boost::noncopyable {
+public:
+    /**
+     * @brief map the file at path
+     * @throws lsst::pex::exceptions::RuntimeError if the file can not be
+     *         read, for instance because it was already removed
+     */
+    explicit MappedPayload(std::string const& path);
+
+    ~MappedPayload();
+
+    /**
+     * @brief get the contents of the file
+     */
+    unsigned char const* data() const { return _data; }
+
+    /**
+     * @brief get the size of the file in bytes
+     */
+    size_t size() const { return _size; }
+
+private:
+    unsigned char const* _data;
+    size_t _size;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_MAPPEDPAYLOAD_H*/
@@ -0,0 +1,112 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file NameDecoder.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the NameDecoder class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_NAMEDECODER_H
+#define LSST_CTRL_EVENTS_NAMEDECODER_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "lsst/base.h"
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+class Event;
+
+/**
+ * @class NameDecoder
+ * @brief Keep the name dictionaries of the transmitters whose events are
+ *        received, and expand the codes written by NameEncoder.
+ *
+ * The dictionaries are updated from the header of each message as it is
+ * received, and each event keeps the dictionary its body was written with,
+ * so that its body can still be decoded later.  An event whose body uses
+ * codes which have not been defined, because the receiver subscribed after
+ * their definitions were sent, can not be decoded until the whole dictionary
+ * is sent again.  Events filtered out by the selector of a Receiver are
+ * missed in the same way.
+ *
+ * Each Receiver owns one NameDecoder.
+ */
+class NameDecoder {
+public:
+    /// maximum number of dictionaries kept
+    static const size_t MAX_DICTIONARIES = 1024;
+
+    NameDecoder();
+
+    /**
+     * @brief update the dictionaries from the header of a received event,
+     *        and give the event the dictionary its body was written with
+     * @param event the event
+     * @param dictionary the DICTIONARY header property of the event
+     * @param definitions the NAMES header property of the event, or an empty
+     *        string if it has none
+     * @return false if the body of the event uses codes which are not defined
+     * @throws lsst::pex::exceptions::RuntimeError if the header properties are malformed
+     */
+    bool read(Event& event, std::string const& dictionary, std::string const& definitions);
+
+    /**
+     * @brief replace a name read from a body by the name it stands for
+     * @param names the dictionary the body was written with
+     * @param key the name as written, replaced by the property name
+     * @throws lsst::pex::exceptions::RuntimeError if key is an unknown code
+     */
+    static void expand(std::vector<std::string> const& names, std::string& key);
+
+    /**
+     * @brief forget every dictionary
+     */
+    void reset();
+
+private:
+    struct State {
+        long long lastUsed;
+        CONST_PTR(std::vector<std::string>) names;
+    };
+
+    void evict();
+
+    long long _clock;
+    std::map<std::string, State> _dictionaries;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_NAMEDECODER_H*/
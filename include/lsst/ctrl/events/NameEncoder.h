@@ -0,0 +1,138 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file NameEncoder.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the NameEncoder class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_NAMEENCODER_H
+#define LSST_CTRL_EVENTS_NAMEENCODER_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class NameEncoder
+ * @brief Replace the property names in JSON event bodies which are seen
+ *        repeatedly by short numeric codes.
+ *
+ * A name of at least MIN_NAME_LENGTH characters is given the next code,
+ * written "#<number>", the second time it is written; names are written as
+ * they are until then, with a leading '#' doubled.  The definitions of new
+ * codes are sent in the NAMES header property of the message whose body
+ * first uses them, as the number of their first code followed by the names,
+ * each on its own line.  Every getDefinitionInterval() messages the whole
+ * dictionary is sent again, so that receivers which subscribe later can
+ * pick it up.  The DICTIONARY header property of each message holds the ID
+ * of the dictionary and the number of codes its body may use, separated by
+ * a colon; NameDecoder uses it to expand the codes.
+ *
+ * Each Transmitter owns one NameEncoder.
+ */
+class NameEncoder {
+public:
+    static const int DEFAULT_DEFINITION_INTERVAL = 100;
+
+    /// shorter names are always written as they are
+    static const size_t MIN_NAME_LENGTH = 4;
+
+    /// maximum number of codes in a dictionary
+    static const size_t MAX_NAMES = 4096;
+
+    NameEncoder();
+
+    /**
+     * @brief get the text to write for a property name
+     * @param name the property name
+     * @return the code of name, or name itself, escaped if necessary; valid
+     *         until the next call
+     */
+    std::string const& encode(std::string const& name);
+
+    /**
+     * @brief get the header values for the message whose body was just written
+     * @param dictionary set to the value of the DICTIONARY header property
+     * @param definitions set to the value of the NAMES header property, or
+     *        to an empty string if there are no definitions to send
+     */
+    void finish(std::string& dictionary, std::string& definitions);
+
+    /**
+     * @brief set the number of messages between those which carry the whole
+     *        dictionary
+     * @throws lsst::pex::exceptions::RuntimeError if interval is less than 1
+     */
+    void setDefinitionInterval(int interval);
+
+    /**
+     * @brief get the number of messages between those which carry the whole
+     *        dictionary
+     */
+    int getDefinitionInterval() const { return _interval; }
+
+    /**
+     * @brief get the ID which distinguishes this dictionary from those of
+     *        other transmitters
+     */
+    std::string const& getId() const { return _id; }
+
+    /**
+     * @brief get the number of codes assigned
+     */
+    size_t size() const { return _names.size(); }
+
+private:
+    std::string _id;
+
+    // the code of each name, its text, and the names by code
+    std::map<std::string, size_t> _codes;
+    std::vector<std::string> _keys;
+    std::vector<std::string> _names;
+
+    // names which have been written once, and have no code yet
+    std::map<std::string, int> _seen;
+
+    // number of codes whose definitions have been sent
+    size_t _defined;
+
+    int _interval;
+    long long _written;
+    std::string _escaped;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_NAMEENCODER_H*/
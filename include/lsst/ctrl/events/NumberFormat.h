@@ -0,0 +1,91 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file NumberFormat.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the NumberFormat class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_NUMBERFORMAT_H
+#define LSST_CTRL_EVENTS_NUMBERFORMAT_H
+
+#include <cstddef>
+#include <string>
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class NumberFormat
+ * @brief Conversion of numbers to and from the text of JSON event bodies.
+ *
+ * The conversions neither allocate nor depend on the locale, and every
+ * value reads back bit for bit as it was written.  When the compiler
+ * provides std::to_chars and std::from_chars for floating point ("charconv"),
+ * those are used, and doubles and floats are written with the fewest digits
+ * which read back exactly.  Otherwise ("stdio") values which are short
+ * decimals are written as such, and all others with 17 (or for floats, 9)
+ * significant digits.
+ */
+class NumberFormat {
+public:
+    /// the size of a buffer which holds any formatted number
+    static const size_t MAX_LENGTH = 32;
+
+    /**
+     * @brief write value into buf, which is at least MAX_LENGTH characters
+     * @return the number of characters written; buf is not terminated
+     */
+    static size_t format(double value, char* buf);
+    static size_t format(float value, char* buf);
+    static size_t format(long long value, char* buf);
+
+    /**
+     * @brief convert all of the text in [begin, end)
+     * @return false if the text is not a number, or the number is out of
+     *         the range of result
+     */
+    static bool parse(char const* begin, char const* end, double& result);
+    static bool parse(char const* begin, char const* end, float& result);
+    static bool parse(char const* begin, char const* end, long long& result);
+    static bool parse(char const* begin, char const* end, long& result);
+    static bool parse(char const* begin, char const* end, int& result);
+
+    /**
+     * @brief get the name of the floating point conversion in use,
+     *        "charconv" or "stdio"
+     */
+    static std::string getImplementation();
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_NUMBERFORMAT_H*/
@@ -0,0 +1,134 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file PayloadCompressor.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the PayloadCompressor class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_PAYLOADCOMPRESSOR_H
+#define LSST_CTRL_EVENTS_PAYLOADCOMPRESSOR_H
+
+#include <string>
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class PayloadCompressor
+ * @brief Compress event bodies which are larger than a threshold, and stop
+ *        compressing when it does not pay.
+ *
+ * Compressed bodies are a 4 byte little-endian uncompressed length followed
+ * by a zlib stream, and are sent as a cms::BytesMessage whose COMPRESSION
+ * header property is PayloadCompressor::DEFLATE.
+ *
+ * Each Transmitter owns one PayloadCompressor, so the compression ratio is
+ * tracked per destination.  When the running ratio shows that compression
+ * saves too little, bodies are sent as they are for a while, and then
+ * compression is tried again in case the events have changed.
+ */
+class PayloadCompressor {
+public:
+    static const std::string DEFLATE;
+
+    /**
+     * @brief Constructor
+     * @param threshold the size in bytes at or above which bodies are
+     *        compressed; 0 turns compression off
+     */
+    explicit PayloadCompressor(size_t threshold = 0);
+
+    /**
+     * @brief compress a body if it is large enough, and compression is paying
+     * @param payload the body
+     * @param out overwritten with the compressed body
+     * @return true if out holds the body to send, false if payload should be sent as it is
+     */
+    bool compress(std::string const& payload, std::string& out);
+
+    /**
+     * @brief set the size in bytes at or above which bodies are compressed;
+     *        0 turns compression off
+     */
+    void setThreshold(size_t threshold);
+
+    /**
+     * @brief get the size in bytes at or above which bodies are compressed
+     */
+    size_t getThreshold() const { return _threshold; }
+
+    /**
+     * @brief get the running ratio of compressed to uncompressed size
+     */
+    double getRatio() const { return _ratio; }
+
+    /**
+     * @brief check whether bodies at or above the threshold are being compressed
+     * @return false if compression is off, or paused because it is not paying
+     */
+    bool isCompressing() const { return (_threshold > 0) && (_paused == 0); }
+
+    /**
+     * @brief compress data
+     * @param data the bytes to compress
+     * @param length the number of bytes in data
+     * @param out overwritten with the compressed body
+     */
+    static void deflate(unsigned char const* data, size_t length, std::string& out);
+    static std::string deflate(std::string const& data);
+
+    /**
+     * @brief decompress a body written by deflate()
+     * @param data the compressed body
+     * @param length the number of bytes in data
+     * @param out overwritten with the uncompressed bytes
+     * @throws lsst::pex::exceptions::RuntimeError if data is malformed
+     */
+    static void inflate(unsigned char const* data, size_t length, std::string& out);
+    static std::string inflate(std::string const& data);
+
+private:
+    size_t _threshold;
+
+    // exponentially weighted ratio of compressed to uncompressed size
+    double _ratio;
+
+    // number of bodies compressed since the ratio was last reset
+    int _samples;
+
+    // number of bodies left to send uncompressed before trying again
+    int _paused;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_PAYLOADCOMPRESSOR_H*/
@@ -38,9 +38,11 @@
 #include <cms/Connection.h>
 #include <cms/Session.h>
 #include <cms/TextMessage.h>
+#include <cms/BytesMessage.h>
 
 #include <stdlib.h>
 #include <iostream>
+#include <vector>
 
 #include <boost/shared_ptr.hpp>
 
@@ -48,8 +50,14 @@
 #include "lsst/utils/Utils.h"
 #include "lsst/daf/base/PropertySet.h"
 
+#include "lsst/ctrl/events/ChunkReader.h"
+#include "lsst/ctrl/events/ClaimCheckReader.h"
+#include "lsst/ctrl/events/DeltaReader.h"
 #include "lsst/ctrl/events/Event.h"
+#include "lsst/ctrl/events/EventBatch.h"
 #include "lsst/ctrl/events/EventBroker.h"
+#include "lsst/ctrl/events/NameDecoder.h"
+#include "lsst/ctrl/events/TypedEvent.h"
 
 using lsst::daf::base::PropertySet;
 
@@ -79,9 +87,117 @@ public:
      * @brief wait for a length of time for an event to be received.
      * @param timeout the length of time to wait in milliseconds; value of -1 waits indefinately.
      * @return an Event
+     * @note StatusEvents sent as deltas are returned complete.  A delta which
+     *       can not be completed, because earlier events from its originator
+     *       were missed, is discarded, and the wait continues, as is an event
+     *       whose body uses property name codes which have not been defined.
+     *       Events sent in chunks are returned once all of their chunks
+     *       have arrived.
      */
     PTR(Event) receiveEvent(long timeout);
 
+#ifndef SWIG
+    /**
+     * @brief wait for a length of time for an event to be received into a
+     *        TypedEvent
+     * @param event the TypedEvent which is set from the event received
+     * @param timeout the length of time to wait in milliseconds; value of -1 waits indefinately.
+     * @return true if an event was received, false if none arrived in time
+     * @throws lsst::pex::exceptions::Exception if the event received does
+     *         not have every field of the schema of the TypedEvent
+     * @note A message in the form TypedEvent::marshall() writes is read
+     *       without building a PropertySet.  Any other message is treated as
+     *       by receiveEvent(long), and the TypedEvent is set from the Event.
+     */
+    template<typename Schema>
+    bool receiveEvent(TypedEvent<Schema>& event, long timeout) {
+        TypedTarget<Schema> target(event);
+        return receive(timeout, true, target);
+    }
+#endif
+
+    /**
+     * @brief receive the events waiting, up to a number of them, in one
+     *        EventBatch
+     * @param count the largest number of events to receive
+     * @param timeout the length of time to wait for the first event in
+     *        milliseconds; value of -1 waits indefinately.  The events which
+     *        follow it are only taken if they have already arrived.
+     * @return an EventBatch, which is empty if no event arrived in time
+     * @note The events are treated as by receiveEvent(long).
+     */
+    PTR(EventBatch) receiveEvents(int count, long timeout);
+
+    /**
+     * @brief set the largest number of bytes of chunks kept while waiting
+     *        for the rest of their events
+     */
+    void setChunkBufferSize(size_t size);
+
+    /**
+     * @brief get the largest number of bytes of chunks kept
+     */
+    size_t getChunkBufferSize();
+
+    /**
+     * @brief set the time allowed for all of the chunks of an event to
+     *        arrive, after which those received are dropped
+     * @param timeout the time in milliseconds
+     * @throws lsst::pex::exceptions::RuntimeError if timeout is not positive
+     */
+    void setChunkTimeout(long timeout);
+
+    /**
+     * @brief get the time allowed for all of the chunks of an event to
+     *        arrive, in milliseconds
+     */
+    long getChunkTimeout();
+
+    /**
+     * @brief add a directory from which the bodies of events sent by claim
+     *        check are read; events which claim files anywhere else are
+     *        discarded, as are all events sent by claim check if no
+     *        directory is added
+     * @param directory the directory, as set on the transmitters
+     * @throws lsst::pex::exceptions::RuntimeError if directory is not a
+     *         directory
+     */
+    void addClaimCheckDirectory(std::string const& directory);
+
+    /**
+     * @brief get the directories from which the bodies of events sent by
+     *        claim check are read
+     */
+    std::vector<std::string> getClaimCheckDirectories();
+
+    /**
+     * @brief set the time files holding the bodies of events sent by claim
+     *        check are kept after they were written, before this receiver
+     *        removes them
+     * @param retention the time in milliseconds
+     * @throws lsst::pex::exceptions::RuntimeError if retention is not positive
+     */
+    void setClaimCheckRetention(long retention);
+
+    /**
+     * @brief get the time files holding the bodies of events sent by claim
+     *        check are kept, in milliseconds
+     */
+    long getClaimCheckRetention();
+
+    /**
+     * @brief set whether the file holding the body of an event sent by claim
+     *        check is removed as soon as the event is received; this is
+     *        only safe if no other receiver reads the files
+     */
+    void setClaimCheckRemoval(bool remove);
+
+    /**
+     * @brief check whether files holding the bodies of events sent by claim
+     *        check are removed as soon as their events are received
+     */
+    bool getClaimCheckRemoval();
+
     /**
      * @brief get the destination property name
      * @note This is the TYPE of the destination we're using, either a TOPIC or a QUEUE
@@ -111,6 +227,34 @@ protected:
     void init(const std::string& hostName, const std::string& destinationName, const std::string& selector, bool createQueue, int hostPort);
 
 private:
+    // what each message received is given to: either an Event, or a
+    // TypedEvent which reads the messages in its own form directly
+    class Target {
+    public:
+        virtual ~Target() {}
+        virtual bool read(cms::Message const*) { return false; }
+        virtual void take(PTR(Event) const& event) = 0;
+    };
+
+    class EventTarget;
+
+#ifndef SWIG
+    template<typename Schema>
+    class TypedTarget : public Target {
+    public:
+        explicit TypedTarget(TypedEvent<Schema>& event) : _event(event) {}
+        virtual bool read(cms::Message const* msg) { return _event.unmarshall(msg); }
+        virtual void take(PTR(Event) const& event) { _event.assign(*event); }
+    private:
+        TypedEvent<Schema>& _event;
+    };
+#endif
+
+    static long long currentMillis();
+    PTR(Event) receiveEvent(long timeout, bool wait);
+    bool receive(long timeout, bool wait, Target& target);
+    bool completeEvent(Event& event, cms::Message const* msg);
+    bool knowsHosts(cms::Message const* msg);
 
     // connection to the JMS broker
     cms::Connection* _connection;
@@ -124,6 +268,18 @@ private:
     // the selector for this receiver
     std::string _selector;
 
+    // the last properties of each originator sending delta encoded StatusEvents
+    DeltaReader _deltaReader;
+
+    // the property name codes of each transmitter using name compression
+    NameDecoder _nameDecoder;
+
+    // the chunks of events not yet received whole
+    ChunkReader _chunkReader;
+
+    // removal of the files holding the bodies of events sent by claim check
+    ClaimCheckReader _claimCheckReader;
+
 };
 
 
@@ -0,0 +1,81 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file SchemaReader.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the SchemaReader class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_SCHEMAREADER_H
+#define LSST_CTRL_EVENTS_SCHEMAREADER_H
+
+#include <string>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/PropertySet.h"
+
+using lsst::daf::base::PropertySet;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class SchemaReader
+ * @brief Decode the schema encoding written by SchemaWriter into a PropertySet.
+ *
+ * Definitions carried by an event are registered in the default
+ * SchemaRegistry; events which carry only a schema ID are decoded with the
+ * registered schema.
+ */
+class SchemaReader {
+public:
+    /**
+     * @brief decode an encoded body into a new PropertySet
+     * @param data the encoded bytes
+     * @throws lsst::pex::exceptions::RuntimeError if the data is malformed,
+     *         or its schema is not registered
+     */
+    static PTR(PropertySet) read(std::string const& data);
+
+    /**
+     * @brief decode an encoded body, adding its values to ps
+     * @param data the encoded bytes
+     * @param length the number of bytes in data
+     * @param ps the PropertySet to add values to
+     * @throws lsst::pex::exceptions::RuntimeError if the data is malformed,
+     *         or its schema is not registered
+     */
+    static void read(unsigned char const* data, size_t length, PropertySet& ps);
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_SCHEMAREADER_H*/
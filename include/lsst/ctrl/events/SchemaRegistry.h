@@ -0,0 +1,103 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file SchemaRegistry.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the SchemaRegistry class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_SCHEMAREGISTRY_H
+#define LSST_CTRL_EVENTS_SCHEMAREGISTRY_H
+
+#include <map>
+#include <mutex>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/ctrl/events/EventSchema.h"
+
+using lsst::daf::base::PropertySet;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class SchemaRegistry
+ * @brief The per-process cache of event schemas, keyed by schema ID.
+ *
+ * Transmitters register the shape of each event they send using the schema
+ * encoding, and Receivers register every definition which arrives in-band.
+ * A process which subscribes after a definition was last sent can register
+ * the shapes it expects ahead of time, so that it decodes events from the
+ * first one it receives.
+ */
+class SchemaRegistry {
+public:
+    /**
+     * @brief get the SchemaRegistry used by Transmitters and Receivers
+     */
+    static SchemaRegistry& getDefaultSchemaRegistry();
+
+    /**
+     * @brief register a schema
+     * @return the registered schema with the same ID, which is schema itself
+     *         if it was not already registered
+     * @throws lsst::pex::exceptions::RuntimeError if a different schema with
+     *         the same ID is already registered
+     */
+    PTR(EventSchema) registerSchema(PTR(EventSchema) schema);
+
+    /**
+     * @brief register the shape of a PropertySet
+     * @return the registered schema
+     */
+    PTR(EventSchema) registerSchema(PropertySet const& ps);
+
+    /**
+     * @brief get a registered schema
+     * @param id the schema ID
+     * @return the schema, or a null pointer if no schema with that ID is registered
+     */
+    PTR(EventSchema) getSchema(unsigned long long id);
+
+    /**
+     * @brief get the number of registered schemas
+     */
+    size_t size();
+
+private:
+    std::mutex _mutex;
+    std::map<unsigned long long, PTR(EventSchema)> _schemas;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_SCHEMAREGISTRY_H*/
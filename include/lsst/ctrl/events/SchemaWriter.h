@@ -0,0 +1,120 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file SchemaWriter.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the SchemaWriter class
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_SCHEMAWRITER_H
+#define LSST_CTRL_EVENTS_SCHEMAWRITER_H
+
+#include <map>
+#include <string>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/PropertySet.h"
+
+using lsst::daf::base::PropertySet;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @class SchemaWriter
+ * @brief Serialize a PropertySet as a schema ID followed by its values,
+ *        without property names or type tags.
+ *
+ * The encoding is:
+ * @code
+ * body       := VERSION id flag definition? values*
+ * definition := count (string tag)*
+ * values     := count value*
+ * @endcode
+ * where id is the 8 byte little-endian EventSchema ID, flag is 1 when the
+ * schema definition follows and 0 otherwise, and the values of each field
+ * of the schema follow in schema order, encoded as BinaryWriter does.
+ *
+ * The definition is sent with the first event of each shape and then with
+ * every definition interval'th event of that shape, so that receivers which
+ * subscribe late learn it; the other events carry only the schema ID.
+ */
+class SchemaWriter {
+public:
+    static const unsigned char VERSION = 1;
+    static const int DEFAULT_DEFINITION_INTERVAL = 100;
+
+    /**
+     * @brief Constructor
+     * @param interval the number of events of a shape between the ones
+     *        which carry its definition
+     */
+    explicit SchemaWriter(int interval = DEFAULT_DEFINITION_INTERVAL);
+
+    /**
+     * @brief encode a PropertySet, registering its schema in the
+     *        default SchemaRegistry
+     * @param ps the PropertySet to encode
+     * @param out the std::string which is overwritten with the encoded bytes
+     * @throws lsst::pex::exceptions::RuntimeError if a property has a type
+     *         which can not be marshalled
+     */
+    void write(PropertySet const& ps, std::string& out);
+
+    /**
+     * @brief encode a PropertySet
+     * @return a std::string containing the encoded bytes
+     */
+    std::string write(PropertySet const& ps);
+
+    /**
+     * @brief set the number of events of a shape between the ones which
+     *        carry its definition; 1 sends the definition with every event
+     * @throws lsst::pex::exceptions::RuntimeError if interval is less than 1
+     */
+    void setDefinitionInterval(int interval);
+
+    /**
+     * @brief get the number of events of a shape between the ones which
+     *        carry its definition
+     */
+    int getDefinitionInterval() const { return _interval; }
+
+private:
+    int _interval;
+
+    // number of events written, by schema ID
+    std::map<unsigned long long, unsigned long> _written;
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_SCHEMAWRITER_H*/
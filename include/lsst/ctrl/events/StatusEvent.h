@@ -66,6 +66,10 @@ public:
     static std::string const ORIG_PROCESSID;
     static std::string const ORIG_LOCALID;
 
+    /// the header property holding the packed originator, when a Transmitter
+    /// sends compact originators; received events have the three above instead
+    static std::string const ORIG_ID;
+
     /** 
      * @brief Constructor to create a StatusEvent
      */
@@ -73,9 +77,9 @@ public:
     virtual ~StatusEvent();
 
     /** 
-     * @brief Constructor to convert a TextMessage into a StatusEvent
+     * @brief Constructor to convert a cms::Message into a StatusEvent
      */
-    StatusEvent(cms::TextMessage *msg);
+    StatusEvent(cms::Message *msg);
 
     /** 
      * @brief Constructor to create a StatusEvent
@@ -131,17 +135,54 @@ public:
      */
     StatusEvent(std::string const& runid, LocationId const& originator, CONST_PTR(PropertySet) psp, PropertySet const& filterable);
 
+#ifndef SWIG
+    /** 
+     * @brief Constructor to create a StatusEvent which takes over its PropertySet
+     * @param originator the LocationId of where this StatusEvent was created
+     * @param psp a PTR(PropertySet), which becomes part of the event and
+     *        must not be used afterwards
+     */
+    StatusEvent(LocationId const& originator, PTR(PropertySet)&& psp);
 
     /** 
-     * @brief accessor to get originator information
-     * @return a LocationId containing the Originator information
+     * @brief Constructor to create a StatusEvent which takes over its PropertySet
+     * @param originator the LocationId of where this StatusEvent was created
+     * @param psp a PTR(PropertySet), which becomes part of the event and
+     *        must not be used afterwards
+     * @param filterable a PropertySet that will be added to Event headers so
+     *        they can be filtered using selectors.
      */
-    LocationId *getOriginator();
+    StatusEvent(LocationId const& originator, PTR(PropertySet)&& psp, PropertySet const& filterable);
 
-    /*  method used to take originator from the TextMessage to set in
-     * the StatusEvent
+    /** 
+     * @brief Constructor to create a StatusEvent which takes over its PropertySet
+     * @param runid a string identify for this Event
+     * @param originator the LocationId of where this StatusEvent was created
+     * @param psp a PTR(PropertySet), which becomes part of the event and
+     *        must not be used afterwards
+     */
+    StatusEvent(std::string const& runid, LocationId const& originator, PTR(PropertySet)&& psp);
+
+    /** 
+     * @brief Constructor to create a StatusEvent which takes over its PropertySet
+     * @param runid a string identify for this Event
+     * @param originator the LocationId of where this StatusEvent was created
+     * @param psp a PTR(PropertySet), which becomes part of the event and
+     *        must not be used afterwards
+     * @param filterable a PropertySet that will be added to Event headers so
+     *        they can be filtered using selectors.
+     */
+    StatusEvent(std::string const& runid, LocationId const& originator, PTR(PropertySet)&& psp, PropertySet const& filterable);
+#endif
+
+
+    /** 
+     * @brief accessor to get originator information
+     * @return a LocationId containing the Originator information; if the
+     *         event was received with the ID left packed, because two hosts
+     *         share its code, the host name is empty
      */
-    virtual void populateHeader(cms::TextMessage *msg) const;
+    LocationId *getOriginator() const;
 
 private:
     void _init();
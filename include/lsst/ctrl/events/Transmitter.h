@@ -36,14 +36,24 @@
 #include <cms/Connection.h>
 #include <cms/Session.h>
 #include <cms/TextMessage.h>
+#include <cms/BytesMessage.h>
 
 #include <stdlib.h>
 #include <iostream>
+#include <map>
+
+#include "boost/scoped_ptr.hpp"
 
 #include "lsst/daf/base/PropertySet.h"
 
+#include "lsst/ctrl/events/ChunkWriter.h"
+#include "lsst/ctrl/events/ClaimCheckWriter.h"
 #include "lsst/ctrl/events/Event.h"
 #include "lsst/ctrl/events/EventBroker.h"
+#include "lsst/ctrl/events/DeltaWriter.h"
+#include "lsst/ctrl/events/NameEncoder.h"
+#include "lsst/ctrl/events/PayloadCompressor.h"
+#include "lsst/ctrl/events/TypedEvent.h"
 
 using lsst::daf::base::PropertySet;
 
@@ -71,9 +81,29 @@ public:
     /**
      * @brief Publish an Event to this object's topic
      * @param event an Event to publish
+     * @note A body which is split into chunks (see setChunkSize) is sent
+     *       whole before this returns: every chunk is sent, one after the
+     *       other, in this call, so it takes as long as sending the
+     *       unsplit body, and the next event waits for all of them.
      */
     void publishEvent(Event& event);
 
+#ifndef SWIG
+    /**
+     * @brief Publish a TypedEvent to this object's topic
+     * @param event a TypedEvent to publish
+     * @note TypedEvents are always sent as JSON, and are never compressed,
+     *       chunked or sent by claim check.
+     */
+    template<typename Schema>
+    void publishEvent(TypedEvent<Schema> const& event) {
+        boost::scoped_ptr<cms::TextMessage> message(_session->createTextMessage());
+        event.marshall(message.get());
+        message->setStringProperty(getDestinationPropertyName(), _destinationName);
+        sendMessage(message.get());
+    }
+#endif
+
     /**
      * @brief get the destination property name
      * @note This is the TYPE of the destination we're using, either a TOPIC or a QUEUE
@@ -86,6 +116,203 @@ public:
      */
     std::string getDestinationName();
 
+    /**
+     * @brief set the encoding used for the bodies of published events
+     * @param encoding EventEncodings::JSON, the default, which every receiver
+     *        understands, EventEncodings::BINARY or EventEncodings::SCHEMA
+     * @throws lsst::pex::exceptions::RuntimeError if encoding is unknown
+     */
+    void setEncoding(std::string const& encoding);
+
+    /**
+     * @brief get the encoding used for the bodies of published events
+     * @return a std::string naming the encoding
+     */
+    std::string getEncoding();
+
+    /**
+     * @brief set the number of events of a shape between the ones which carry
+     *        the definition of their schema, when using EventEncodings::SCHEMA
+     * @throws lsst::pex::exceptions::RuntimeError if interval is less than 1
+     */
+    void setSchemaDefinitionInterval(int interval);
+
+    /**
+     * @brief get the number of events of a shape between the ones which carry
+     *        the definition of their schema
+     */
+    int getSchemaDefinitionInterval();
+
+    /**
+     * @brief set the size in bytes at or above which event bodies are
+     *        compressed; 0, the default, turns compression off.
+     * @note compressed events can only be read by receivers from releases
+     *       which support compression
+     */
+    void setCompressionThreshold(size_t threshold);
+
+    /**
+     * @brief get the size in bytes at or above which event bodies are compressed
+     */
+    size_t getCompressionThreshold();
+
+    /**
+     * @brief get the running ratio of compressed to uncompressed body size
+     *        for this destination
+     */
+    double getCompressionRatio();
+
+    /**
+     * @brief check whether large event bodies are being compressed
+     * @return false if compression is off, or paused because it was not
+     *         paying for this destination
+     */
+    bool isCompressing();
+
+    /**
+     * @brief turn delta encoding of StatusEvents on or off; it is off by default.
+     * @note When it is on, successive StatusEvents from the same originator
+     *       only carry the custom properties which changed, between keyframes
+     *       which carry all of them.  Such events can only be read by
+     *       receivers from releases which support delta encoding.  A
+     *       receiver with a selector which filters out some of the events
+     *       of an originator only receives its keyframes, and the deltas
+     *       which directly follow them.
+     */
+    void setDeltaEncoding(bool enabled);
+
+    /**
+     * @brief check whether StatusEvents are delta encoded
+     */
+    bool getDeltaEncoding();
+
+    /**
+     * @brief set the number of StatusEvents from an originator between
+     *        keyframes, when using delta encoding
+     * @throws lsst::pex::exceptions::RuntimeError if interval is less than 1
+     */
+    void setKeyframeInterval(int interval);
+
+    /**
+     * @brief get the number of StatusEvents from an originator between keyframes
+     */
+    int getKeyframeInterval();
+
+    /**
+     * @brief turn the replacement of repeated property names in JSON event
+     *        bodies by short codes on or off; it is off by default.
+     * @note The codes are defined in the headers of the events, and such
+     *       events can only be read by receivers from releases which support
+     *       name codes.  A receiver with a selector which filters out the
+     *       events defining some codes discards the events which use them
+     *       until the whole dictionary is sent again.
+     */
+    void setNameCompression(bool enabled);
+
+    /**
+     * @brief check whether repeated property names are replaced by codes
+     */
+    bool getNameCompression();
+
+    /**
+     * @brief set the number of events between those which carry the whole
+     *        dictionary of name codes, when using name compression
+     * @throws lsst::pex::exceptions::RuntimeError if interval is less than 1
+     */
+    void setNameDefinitionInterval(int interval);
+
+    /**
+     * @brief get the number of events between those which carry the whole
+     *        dictionary of name codes
+     */
+    int getNameDefinitionInterval();
+
+    /**
+     * @brief set the largest message body which is sent whole; larger ones
+     *        are split into chunks of this size, which receivers put back
+     *        together
+     * @param size the size in bytes, or 0, the default, to never split
+     *        bodies
+     * @throws lsst::pex::exceptions::RuntimeError if size is below
+     *         ChunkWriter::MIN_CHUNK_SIZE, but not 0
+     * @note Chunks limit the size of each message on the broker, not the
+     *       time spent publishing: publishEvent sends all of the chunks of
+     *       an event before it returns.
+     */
+    void setChunkSize(size_t size);
+
+    /**
+     * @brief get the largest message body which is sent whole, or 0 if
+     *        bodies are never split
+     */
+    size_t getChunkSize();
+
+    /**
+     * @brief set the directory to which large message bodies are written,
+     *        to be sent by reference rather than through the broker
+     * @param directory a directory which receivers read under the same
+     *        path, such as /dev/shm on a single host or a directory on a
+     *        shared filesystem; "", the default, sends every body in its
+     *        message
+     * @throws lsst::pex::exceptions::RuntimeError if directory is not a
+     *         directory
+     */
+    void setClaimCheckDirectory(std::string const& directory);
+
+    /**
+     * @brief get the directory to which large message bodies are written,
+     *        or "" if they are not
+     */
+    std::string getClaimCheckDirectory();
+
+    /**
+     * @brief set the size in bytes at or above which message bodies are
+     *        written to the claim check directory
+     */
+    void setClaimCheckThreshold(size_t threshold);
+
+    /**
+     * @brief get the size in bytes at or above which message bodies are
+     *        written to the claim check directory
+     */
+    size_t getClaimCheckThreshold();
+
+    /**
+     * @brief turn compact originators on or off; they are off by default.
+     * @note When they are on, the originator and destination of each
+     *       StatusEvent, CommandEvent and LogEvent are sent as one packed
+     *       ID each, in the ORIG_ID and DEST_ID header properties, rather
+     *       than as three properties, and the names of their hosts are sent
+     *       in the HOSTS header property of the first event from each host,
+     *       and every HostTable::DEFINITION_INTERVAL events after it.
+     *       Receivers give such events the ORIG_* and DEST_* properties
+     *       back, but selectors must use ORIG_ID and DEST_ID, and only
+     *       receivers from releases which support compact originators can
+     *       read them.
+     */
+    void setCompactOriginator(bool enabled);
+
+    /**
+     * @brief check whether originators are sent as packed IDs
+     */
+    bool getCompactOriginator();
+
+    /**
+     * @brief turn packing of numeric arrays in JSON bodies on or off; it is
+     *        off by default.
+     * @note When it is on, arrays of at least JSONWriter::PACK_THRESHOLD
+     *       int, long, long long, float or double values are sent as one
+     *       block of base64 encoded little-endian values.  Only receivers
+     *       from releases which support packed arrays can read them; older
+     *       ones read each packed array as an empty PropertySet.
+     */
+    void setArrayPacking(bool enabled);
+
+    /**
+     * @brief check whether numeric arrays in JSON bodies are packed
+     */
+    bool getArrayPacking();
+
 protected:
     std::string _destinationName;
 
@@ -95,6 +322,9 @@ protected:
     void init( const std::string& hostName, const std::string& destinationName, bool createQueue, int port);
 
 private:
+    void sendChunks(cms::Message const* header, std::string const& body);
+    void sendMessage(cms::Message* message);
+    void defineHosts(cms::Message* message);
 
     // Connection to JMS broker
     cms::Connection* _connection;
@@ -108,6 +338,38 @@ private:
     // internal info about how to contact JMS
     std::string _brokerUri;
 
+    // encoding of event bodies
+    std::string _encoding;
+
+    // schema IDs and definitions sent, for EventEncodings::SCHEMA
+    SchemaWriter _schemaWriter;
+
+    // compression of event bodies sent to this destination
+    PayloadCompressor _compressor;
+
+    // StatusEvents last sent by each originator, for delta encoding
+    bool _deltaEncoding;
+    DeltaWriter _deltaWriter;
+
+    // whether long numeric arrays in JSON bodies are packed
+    bool _arrayPacking;
+
+    // codes of the property names in JSON event bodies sent to this destination
+    bool _nameCompression;
+    NameEncoder _nameEncoder;
+
+    // splitting of large bodies into chunks
+    ChunkWriter _chunkWriter;
+
+    // files holding the largest bodies, sent by reference
+    ClaimCheckWriter _claimCheckWriter;
+
+    // codes of the hosts in packed locations, and the number of events
+    // sent with compact originators when each was last defined
+    bool _compactOriginator;
+    std::map<unsigned int, long long> _hostsDefined;
+    long long _compactEvents;
+
 };
 
 } } }
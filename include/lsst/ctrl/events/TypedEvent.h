@@ -0,0 +1,562 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file TypedEvent.h
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief defines the TypedEvent class template
+ *
+ */
+
+#ifndef LSST_CTRL_EVENTS_TYPEDEVENT_H
+#define LSST_CTRL_EVENTS_TYPEDEVENT_H
+
+#include <cms/Message.h>
+#include <cms/TextMessage.h>
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/PropertySet.h"
+
+#include "lsst/ctrl/events/Event.h"
+#include "lsst/ctrl/events/EventEncodings.h"
+#include "lsst/ctrl/events/EventTypes.h"
+#include "lsst/ctrl/events/JSONScanner.h"
+#include "lsst/ctrl/events/JSONWriter.h"
+#include "lsst/ctrl/events/NumberFormat.h"
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+/**
+ * @brief the description of one field of a TypedEvent schema
+ */
+struct TypedField {
+    /// the property name of the field
+    char const* name;
+
+    /// true if the field is sent in the message header, where selectors
+    /// can filter on it, rather than in the body
+    bool filterable;
+};
+
+/**
+ * @class TypedValue
+ * @brief The conversions of one type of TypedEvent field; it is defined
+ *        for bool, int, long long, float, double and std::string.
+ */
+template<typename T>
+class TypedValue;
+
+template<>
+class TypedValue<bool> {
+public:
+    static char const* tag() { return "bool"; }
+    static void setProperty(cms::Message* msg, std::string const& name, bool value) {
+        msg->setBooleanProperty(name, value);
+    }
+    static void getProperty(cms::Message const* msg, std::string const& name, bool& value) {
+        value = msg->getBooleanProperty(name);
+    }
+    static void get(PropertySet const& ps, std::string const& name, bool& value) {
+        value = ps.get<bool>(name);
+    }
+    static void append(bool value, std::string& out) {
+        out.append(value ? "\"true\"" : "\"false\"");
+    }
+    static bool parse(char const* begin, char const* end, bool& value) {
+        std::string text(begin, end);
+        if ((text == "true") || (text == "1"))
+            value = true;
+        else if ((text == "false") || (text == "0"))
+            value = false;
+        else
+            return false;
+        return true;
+    }
+};
+
+template<>
+class TypedValue<int> {
+public:
+    static char const* tag() { return "int"; }
+    static void setProperty(cms::Message* msg, std::string const& name, int value) {
+        msg->setIntProperty(name, value);
+    }
+    static void getProperty(cms::Message const* msg, std::string const& name, int& value) {
+        value = msg->getIntProperty(name);
+    }
+    static void get(PropertySet const& ps, std::string const& name, int& value) {
+        value = ps.get<int>(name);
+    }
+    static void append(int value, std::string& out) {
+        char buf[NumberFormat::MAX_LENGTH];
+        out.push_back('"');
+        out.append(buf, NumberFormat::format(static_cast<long long>(value), buf));
+        out.push_back('"');
+    }
+    static bool parse(char const* begin, char const* end, int& value) {
+        return NumberFormat::parse(begin, end, value);
+    }
+};
+
+template<>
+class TypedValue<long long> {
+public:
+    static char const* tag() { return "long long"; }
+    static void setProperty(cms::Message* msg, std::string const& name, long long value) {
+        msg->setLongProperty(name, value);
+    }
+    static void getProperty(cms::Message const* msg, std::string const& name, long long& value) {
+        value = msg->getLongProperty(name);
+    }
+    static void get(PropertySet const& ps, std::string const& name, long long& value) {
+        value = ps.getAsInt64(name);
+    }
+    static void append(long long value, std::string& out) {
+        char buf[NumberFormat::MAX_LENGTH];
+        out.push_back('"');
+        out.append(buf, NumberFormat::format(value, buf));
+        out.push_back('"');
+    }
+    static bool parse(char const* begin, char const* end, long long& value) {
+        return NumberFormat::parse(begin, end, value);
+    }
+};
+
+template<>
+class TypedValue<float> {
+public:
+    static char const* tag() { return "float"; }
+    static void setProperty(cms::Message* msg, std::string const& name, float value) {
+        msg->setFloatProperty(name, value);
+    }
+    static void getProperty(cms::Message const* msg, std::string const& name, float& value) {
+        value = msg->getFloatProperty(name);
+    }
+    static void get(PropertySet const& ps, std::string const& name, float& value) {
+        value = ps.get<float>(name);
+    }
+    static void append(float value, std::string& out) {
+        char buf[NumberFormat::MAX_LENGTH];
+        out.push_back('"');
+        out.append(buf, NumberFormat::format(value, buf));
+        out.push_back('"');
+    }
+    static bool parse(char const* begin, char const* end, float& value) {
+        return NumberFormat::parse(begin, end, value);
+    }
+};
+
+template<>
+class TypedValue<double> {
+public:
+    static char const* tag() { return "double"; }
+    static void setProperty(cms::Message* msg, std::string const& name, double value) {
+        msg->setDoubleProperty(name, value);
+    }
+    static void getProperty(cms::Message const* msg, std::string const& name, double& value) {
+        value = msg->getDoubleProperty(name);
+    }
+    static void get(PropertySet const& ps, std::string const& name, double& value) {
+        value = ps.get<double>(name);
+    }
+    static void append(double value, std::string& out) {
+        char buf[NumberFormat::MAX_LENGTH];
+        out.push_back('"');
+        out.append(buf, NumberFormat::format(value, buf));
+        out.push_back('"');
+    }
+    static bool parse(char const* begin, char const* end, double& value) {
+        return NumberFormat::parse(begin, end, value);
+    }
+};
+
+template<>
+class TypedValue<std::string> {
+public:
+    static char const* tag() { return "string"; }
+    static void setProperty(cms::Message* msg, std::string const& name, std::string const& value) {
+        msg->setStringProperty(name, value);
+    }
+    static void getProperty(cms::Message const* msg, std::string const& name, std::string& value) {
+        value = msg->getStringProperty(name);
+    }
+    static void get(PropertySet const& ps, std::string const& name, std::string& value) {
+        value = ps.get<std::string>(name);
+    }
+    static void append(std::string const& value, std::string& out) {
+        JSONWriter::writeString(value, out);
+    }
+    static bool parse(char const* begin, char const* end, std::string& value) {
+        value.assign(begin, end);
+        return true;
+    }
+};
+
+/**
+ * @class TypedFields
+ * @brief The code generated for fields I to N - 1 of a TypedEvent schema,
+ *        one field at a time; used by TypedEvent.
+ */
+template<typename Schema, size_t I = 0, size_t N = std::tuple_size<typename Schema::Types>::value>
+class TypedFields {
+public:
+    typedef typename Schema::Types Types;
+    typedef typename std::tuple_element<I, Types>::type Type;
+    typedef TypedFields<Schema, I + 1, N> Next;
+
+    static TypedField const& field() { return Schema::fields()[I]; }
+
+    /// the name of the field, made once
+    static std::string const& name() {
+        static std::string const fieldName(field().name);
+        return fieldName;
+    }
+
+    /// the bits of the fields which are sent in the body
+    static unsigned long long payloadMask() {
+        return (field().filterable ? 0ULL : (1ULL << I)) | Next::payloadMask();
+    }
+
+    static void populateHeader(Types const& values, cms::Message* msg) {
+        if (field().filterable)
+            TypedValue<Type>::setProperty(msg, name(), std::get<I>(values));
+        Next::populateHeader(values, msg);
+    }
+
+    /// false if the header lacks a filterable field
+    static bool readHeader(cms::Message const* msg, Types& values) {
+        if (field().filterable) {
+            if (!msg->propertyExists(name()))
+                return false;
+            TypedValue<Type>::getProperty(msg, name(), std::get<I>(values));
+        }
+        return Next::readHeader(msg, values);
+    }
+
+    static void write(Types const& values, bool first, std::string& out) {
+        if (!field().filterable) {
+            if (!first)
+                out.push_back(',');
+            first = false;
+            JSONWriter::writeString(name(), out);
+            out.append(":{\"", 3);
+            out.append(TypedValue<Type>::tag());
+            out.append("\":", 2);
+            TypedValue<Type>::append(std::get<I>(values), out);
+            out.push_back('}');
+        }
+        Next::write(values, first, out);
+    }
+
+    /// set the body field named [text, text + length) from its tag and value
+    /// text; false if there is no such field, or the tag or value do not match it
+    static bool parse(char const* text, size_t length, char const* tag, size_t tagLength,
+                      char const* value, char const* valueEnd, Types& values, unsigned long long& found) {
+        if (!field().filterable && (name().size() == length) && (memcmp(name().data(), text, length) == 0)) {
+            char const* expected = TypedValue<Type>::tag();
+            if ((found & (1ULL << I)) || (strlen(expected) != tagLength) ||
+                (memcmp(expected, tag, tagLength) != 0))
+                return false;
+            found |= 1ULL << I;
+            return TypedValue<Type>::parse(value, valueEnd, std::get<I>(values));
+        }
+        return Next::parse(text, length, tag, tagLength, value, valueEnd, values, found);
+    }
+
+    static void assign(PropertySet const& ps, Types& values) {
+        TypedValue<Type>::get(ps, name(), std::get<I>(values));
+        Next::assign(ps, values);
+    }
+};
+
+template<typename Schema, size_t N>
+class TypedFields<Schema, N, N> {
+public:
+    typedef typename Schema::Types Types;
+
+    static unsigned long long payloadMask() { return 0; }
+    static void populateHeader(Types const&, cms::Message*) {}
+    static bool readHeader(cms::Message const*, Types&) { return true; }
+    static void write(Types const&, bool, std::string&) {}
+    static bool parse(char const*, size_t, char const*, size_t, char const*, char const*, Types&,
+                      unsigned long long&) {
+        return false;
+    }
+    static void assign(PropertySet const&, Types&) {}
+};
+
+/**
+ * @class TypedEvent
+ * @brief An Event whose fields are fixed at compile time by a schema, so
+ *        that it is sent and received without a PropertySet
+ *
+ * The Schema is a class which declares the types of the fields as a
+ * std::tuple, and describes them with a constexpr std::array of
+ * TypedField, in the same order:
+ *
+ * @code
+ * struct CcdTemperature {
+ *     typedef std::tuple<int, double, std::string> Types;
+ *     static std::array<TypedField, 3> const& fields() {
+ *         static constexpr std::array<TypedField, 3> f = {{
+ *             { "ccd", true }, { "temperature", false }, { "state", false }
+ *         }};
+ *         return f;
+ *     }
+ * };
+ *
+ * TypedEvent<CcdTemperature> event("myrun");
+ * event.set<0>(12);
+ * event.set<1>(-98.5);
+ * event.set<2>("cooling");
+ * transmitter.publishEvent(event);
+ * @endcode
+ *
+ * Fields may be bool, int, long long, float, double or std::string.  A
+ * TypedEvent is sent as a plain Event with a JSON body, with its
+ * filterable fields in the header, so every Receiver decodes it.
+ * Receiver::receiveEvent(TypedEvent&, long) receives one back, reading
+ * bodies in the form marshall() writes without building a PropertySet,
+ * and any other event which carries the fields of the schema through
+ * assign().  TypedEvents are not compressed, chunked or sent by claim check.
+ */
+template<typename Schema>
+class TypedEvent {
+public:
+    typedef typename Schema::Types Types;
+    typedef TypedFields<Schema> Fields;
+
+    static_assert(std::tuple_size<Types>::value ==
+                  std::tuple_size<typename std::decay<decltype(Schema::fields())>::type>::value,
+                  "a TypedEvent schema must describe each of its Types");
+    static_assert(std::tuple_size<Types>::value <= 64, "a TypedEvent schema has at most 64 fields");
+
+    /**
+     * @brief Constructor for a TypedEvent with default field values
+     * @param runid A "run id" to place in the header of this event, if not empty
+     */
+    explicit TypedEvent(std::string const& runid = std::string()) :
+        _runId(runid), _status("unknown"), _topic(Event::UNINITIALIZED), _pubTime(0) {
+        updateEventTime();
+    }
+
+    /**
+     * @brief get field I
+     */
+    template<size_t I>
+    typename std::tuple_element<I, Types>::type const& get() const { return std::get<I>(_values); }
+
+    /**
+     * @brief set field I
+     */
+    template<size_t I, typename V>
+    void set(V&& value) { std::get<I>(_values) = std::forward<V>(value); }
+
+    std::string const& getRunId() const { return _runId; }
+    void setRunId(std::string const& runid) { _runId = runid; }
+
+    std::string const& getStatus() const { return _status; }
+    void setStatus(std::string const& status) { _status = status; }
+
+    long long getEventTime() const { return _eventTime; }
+    void setEventTime(long long nsecs) { _eventTime = nsecs; }
+    void updateEventTime() { _eventTime = lsst::daf::base::DateTime::now().nsecs(); }
+
+    std::string const& getTopic() const { return _topic; }
+    long long getPubTime() const { return _pubTime; }
+
+    /**
+     * @brief populate a cms::Message header with the reserved properties of
+     *        an Event and the filterable fields
+     */
+    void populateHeader(cms::Message* msg) const {
+        msg->setStringProperty(Event::TYPE, EventTypes::EVENT);
+        msg->setLongProperty(Event::EVENTTIME, _eventTime);
+        msg->setStringProperty(Event::STATUS, _status);
+        msg->setStringProperty(Event::TOPIC, _topic);
+        msg->setLongProperty(Event::PUBTIME, _pubTime);
+        if (!_runId.empty())
+            msg->setStringProperty(Event::RUNID, _runId);
+        Fields::populateHeader(_values, msg);
+    }
+
+    /**
+     * @brief write the fields which are not filterable as a JSON event body
+     * @param out buffer the body is written into; its previous contents are discarded
+     */
+    void marshallPayload(std::string& out) const {
+        out.clear();
+        out.push_back('{');
+        Fields::write(_values, true, out);
+        out.push_back('}');
+    }
+
+    /**
+     * @brief marshall this event into a cms::TextMessage
+     */
+    void marshall(cms::TextMessage* msg) const {
+        std::string body;
+        marshallPayload(body);
+        populateHeader(msg);
+        msg->setText(body);
+    }
+
+    /**
+     * @brief set this event from a message in the form marshall() writes
+     * @return false, leaving this event unchanged, for any other message,
+     *         which Receiver::receiveEvent(TypedEvent&, long) decodes as
+     *         an Event
+     */
+    bool unmarshall(cms::Message const* msg) {
+        cms::TextMessage const* text = dynamic_cast<cms::TextMessage const*>(msg);
+        bool plain = (text != NULL) &&
+                     (!msg->propertyExists(Event::ENCODING) ||
+                      (msg->getStringProperty(Event::ENCODING) == EventEncodings::JSON)) &&
+                     !msg->propertyExists(Event::COMPRESSION) && !msg->propertyExists(Event::DICTIONARY) &&
+                     !msg->propertyExists(Event::DELTA) && !msg->propertyExists(Event::SEQUENCE) &&
+                     !msg->propertyExists(Event::CHUNKSET) && !msg->propertyExists(Event::CLAIMCHECK);
+        if (!plain)
+            return false;
+        std::string body = text->getText();
+        Types values;
+        if (!parsePayload(body.data(), body.data() + body.size(), values) || !Fields::readHeader(msg, values))
+            return false;
+        _values = std::move(values);
+        readReserved(msg);
+        return true;
+    }
+
+    /**
+     * @brief set this event from the properties of an Event
+     * @throws lsst::pex::exceptions::Exception if event does not have every
+     *         field of the schema
+     */
+    void assign(Event& event) {
+        CONST_PTR(PropertySet) ps = event.getPropertySet();
+        Fields::assign(*ps, _values);
+        _eventTime = event.getEventTime();
+        _status = event.getStatus();
+        _topic = event.getTopic();
+        _pubTime = event.getPubTime();
+        _runId = ps->exists(Event::RUNID) ? event.getRunId() : std::string();
+    }
+
+private:
+    Types _values;
+    std::string _runId;
+    std::string _status;
+    std::string _topic;
+    long long _eventTime;
+    long long _pubTime;
+
+    void readReserved(cms::Message const* msg) {
+        _eventTime = msg->propertyExists(Event::EVENTTIME) ? msg->getLongProperty(Event::EVENTTIME)
+                                                           : msg->getCMSTimestamp();
+        _status = msg->propertyExists(Event::STATUS) ? msg->getStringProperty(Event::STATUS) : std::string();
+        _topic = msg->propertyExists(Event::TOPIC) ? msg->getStringProperty(Event::TOPIC) : std::string();
+        _pubTime = msg->propertyExists(Event::PUBTIME) ? msg->getLongProperty(Event::PUBTIME) : 0;
+        _runId = msg->propertyExists(Event::RUNID) ? msg->getStringProperty(Event::RUNID) : std::string();
+    }
+
+    static char const* skipWhitespace(char const* pos, char const* end) {
+        while ((pos < end) && ((*pos == ' ') || (*pos == '\t') || (*pos == '\n') || (*pos == '\r')))
+            pos++;
+        return pos;
+    }
+
+    // the characters of a string without escapes, which pos is at the
+    // opening quote of; pos is left after its closing quote
+    static bool scanString(char const*& pos, char const* end, char const*& begin, char const*& stop) {
+        pos = skipWhitespace(pos, end);
+        if ((pos >= end) || (*pos != '"'))
+            return false;
+        begin = pos + 1;
+        stop = JSONScanner::findQuoteOrEscape(begin, end);
+        if ((stop >= end) || (*stop != '"'))
+            return false;
+        pos = stop + 1;
+        return true;
+    }
+
+    static bool expect(char const*& pos, char const* end, char c) {
+        pos = skipWhitespace(pos, end);
+        if ((pos >= end) || (*pos != c))
+            return false;
+        pos++;
+        return true;
+    }
+
+    // the fast path of unmarshall(), for a body with one value of the
+    // right type for each field, and no escapes; false for any other body
+    static bool parsePayload(char const* pos, char const* end, Types& values) {
+        unsigned long long found = 0;
+        if (!expect(pos, end, '{'))
+            return false;
+        pos = skipWhitespace(pos, end);
+        if ((pos < end) && (*pos == '}')) {
+            pos++;
+        } else {
+            for (;;) {
+                char const* name;
+                char const* nameEnd;
+                char const* tag;
+                char const* tagEnd;
+                char const* value;
+                char const* valueEnd;
+                if (!scanString(pos, end, name, nameEnd) || !expect(pos, end, ':') || !expect(pos, end, '{') ||
+                    !scanString(pos, end, tag, tagEnd) || !expect(pos, end, ':') ||
+                    !scanString(pos, end, value, valueEnd) || !expect(pos, end, '}'))
+                    return false;
+                if (!Fields::parse(name, nameEnd - name, tag, tagEnd - tag, value, valueEnd, values, found))
+                    return false;
+                pos = skipWhitespace(pos, end);
+                if ((pos < end) && (*pos == ',')) {
+                    pos++;
+                    continue;
+                }
+                if (!expect(pos, end, '}'))
+                    return false;
+                break;
+            }
+        }
+        return (skipWhitespace(pos, end) == end) && (found == Fields::payloadMask());
+    }
+};
+
+}
+}
+}
+
+#endif /*end LSST_CTRL_EVENTS_TYPEDEVENT_H*/
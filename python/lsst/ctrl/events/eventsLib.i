@@ -40,6 +40,7 @@ Access to the lsst::ctrl::events classes
 %{
 #include "lsst/daf/base.h"
 #include "lsst/ctrl/events/Host.h"
+#include "lsst/ctrl/events/HostTable.h"
 #include "lsst/ctrl/events/LocationId.h"
 #include "lsst/ctrl/events/Event.h"
 #include "lsst/ctrl/events/StatusEvent.h"
@@ -49,10 +50,24 @@ Access to the lsst::ctrl::events classes
 #include "lsst/ctrl/events/Transmitter.h"
 #include "lsst/ctrl/events/EventTransmitter.h"
 #include "lsst/ctrl/events/EventEnqueuer.h"
+#include "lsst/ctrl/events/EventBatch.h"
 #include "lsst/ctrl/events/Receiver.h"
 #include "lsst/ctrl/events/EventReceiver.h"
 #include "lsst/ctrl/events/EventDequeuer.h"
 #include "lsst/ctrl/events/EventSystem.h"
+#include "lsst/ctrl/events/EventEncodings.h"
+#include "lsst/ctrl/events/JSONReader.h"
+#include "lsst/ctrl/events/JSONScanner.h"
+#include "lsst/ctrl/events/NumberFormat.h"
+#include "lsst/ctrl/events/JSONWriter.h"
+#include "lsst/ctrl/events/BinaryReader.h"
+#include "lsst/ctrl/events/BinaryWriter.h"
+#include "lsst/ctrl/events/EventSchema.h"
+#include "lsst/ctrl/events/SchemaRegistry.h"
+#include "lsst/ctrl/events/SchemaReader.h"
+#include "lsst/ctrl/events/SchemaWriter.h"
+#include "lsst/ctrl/events/PayloadCompressor.h"
+#include "lsst/ctrl/events/NameEncoder.h"
 
 %}
 
@@ -63,6 +78,7 @@ Access to the lsst::ctrl::events classes
 %shared_ptr(lsst::ctrl::events::StatusEvent)
 %shared_ptr(lsst::ctrl::events::CommandEvent)
 %shared_ptr(lsst::ctrl::events::LogEvent)
+%shared_ptr(lsst::ctrl::events::EventBatch)
 
 
 %import "lsst/daf/base/baseLib.i"
@@ -78,12 +94,36 @@ Access to the lsst::ctrl::events classes
 }
 
 %include "lsst/ctrl/events/Host.h"
+%ignore lsst::ctrl::events::HostTable::lookup;
+%include "lsst/ctrl/events/HostTable.h"
 %include "lsst/ctrl/events/LocationId.h"
+%ignore lsst::ctrl::events::EventSchema::read;
+%ignore lsst::ctrl::events::EventSchema::write;
+%include "lsst/ctrl/events/EventSchema.h"
+%include "lsst/ctrl/events/SchemaRegistry.h"
+
+%ignore lsst::ctrl::events::SchemaWriter::write(PropertySet const&, std::string&);
+%include "lsst/ctrl/events/SchemaWriter.h"
+
+%ignore lsst::ctrl::events::SchemaReader::read(unsigned char const*, size_t, PropertySet&);
+%include "lsst/ctrl/events/SchemaReader.h"
+
+%ignore lsst::ctrl::events::PayloadCompressor::compress;
+%ignore lsst::ctrl::events::PayloadCompressor::deflate(unsigned char const*, size_t, std::string&);
+%ignore lsst::ctrl::events::PayloadCompressor::inflate(unsigned char const*, size_t, std::string&);
+%include "lsst/ctrl/events/PayloadCompressor.h"
+
+%ignore lsst::ctrl::events::Event::marshallPayload;
+%ignore lsst::ctrl::events::Event::getPropertySet() const;
+%ignore lsst::ctrl::events::Event::getCustomPropertySet() const;
+%ignore lsst::ctrl::events::Event::copyPropertySet;
+%ignore lsst::ctrl::events::Event::copyCustomPropertySet;
 %include "lsst/ctrl/events/Event.h"
 %include "lsst/ctrl/events/StatusEvent.h"
 %include "lsst/ctrl/events/CommandEvent.h"
 %include "lsst/ctrl/events/LogEvent.h"
 %include "lsst/ctrl/events/EventTypes.h"
+%include "lsst/ctrl/events/EventEncodings.h"
 %include "lsst/ctrl/events/Transmitter.h"
 %include "lsst/ctrl/events/EventTransmitter.h"
 %include "lsst/ctrl/events/EventEnqueuer.h"
@@ -93,11 +133,66 @@ Access to the lsst::ctrl::events classes
 %newobject lsst::ctrl::events::EventReceiver::receiveStatusEvent;
 %newobject lsst::ctrl::events::EventReceiver::receiveCommandEvent;
 %newobject lsst::ctrl::events::EventReceiver::receiveLogEvent;
+%include "lsst/ctrl/events/EventBatch.h"
 %include "lsst/ctrl/events/Receiver.h"
 %include "lsst/ctrl/events/EventReceiver.h"
 %include "lsst/ctrl/events/EventDequeuer.h"
 %include "lsst/ctrl/events/EventSystem.h"
 
+%ignore lsst::ctrl::events::JSONWriter::write(PropertySet const&, std::string&, bool);
+%ignore lsst::ctrl::events::JSONWriter::write(PropertySet const&, std::string&);
+%ignore lsst::ctrl::events::JSONWriter::write(PropertySet const&, NameEncoder&, std::string&, bool);
+%ignore lsst::ctrl::events::JSONWriter::write(PropertySet const&, NameEncoder&, std::string&);
+%include "lsst/ctrl/events/JSONWriter.h"
+
+%ignore lsst::ctrl::events::JSONReader::read(char const*, size_t, PropertySet&);
+%ignore lsst::ctrl::events::JSONReader::read(char const*, size_t, std::vector<std::string> const*, PropertySet&);
+%include "lsst/ctrl/events/JSONReader.h"
+
+%ignore lsst::ctrl::events::JSONScanner::findQuoteOrEscape;
+%ignore lsst::ctrl::events::JSONScanner::parseInteger;
+%ignore lsst::ctrl::events::JSONScanner::parseDouble;
+%include "lsst/ctrl/events/JSONScanner.h"
+
+%ignore lsst::ctrl::events::NumberFormat::format;
+%ignore lsst::ctrl::events::NumberFormat::parse;
+%include "lsst/ctrl/events/NumberFormat.h"
+
+%ignore lsst::ctrl::events::BinaryWriter::write(PropertySet const&, std::string&);
+%ignore lsst::ctrl::events::BinaryWriter::writeVarint;
+%ignore lsst::ctrl::events::BinaryWriter::writeZigzag;
+%ignore lsst::ctrl::events::BinaryWriter::writeString;
+%ignore lsst::ctrl::events::BinaryWriter::writeFixed;
+%ignore lsst::ctrl::events::BinaryWriter::writeFixedArray;
+%ignore lsst::ctrl::events::BinaryWriter::writeValues;
+%ignore lsst::ctrl::events::BinaryWriter::tagOf;
+%include "lsst/ctrl/events/BinaryWriter.h"
+
+%ignore lsst::ctrl::events::BinaryReader::read(unsigned char const*, size_t, PropertySet&);
+%ignore lsst::ctrl::events::BinaryReader::BinaryReader;
+%ignore lsst::ctrl::events::BinaryReader::readValues;
+%ignore lsst::ctrl::events::BinaryReader::readPropertySet;
+%ignore lsst::ctrl::events::BinaryReader::readByte;
+%ignore lsst::ctrl::events::BinaryReader::readVarint;
+%ignore lsst::ctrl::events::BinaryReader::readZigzag;
+%ignore lsst::ctrl::events::BinaryReader::readFixed;
+%ignore lsst::ctrl::events::BinaryReader::readFixedArray;
+%ignore lsst::ctrl::events::BinaryReader::readString;
+%ignore lsst::ctrl::events::BinaryReader::finish;
+%ignore lsst::ctrl::events::BinaryReader::error;
+%include "lsst/ctrl/events/BinaryReader.h"
+
+// the PropertySets an Event shares with C++ callers are copied, once, for
+// Python, which cannot be kept from changing them
+%extend lsst::ctrl::events::Event {
+    PTR(lsst::daf::base::PropertySet) getPropertySet() {
+        return self->copyPropertySet();
+    }
+    PTR(lsst::daf::base::PropertySet) getCustomPropertySet() {
+        return self->copyCustomPropertySet();
+    }
+}
+
 %extend lsst::ctrl::events::EventReceiver {
     PTR(lsst::ctrl::events::StatusEvent) receiveStatusEvent() {
         PTR(lsst::ctrl::events::Event) ev = self->receiveEvent();
@@ -0,0 +1,250 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file BinaryReader.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Decoder of binary event bodies into PropertySets
+ *
+ */
+
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include "boost/cstdint.hpp"
+
+#include "lsst/ctrl/events/BinaryReader.h"
+#include "lsst/ctrl/events/BinaryWriter.h"
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+namespace dafBase = lsst::daf::base;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+namespace {
+
+bool isLittleEndian() {
+    boost::uint16_t value = 1;
+    unsigned char first;
+    memcpy(&first, &value, 1);
+    return first == 1;
+}
+
+}
+
+PTR(PropertySet) BinaryReader::read(std::string const& data) {
+    PTR(PropertySet) psp(new PropertySet);
+    read(reinterpret_cast<unsigned char const*>(data.data()), data.size(), *psp);
+    return psp;
+}
+
+void BinaryReader::read(unsigned char const* data, size_t length, PropertySet& ps) {
+    BinaryReader reader(data, length);
+
+    if (reader.readByte() != BinaryWriter::VERSION)
+        reader.error("unsupported binary encoding version");
+    reader.readPropertySet(ps);
+    reader.finish();
+}
+
+BinaryReader::BinaryReader(unsigned char const* data, size_t length) :
+    _begin(data),
+    _pos(data),
+    _end(data + length)
+    {}
+
+/** read the entries of a PropertySet into ps
+  */
+void BinaryReader::readPropertySet(PropertySet& ps) {
+    unsigned long long count = readVarint();
+
+    std::string name;
+    for (unsigned long long i = 0; i < count; i++) {
+        readString(name);
+        unsigned char tag = readByte();
+        readValues(tag, name, ps);
+    }
+}
+
+void BinaryReader::readValues(unsigned char tag, std::string const& name, PropertySet& ps) {
+    unsigned long long count = readVarint();
+
+    // every value takes at least one byte
+    if (count > static_cast<unsigned long long>(_end - _pos))
+        error("value count of "+name+" exceeds data");
+
+    switch (tag) {
+        case BinaryWriter::BOOL: {
+            std::vector<bool> vec(count);
+            for (size_t i = 0; i < count; i++)
+                vec[i] = (readByte() != 0);
+            ps.add(name, vec);
+            break;
+        }
+        case BinaryWriter::INT: {
+            std::vector<int> vec(count);
+            for (size_t i = 0; i < count; i++)
+                vec[i] = readZigzag();
+            ps.add(name, vec);
+            break;
+        }
+        case BinaryWriter::LONG: {
+            std::vector<long> vec(count);
+            for (size_t i = 0; i < count; i++)
+                vec[i] = readZigzag();
+            ps.add(name, vec);
+            break;
+        }
+        case BinaryWriter::LONGLONG: {
+            std::vector<long long> vec(count);
+            for (size_t i = 0; i < count; i++)
+                vec[i] = readZigzag();
+            ps.add(name, vec);
+            break;
+        }
+        case BinaryWriter::FLOAT: {
+            std::vector<float> vec(count);
+            if (count > 0)
+                readFixedArray(&vec[0], count, sizeof(float));
+            ps.add(name, vec);
+            break;
+        }
+        case BinaryWriter::DOUBLE: {
+            std::vector<double> vec(count);
+            if (count > 0)
+                readFixedArray(&vec[0], count, sizeof(double));
+            ps.add(name, vec);
+            break;
+        }
+        case BinaryWriter::STRING: {
+            std::vector<std::string> vec(count);
+            for (size_t i = 0; i < count; i++)
+                readString(vec[i]);
+            ps.add(name, vec);
+            break;
+        }
+        case BinaryWriter::DATETIME: {
+            std::vector<dafBase::DateTime> vec;
+            vec.reserve(count);
+            for (size_t i = 0; i < count; i++)
+                vec.push_back(dafBase::DateTime(readZigzag()));
+            ps.add(name, vec);
+            break;
+        }
+        case BinaryWriter::PROPERTYSET: {
+            for (size_t i = 0; i < count; i++) {
+                PTR(PropertySet) psp(new PropertySet);
+                readPropertySet(*psp);
+                ps.add(name, psp);
+            }
+            break;
+        }
+        default:
+            error("unknown type tag for "+name);
+    }
+}
+
+unsigned char BinaryReader::readByte() {
+    if (_pos >= _end)
+        error("unexpected end of data");
+    return *_pos++;
+}
+
+unsigned long long BinaryReader::readVarint() {
+    unsigned long long value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        unsigned char b = readByte();
+        value |= static_cast<unsigned long long>(b & 0x7f) << shift;
+        if ((b & 0x80) == 0)
+            return value;
+    }
+    error("varint too long");
+    return 0;
+}
+
+long long BinaryReader::readZigzag() {
+    unsigned long long value = readVarint();
+    return static_cast<long long>(value >> 1) ^ -static_cast<long long>(value & 1);
+}
+
+void BinaryReader::readString(std::string& out) {
+    unsigned long long length = readVarint();
+    if (length > static_cast<unsigned long long>(_end - _pos))
+        error("string length exceeds data");
+    out.assign(reinterpret_cast<char const*>(_pos), length);
+    _pos += length;
+}
+
+/** read a little-endian value of size bytes
+  */
+unsigned long long BinaryReader::readFixed(int size) {
+    if (_end - _pos < size)
+        error("unexpected end of data");
+    unsigned long long value = 0;
+    for (int i = 0; i < size; i++) {
+        value |= static_cast<unsigned long long>(_pos[i]) << (8 * i);
+    }
+    _pos += size;
+    return value;
+}
+
+/** read a block of count little-endian values of size bytes each into
+  * values, in host order
+  */
+void BinaryReader::readFixedArray(void* values, size_t count, int size) {
+    if (count > static_cast<size_t>(_end - _pos) / size)
+        error("unexpected end of data");
+    unsigned char* p = static_cast<unsigned char*>(values);
+    if (isLittleEndian()) {
+        memcpy(p, _pos, count * size);
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            for (int j = 0; j < size; j++) {
+                p[i * size + j] = _pos[i * size + size - 1 - j];
+            }
+        }
+    }
+    _pos += count * size;
+}
+
+void BinaryReader::finish() {
+    if (_pos != _end)
+        error("unexpected data after end of event");
+}
+
+void BinaryReader::error(std::string const& reason) {
+    std::ostringstream msg;
+    msg << "Couldn't unmarshall event: " << reason << " at offset " << (_pos - _begin);
+    throw LSST_EXCEPT(pexExceptions::RuntimeError, msg.str());
+}
+
+}}}
@@ -0,0 +1,235 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file BinaryWriter.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Writer of PropertySets into the binary event body encoding
+ *
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "boost/cstdint.hpp"
+
+#include "lsst/ctrl/events/BinaryWriter.h"
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+namespace dafBase = lsst::daf::base;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+namespace {
+
+bool isLittleEndian() {
+    boost::uint16_t value = 1;
+    unsigned char first;
+    memcpy(&first, &value, 1);
+    return first == 1;
+}
+
+}
+
+std::string BinaryWriter::write(PropertySet const& ps) {
+    std::string out;
+    write(ps, out);
+    return out;
+}
+
+void BinaryWriter::write(PropertySet const& ps, std::string& out) {
+    out.clear();
+    out.push_back(VERSION);
+    writePropertySet(ps, out);
+}
+
+void BinaryWriter::writeVarint(unsigned long long value, std::string& out) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void BinaryWriter::writeZigzag(long long value, std::string& out) {
+    writeVarint((static_cast<unsigned long long>(value) << 1) ^ static_cast<unsigned long long>(value >> 63), out);
+}
+
+void BinaryWriter::writeFixed(unsigned long long value, int size, std::string& out) {
+    for (int i = 0; i < size; i++) {
+        out.push_back(static_cast<char>(value & 0xff));
+        value >>= 8;
+    }
+}
+
+/** write count values of size bytes each, held in host order at values,
+  * as one block of little-endian values
+  */
+void BinaryWriter::writeFixedArray(void const* values, size_t count, int size, std::string& out) {
+    char const* p = static_cast<char const*>(values);
+    if (isLittleEndian()) {
+        out.append(p, count * size);
+        return;
+    }
+    size_t start = out.size();
+    out.resize(start + count * size);
+    for (size_t i = 0; i < count; i++) {
+        for (int j = 0; j < size; j++) {
+            out[start + i * size + j] = p[i * size + size - 1 - j];
+        }
+    }
+}
+
+void BinaryWriter::writeString(std::string const& value, std::string& out) {
+    writeVarint(value.size(), out);
+    out.append(value);
+}
+
+/** private method to write the entries of a PropertySet; nested
+  * PropertySets are written recursively.
+  */
+void BinaryWriter::writePropertySet(PropertySet const& ps, std::string& out) {
+    std::vector<std::string> names = ps.names(true);
+
+    writeVarint(names.size(), out);
+    for (std::string const& name : names) {
+        unsigned char tag = tagOf(ps, name);
+        writeString(name, out);
+        out.push_back(tag);
+        writeValues(ps, name, tag, out);
+    }
+}
+
+unsigned char BinaryWriter::tagOf(PropertySet const& ps, std::string const& name) {
+    std::type_info const& t = ps.typeOf(name);
+    if (t == typeid(double)) {
+        return DOUBLE;
+    } else if (t == typeid(int)) {
+        return INT;
+    } else if (t == typeid(std::string)) {
+        return STRING;
+    } else if (t == typeid(long long)) {
+        return LONGLONG;
+    } else if (t == typeid(long)) {
+        return LONG;
+    } else if (t == typeid(float)) {
+        return FLOAT;
+    } else if (t == typeid(bool)) {
+        return BOOL;
+    } else if (t == typeid(dafBase::DateTime)) {
+        return DATETIME;
+    } else if (t == typeid(PTR(PropertySet))) {
+        return PROPERTYSET;
+    }
+    std::string msg("Couldn't marshall "+name);
+    throw LSST_EXCEPT(pexExceptions::RuntimeError, msg);
+}
+
+void BinaryWriter::writeValues(PropertySet const& ps, std::string const& name, unsigned char tag, std::string& out) {
+    switch (tag) {
+        case BOOL: {
+            std::vector<bool> vec = ps.getArray<bool>(name);
+            writeVarint(vec.size(), out);
+            for (bool value : vec) {
+                out.push_back(value ? 1 : 0);
+            }
+            break;
+        }
+        case INT: {
+            std::vector<int> vec = ps.getArray<int>(name);
+            writeVarint(vec.size(), out);
+            for (int value : vec) {
+                writeZigzag(value, out);
+            }
+            break;
+        }
+        case LONG: {
+            std::vector<long> vec = ps.getArray<long>(name);
+            writeVarint(vec.size(), out);
+            for (long value : vec) {
+                writeZigzag(value, out);
+            }
+            break;
+        }
+        case LONGLONG: {
+            std::vector<long long> vec = ps.getArray<long long>(name);
+            writeVarint(vec.size(), out);
+            for (long long value : vec) {
+                writeZigzag(value, out);
+            }
+            break;
+        }
+        case FLOAT: {
+            std::vector<float> vec = ps.getArray<float>(name);
+            writeVarint(vec.size(), out);
+            if (!vec.empty())
+                writeFixedArray(&vec[0], vec.size(), sizeof(float), out);
+            break;
+        }
+        case DOUBLE: {
+            std::vector<double> vec = ps.getArray<double>(name);
+            writeVarint(vec.size(), out);
+            if (!vec.empty())
+                writeFixedArray(&vec[0], vec.size(), sizeof(double), out);
+            break;
+        }
+        case STRING: {
+            std::vector<std::string> vec = ps.getArray<std::string>(name);
+            writeVarint(vec.size(), out);
+            for (std::string const& value : vec) {
+                writeString(value, out);
+            }
+            break;
+        }
+        case DATETIME: {
+            std::vector<dafBase::DateTime> vec = ps.getArray<dafBase::DateTime>(name);
+            writeVarint(vec.size(), out);
+            for (dafBase::DateTime const& value : vec) {
+                writeZigzag(value.nsecs(), out);
+            }
+            break;
+        }
+        case PROPERTYSET: {
+            std::vector<PTR(PropertySet)> vec = ps.getArray<PTR(PropertySet)>(name);
+            writeVarint(vec.size(), out);
+            for (PTR(PropertySet) const& value : vec) {
+                writePropertySet(*value, out);
+            }
+            break;
+        }
+        default: {
+            std::string msg("Couldn't marshall "+name);
+            throw LSST_EXCEPT(pexExceptions::RuntimeError, msg);
+        }
+    }
+}
+
+}}}
@@ -0,0 +1,203 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file ChunkReader.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Reassembly of event bodies sent in chunks
+ *
+ */
+
+#include <algorithm>
+#include <sstream>
+
+#include "boost/scoped_array.hpp"
+
+#include "lsst/ctrl/events/ChunkReader.h"
+#include "lsst/ctrl/events/ChunkWriter.h"
+#include "lsst/ctrl/events/Event.h"
+
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+ChunkReader::ChunkReader() : _bufferSize(DEFAULT_BUFFER_SIZE), _timeout(DEFAULT_TIMEOUT), _buffered(0) {
+}
+
+cms::Message* ChunkReader::read(cms::Message const* message, long long now, cms::Session* session) {
+    cms::BytesMessage const* bytesMessage = dynamic_cast<cms::BytesMessage const*>(message);
+    if (bytesMessage == NULL)
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "Event chunk is not a BytesMessage");
+
+    std::string chunkSet = message->getStringProperty(Event::CHUNKSET);
+    int chunk = message->getIntProperty(Event::CHUNK);
+    int count = message->getIntProperty(Event::CHUNKS);
+    if ((count < 1) || (chunk < 0) || (chunk >= count)) {
+        std::ostringstream msg;
+        msg << "Invalid chunk " << chunk << " of " << count << " in set \"" << chunkSet << "\"";
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, msg.str());
+    }
+
+    expire(now);
+    if (isDropped(chunkSet))
+        return NULL;
+
+    std::map<std::string, ChunkSet>::iterator it = _sets.find(chunkSet);
+    if (it == _sets.end()) {
+        // the count is checked before room is made for that many chunks
+        if (static_cast<size_t>(count) > getMaxChunks()) {
+            remember(chunkSet);
+            return NULL;
+        }
+        ChunkSet& created = _sets[chunkSet];
+        created.chunks.resize(count);
+        created.received = 0;
+        created.started = now;
+        it = _sets.find(chunkSet);
+    } else if (it->second.chunks.size() != static_cast<size_t>(count)) {
+        std::ostringstream msg;
+        msg << "Chunk " << chunk << " of set \"" << chunkSet << "\" has " << count << " chunks, not "
+            << it->second.chunks.size();
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, msg.str());
+    }
+    if (!it->second.chunks[chunk].empty())
+        return NULL;
+
+    // make room by dropping the oldest sets; a set which can not fit is
+    // dropped itself
+    size_t length = bytesMessage->getBodyLength();
+    if (length > _bufferSize) {
+        drop(it);
+        return NULL;
+    }
+    while (_buffered + length > _bufferSize) {
+        std::map<std::string, ChunkSet>::iterator oldest = _sets.begin();
+        for (std::map<std::string, ChunkSet>::iterator i = _sets.begin(); i != _sets.end(); ++i) {
+            if ((i->second.started < oldest->second.started) || (oldest == it))
+                oldest = i;
+        }
+        if (oldest == it) {
+            drop(it);
+            return NULL;
+        }
+        drop(oldest);
+    }
+
+    ChunkSet& set = it->second;
+    boost::scoped_array<unsigned char> body(bytesMessage->getBodyBytes());
+    set.chunks[chunk].assign(reinterpret_cast<char const*>(body.get()), length);
+    set.received++;
+    _buffered += length;
+    if (set.received < count)
+        return NULL;
+
+    size_t total = 0;
+    for (std::string const& part : set.chunks)
+        total += part.size();
+    std::string whole;
+    whole.reserve(total);
+    for (std::string const& part : set.chunks)
+        whole.append(part);
+    _buffered -= total;
+    _sets.erase(it);
+
+    cms::BytesMessage* result = session->createBytesMessage(reinterpret_cast<unsigned char const*>(whole.data()),
+                                                            whole.size());
+    ChunkWriter::copyProperties(message, result);
+    return result;
+}
+
+void ChunkReader::expire(long long now) {
+    for (std::map<std::string, ChunkSet>::iterator it = _sets.begin(); it != _sets.end(); ) {
+        std::map<std::string, ChunkSet>::iterator next = it;
+        ++next;
+        if (now - it->second.started > _timeout)
+            drop(it);
+        it = next;
+    }
+}
+
+size_t ChunkReader::getMaxChunks() const {
+    return std::max(_bufferSize / ChunkWriter::MIN_CHUNK_SIZE, static_cast<size_t>(1));
+}
+
+/** private method to drop a set, and ignore the rest of its chunks
+  */
+void ChunkReader::drop(std::map<std::string, ChunkSet>::iterator it) {
+    for (std::string const& part : it->second.chunks)
+        _buffered -= part.size();
+    remember(it->first);
+    _sets.erase(it);
+}
+
+/** private method to remember a dropped set, so the rest of its chunks are
+  * ignored
+  */
+void ChunkReader::remember(std::string const& chunkSet) {
+    if (_dropped.size() >= MAX_DROPPED)
+        _dropped.pop_front();
+    _dropped.push_back(chunkSet);
+}
+
+/** private method to check whether a set was dropped
+  */
+bool ChunkReader::isDropped(std::string const& chunkSet) const {
+    return std::find(_dropped.begin(), _dropped.end(), chunkSet) != _dropped.end();
+}
+
+void ChunkReader::setBufferSize(size_t size) {
+    _bufferSize = size;
+}
+
+size_t ChunkReader::getBufferSize() const {
+    return _bufferSize;
+}
+
+void ChunkReader::setTimeout(long timeout) {
+    if (timeout <= 0)
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "Chunk timeout must be positive");
+    _timeout = timeout;
+}
+
+long ChunkReader::getTimeout() const {
+    return _timeout;
+}
+
+size_t ChunkReader::getBufferedSize() const {
+    return _buffered;
+}
+
+void ChunkReader::reset() {
+    _sets.clear();
+    _dropped.clear();
+    _buffered = 0;
+}
+
+}}}
@@ -0,0 +1,124 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file ChunkWriter.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Splitting of large event bodies into chunks
+ *
+ */
+
+#include <sstream>
+
+#include "lsst/ctrl/events/ChunkWriter.h"
+#include "lsst/ctrl/events/Event.h"
+#include "lsst/ctrl/events/LocationId.h"
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+namespace dafBase = lsst::daf::base;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+ChunkWriter::ChunkWriter() : _chunkSize(0), _sets(0) {
+    // unique to this process, and to this start of it
+    LocationId location;
+    std::ostringstream id;
+    id << location.getHostName() << "/" << location.getProcessID() << "/" << location.getLocalID() << "/"
+       << dafBase::DateTime::now().nsecs();
+    _id = id.str();
+}
+
+void ChunkWriter::setChunkSize(size_t size) {
+    if ((size != 0) && (size < MIN_CHUNK_SIZE)) {
+        std::ostringstream msg;
+        msg << "Chunk size " << size << " is below the minimum of " << MIN_CHUNK_SIZE;
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, msg.str());
+    }
+    _chunkSize = size;
+}
+
+size_t ChunkWriter::getChunkSize() const {
+    return _chunkSize;
+}
+
+int ChunkWriter::getChunkCount(size_t length) const {
+    if ((_chunkSize == 0) || (length <= _chunkSize))
+        return 1;
+    return (length + _chunkSize - 1) / _chunkSize;
+}
+
+std::string ChunkWriter::nextChunkSet() {
+    std::ostringstream chunkSet;
+    chunkSet << _id << ":" << _sets++;
+    return chunkSet.str();
+}
+
+void ChunkWriter::copyProperties(cms::Message const* from, cms::Message* to) {
+    std::vector<std::string> names = from->getPropertyNames();
+    for (std::string const& name : names) {
+        // these describe a single chunk
+        if ((name == Event::CHUNKSET) || (name == Event::CHUNK) || (name == Event::CHUNKS))
+            continue;
+        switch (from->getPropertyValueType(name)) {
+            case cms::Message::BOOLEAN_TYPE:
+                to->setBooleanProperty(name, from->getBooleanProperty(name));
+                break;
+            case cms::Message::BYTE_TYPE:
+            case cms::Message::CHAR_TYPE:
+                to->setByteProperty(name, from->getByteProperty(name));
+                break;
+            case cms::Message::SHORT_TYPE:
+                to->setShortProperty(name, from->getShortProperty(name));
+                break;
+            case cms::Message::INTEGER_TYPE:
+                to->setIntProperty(name, from->getIntProperty(name));
+                break;
+            case cms::Message::LONG_TYPE:
+                to->setLongProperty(name, from->getLongProperty(name));
+                break;
+            case cms::Message::DOUBLE_TYPE:
+                to->setDoubleProperty(name, from->getDoubleProperty(name));
+                break;
+            case cms::Message::FLOAT_TYPE:
+                to->setFloatProperty(name, from->getFloatProperty(name));
+                break;
+            case cms::Message::STRING_TYPE:
+                to->setStringProperty(name, from->getStringProperty(name));
+                break;
+            default:
+                // events never set the other types
+                break;
+        }
+    }
+    to->setCMSTimestamp(from->getCMSTimestamp());
+}
+
+}}}
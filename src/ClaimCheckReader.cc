@@ -0,0 +1,159 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file ClaimCheckReader.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Removal of claim check files under a retention policy
+ *
+ */
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "lsst/ctrl/events/ClaimCheckReader.h"
+#include "lsst/ctrl/events/ClaimCheckWriter.h"
+
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+namespace {
+
+/* true if name ends with suffix */
+bool endsWith(std::string const& name, std::string const& suffix) {
+    return (name.size() > suffix.size()) && (name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0);
+}
+
+/* path with all symbolic links resolved, or an empty string if it does
+ * not exist */
+std::string resolve(std::string const& path) {
+    char resolved[PATH_MAX];
+    if (realpath(path.c_str(), resolved) == NULL)
+        return std::string();
+    return resolved;
+}
+
+}
+
+ClaimCheckReader::ClaimCheckReader() : _retention(DEFAULT_RETENTION), _removeOnRead(false), _lastSweep(0) {
+}
+
+void ClaimCheckReader::addDirectory(std::string const& directory) {
+    struct stat status;
+    std::string resolved = resolve(directory);
+    if (resolved.empty() || (stat(resolved.c_str(), &status) != 0) || !S_ISDIR(status.st_mode))
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "Claim check directory \""+directory+"\" is not a directory");
+    _directories.insert(resolved);
+}
+
+std::vector<std::string> ClaimCheckReader::getDirectories() const {
+    return std::vector<std::string>(_directories.begin(), _directories.end());
+}
+
+bool ClaimCheckReader::accepts(std::string const& path) const {
+    if (!endsWith(path, ClaimCheckWriter::SUFFIX))
+        return false;
+
+    // the file itself may be a link, so the resolved path is checked too
+    std::string resolved = resolve(path);
+    if (!endsWith(resolved, ClaimCheckWriter::SUFFIX))
+        return false;
+    std::string::size_type slash = resolved.rfind('/');
+    std::string directory = (slash == 0) ? "/" : resolved.substr(0, slash);
+    return _directories.find(directory) != _directories.end();
+}
+
+bool ClaimCheckReader::read(Event& event, std::string const& path, long long now) {
+    if (!accepts(path))
+        return false;
+
+    if (now - _lastSweep >= _retention / 10)
+        sweep(now);
+    return true;
+}
+
+void ClaimCheckReader::release(Event& event, std::string const& path) {
+    if (!_removeOnRead)
+        return;
+    event.getCustomPropertySet();
+    unlink(path.c_str());
+}
+
+void ClaimCheckReader::sweep(long long now) {
+    _lastSweep = now;
+    std::string const temporary = ClaimCheckWriter::SUFFIX + ".tmp";
+
+    for (std::string const& directory : _directories) {
+        DIR* dir = opendir(directory.c_str());
+        if (dir == NULL)
+            continue;
+        for (struct dirent* entry = readdir(dir); entry != NULL; entry = readdir(dir)) {
+            std::string name(entry->d_name);
+            // partly written files are left by transmitters which failed
+            if (!endsWith(name, ClaimCheckWriter::SUFFIX) && !endsWith(name, temporary))
+                continue;
+
+            std::string path = directory + "/" + name;
+            struct stat status;
+            if (stat(path.c_str(), &status) != 0)
+                continue;
+            long long written = static_cast<long long>(status.st_mtime) * 1000;
+            if (now - written > _retention)
+                unlink(path.c_str());
+        }
+        closedir(dir);
+    }
+}
+
+void ClaimCheckReader::setRetention(long retention) {
+    if (retention <= 0)
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "Claim check retention must be positive");
+    _retention = retention;
+}
+
+long ClaimCheckReader::getRetention() const {
+    return _retention;
+}
+
+void ClaimCheckReader::setRemoveOnRead(bool remove) {
+    _removeOnRead = remove;
+}
+
+bool ClaimCheckReader::getRemoveOnRead() const {
+    return _removeOnRead;
+}
+
+}}}
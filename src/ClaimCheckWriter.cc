@@ -0,0 +1,127 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file ClaimCheckWriter.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Writing of large event bodies to files sent by reference
+ *
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "lsst/ctrl/events/ClaimCheckWriter.h"
+#include "lsst/ctrl/events/LocationId.h"
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+namespace dafBase = lsst::daf::base;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+const std::string ClaimCheckWriter::SUFFIX = ".claim";
+
+ClaimCheckWriter::ClaimCheckWriter() : _threshold(DEFAULT_THRESHOLD), _written(0) {
+    // unique to this process, and to this start of it
+    LocationId location;
+    std::ostringstream id;
+    id << location.getHostName() << "-" << location.getProcessID() << "-" << location.getLocalID() << "-"
+       << dafBase::DateTime::now().nsecs();
+    _id = id.str();
+}
+
+void ClaimCheckWriter::setDirectory(std::string const& directory) {
+    if (!directory.empty()) {
+        struct stat status;
+        if ((stat(directory.c_str(), &status) != 0) || !S_ISDIR(status.st_mode))
+            throw LSST_EXCEPT(pexExceptions::RuntimeError, "Claim check directory \""+directory+"\" is not a directory");
+    }
+    _directory = directory;
+}
+
+std::string const& ClaimCheckWriter::getDirectory() const {
+    return _directory;
+}
+
+void ClaimCheckWriter::setThreshold(size_t threshold) {
+    _threshold = threshold;
+}
+
+size_t ClaimCheckWriter::getThreshold() const {
+    return _threshold;
+}
+
+bool ClaimCheckWriter::isClaimed(size_t length) const {
+    return !_directory.empty() && (length >= _threshold);
+}
+
+std::string ClaimCheckWriter::write(std::string const& body) {
+    std::ostringstream name;
+    name << _directory << "/" << _id << "-" << _written++ << SUFFIX;
+    std::string path = name.str();
+    std::string temporary = path + ".tmp";
+
+    int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+    if (fd < 0)
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "Couldn't create claim check file "+temporary+": "+
+                          strerror(errno));
+
+    char const* data = body.data();
+    size_t remaining = body.size();
+    while (remaining > 0) {
+        ssize_t written = ::write(fd, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            std::string msg = "Couldn't write claim check file "+temporary+": "+strerror(errno);
+            close(fd);
+            unlink(temporary.c_str());
+            throw LSST_EXCEPT(pexExceptions::RuntimeError, msg);
+        }
+        data += written;
+        remaining -= written;
+    }
+
+    if ((close(fd) != 0) || (rename(temporary.c_str(), path.c_str()) != 0)) {
+        std::string msg = "Couldn't write claim check file "+path+": "+strerror(errno);
+        unlink(temporary.c_str());
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, msg);
+    }
+    return path;
+}
+
+}}}
@@ -31,6 +31,8 @@
  *
  */
 
+#include <utility>
+
 #include "lsst/ctrl/events/CommandEvent.h"
 #include "lsst/ctrl/events/EventTypes.h"
 
@@ -48,6 +50,9 @@ const std::string CommandEvent::DEST_HOSTNAME = "DEST_HOSTNAME";
 const std::string CommandEvent::DEST_PROCESSID = "DEST_PROCESSID";
 const std::string CommandEvent::DEST_LOCALID = "DEST_LOCALID";
 
+const std::string CommandEvent::ORIG_ID = "ORIG_ID";
+const std::string CommandEvent::DEST_ID = "DEST_ID";
+
 CommandEvent::CommandEvent() : Event() {
     _init();
 }
@@ -56,27 +61,16 @@ CommandEvent::CommandEvent() : Event() {
 /** private method to initialize the CommandEvent
   */
 void CommandEvent::_init() {
-    _keywords.insert(ORIG_HOSTNAME);
-    _keywords.insert(ORIG_PROCESSID);
-    _keywords.insert(ORIG_LOCALID);
-
-    _keywords.insert(DEST_HOSTNAME);
-    _keywords.insert(DEST_PROCESSID);
-    _keywords.insert(DEST_LOCALID);
+    _keywords.add(KeywordSet::COMMAND_KEYWORDS);
 }
 
-CommandEvent::CommandEvent(cms::TextMessage *msg) : Event(msg) {
+/**
+ * @brief Constructor to take a JMS Message and turn it into a CommandEvent;
+ *        the ORIG_* and DEST_* header properties have already been copied by
+ *        Event(msg), and are only marked as the keywords of this type
+ */
+CommandEvent::CommandEvent(cms::Message *msg) : Event(msg) {
     _init();
-
-
-    _psp->set(ORIG_HOSTNAME, (std::string)msg->getStringProperty(ORIG_HOSTNAME));
-    _psp->set(ORIG_PROCESSID, (int)msg->getIntProperty(ORIG_PROCESSID));
-    _psp->set(ORIG_LOCALID, (int)msg->getIntProperty(ORIG_LOCALID));
-
-    _psp->set(DEST_HOSTNAME, (std::string)msg->getStringProperty(DEST_HOSTNAME));
-    _psp->set(DEST_PROCESSID, (int)msg->getIntProperty(DEST_PROCESSID));
-    _psp->set(DEST_LOCALID, (int)msg->getIntProperty(DEST_LOCALID));
-
 }
 
 CommandEvent::CommandEvent(LocationId const&  originator, LocationId const& destination, CONST_PTR(PropertySet)& psp) : Event(*psp) {
@@ -103,6 +97,22 @@ CommandEvent::CommandEvent(std::string const& runId, LocationId const&  originat
     _constructor(originator, destination);
 }
 
+CommandEvent::CommandEvent(LocationId const& originator, LocationId const& destination, PTR(PropertySet)&& psp) : Event(std::move(psp)) {
+    _constructor(originator, destination);
+}
+
+CommandEvent::CommandEvent(LocationId const& originator, LocationId const& destination, PTR(PropertySet)&& psp, PropertySet const& filterable) : Event(std::move(psp), filterable) {
+    _constructor(originator, destination);
+}
+
+CommandEvent::CommandEvent(std::string const& runId, LocationId const& originator, LocationId const& destination, PTR(PropertySet)&& psp) : Event(runId, std::move(psp)) {
+    _constructor(originator, destination);
+}
+
+CommandEvent::CommandEvent(std::string const& runId, LocationId const& originator, LocationId const& destination, PTR(PropertySet)&& psp, PropertySet const& filterable) : Event(runId, std::move(psp), filterable) {
+    _constructor(originator, destination);
+}
+
 /** private method common to all constructors containing, originator, the 
   * originating location of this event, and destination, the destination
   * location for this event.
@@ -118,33 +128,28 @@ void CommandEvent::_constructor(LocationId const&  originator, LocationId const&
     _psp->set(DEST_PROCESSID, destination.getProcessID());
     _psp->set(DEST_LOCALID, destination.getLocalID());
 
-    _psp->set(TYPE, EventTypes::COMMAND);
-
-}
-
-void CommandEvent::populateHeader(cms::TextMessage* msg) const {
-    Event::populateHeader(msg);
-
-    msg->setStringProperty(ORIG_HOSTNAME, _psp->get<std::string>(ORIG_HOSTNAME));
-    msg->setIntProperty(ORIG_PROCESSID, _psp->get<int>(ORIG_PROCESSID));
-    msg->setIntProperty(ORIG_LOCALID, _psp->get<int>(ORIG_LOCALID));
+    _setType(EventTypes::COMMAND);
 
-    msg->setStringProperty(DEST_HOSTNAME, _psp->get<std::string>(DEST_HOSTNAME));
-    msg->setIntProperty(DEST_PROCESSID, _psp->get<int>(DEST_PROCESSID));
-    msg->setIntProperty(DEST_LOCALID, _psp->get<int>(DEST_LOCALID));
 }
 
 PTR(LocationId) CommandEvent::getOriginator() const { 
-    std::string hostname =  _psp->get<std::string>(ORIG_HOSTNAME);
-    int pid =  _psp->get<int>(ORIG_PROCESSID);
-    int local =  _psp->get<int>(ORIG_LOCALID);
+    CONST_PTR(PropertySet) psp = _properties();
+    // a location whose host code is shared by two hosts is left packed
+    if (psp->exists(ORIG_ID))
+        return PTR(LocationId)(new LocationId(psp->get<long long>(ORIG_ID)));
+    std::string hostname =  psp->get<std::string>(ORIG_HOSTNAME);
+    int pid =  psp->get<int>(ORIG_PROCESSID);
+    int local =  psp->get<int>(ORIG_LOCALID);
     return PTR(LocationId)(new LocationId(hostname, pid, local));
 }
 
 PTR(LocationId) CommandEvent::getDestination() const { 
-    std::string hostname = _psp->get<std::string>(DEST_HOSTNAME); 
-    int pid = _psp->get<int>(DEST_PROCESSID); 
-    int local = _psp->get<int>(DEST_LOCALID);
+    CONST_PTR(PropertySet) psp = _properties();
+    if (psp->exists(DEST_ID))
+        return PTR(LocationId)(new LocationId(psp->get<long long>(DEST_ID)));
+    std::string hostname = psp->get<std::string>(DEST_HOSTNAME); 
+    int pid = psp->get<int>(DEST_PROCESSID); 
+    int local = psp->get<int>(DEST_LOCALID);
     return PTR(LocationId)(new LocationId(hostname, pid, local));
 }
 
@@ -0,0 +1,92 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file DateFormat.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Thread safe conversion of event times to asctime style dates
+ *
+ */
+
+#include <cstring>
+#include <ctime>
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/ctrl/events/DateFormat.h"
+#include "lsst/ctrl/events/NumberFormat.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+namespace {
+
+char const DAYS[] = "SunMonTueWedThuFriSat";
+char const MONTHS[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+/* write value as two digits, with a leading zero or, if pad is ' ', a
+ * leading space */
+char* writeTwoDigits(int value, char pad, char* out) {
+    *out++ = (value < 10) ? pad : static_cast<char>('0' + value / 10);
+    *out++ = static_cast<char>('0' + value % 10);
+    return out;
+}
+
+}
+
+size_t DateFormat::format(long long nsecs, char* buf) {
+    // DateTime::gmtime fills in a struct tm of its own, as gmtime_r does
+    struct tm time = dafBase::DateTime(nsecs).gmtime();
+
+    // the fields of "%.3s %.3s%3d %.2d:%.2d:%.2d %d\n", as asctime writes them
+    char* out = buf;
+    memcpy(out, DAYS + 3 * (time.tm_wday % 7), 3);
+    out += 3;
+    *out++ = ' ';
+    memcpy(out, MONTHS + 3 * (time.tm_mon % 12), 3);
+    out += 3;
+    *out++ = ' ';
+    out = writeTwoDigits(time.tm_mday, ' ', out);
+    *out++ = ' ';
+    out = writeTwoDigits(time.tm_hour, '0', out);
+    *out++ = ':';
+    out = writeTwoDigits(time.tm_min, '0', out);
+    *out++ = ':';
+    out = writeTwoDigits(time.tm_sec, '0', out);
+    *out++ = ' ';
+    out += NumberFormat::format(time.tm_year + 1900LL, out);
+    *out++ = '\n';
+    return out - buf;
+}
+
+void DateFormat::format(long long nsecs, std::string& date) {
+    char buf[MAX_LENGTH];
+    date.assign(buf, format(nsecs, buf));
+}
+
+}}}
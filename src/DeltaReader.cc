@@ -0,0 +1,102 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file DeltaReader.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Rebuilding of StatusEvents sent as deltas
+ *
+ */
+
+#include "lsst/ctrl/events/DeltaReader.h"
+#include "lsst/ctrl/events/DeltaWriter.h"
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+DeltaReader::DeltaReader() : _clock(0) {
+}
+
+bool DeltaReader::read(Event& event, long long sequence, bool delta) {
+    std::string originator;
+    if (!DeltaWriter::getOriginator(event, originator))
+        return true;
+
+    std::map<std::string, State>::iterator it = _originators.find(originator);
+    if (delta) {
+        if ((it == _originators.end()) || (it->second.sequence + 1 != sequence)) {
+            // missed events; wait for the next keyframe
+            if (it != _originators.end())
+                _originators.erase(it);
+            return false;
+        }
+    } else if (it == _originators.end()) {
+        if (_originators.size() >= MAX_ORIGINATORS)
+            evict();
+        it = _originators.insert(std::make_pair(originator, State())).first;
+    }
+    State& state = it->second;
+    state.sequence = sequence;
+    state.lastUsed = ++_clock;
+
+    CONST_PTR(PropertySet) received = event.getCustomPropertySet();
+    if (!delta) {
+        state.properties = received->deepCopy();
+        return true;
+    }
+
+    // add the unchanged properties to the event, and the changed ones to the state
+    PTR(PropertySet) unchanged = state.properties->deepCopy();
+    for (std::string const& name : received->names()) {
+        if (unchanged->exists(name))
+            unchanged->remove(name);
+        if (state.properties->exists(name))
+            state.properties->remove(name);
+    }
+    event.addCustomProperties(unchanged);
+    state.properties->combine(received);
+    return true;
+}
+
+void DeltaReader::reset() {
+    _originators.clear();
+}
+
+/** private method to forget the originator which has gone longest without
+  * sending an event
+  */
+void DeltaReader::evict() {
+    std::map<std::string, State>::iterator oldest = _originators.begin();
+    for (std::map<std::string, State>::iterator it = _originators.begin(); it != _originators.end(); ++it) {
+        if (it->second.lastUsed < oldest->second.lastUsed)
+            oldest = it;
+    }
+    if (oldest != _originators.end())
+        _originators.erase(oldest);
+}
+
+}}}
@@ -0,0 +1,138 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file DeltaWriter.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Reduction of successive StatusEvents to the properties which changed
+ *
+ */
+
+#include <sstream>
+#include <vector>
+
+#include "boost/scoped_ptr.hpp"
+
+#include "lsst/ctrl/events/DeltaWriter.h"
+#include "lsst/ctrl/events/BinaryWriter.h"
+#include "lsst/ctrl/events/LocationId.h"
+#include "lsst/ctrl/events/StatusEvent.h"
+
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+DeltaWriter::DeltaWriter() : _interval(DEFAULT_KEYFRAME_INTERVAL), _clock(0) {
+}
+
+bool DeltaWriter::getOriginator(Event& event, std::string& originator) {
+    StatusEvent* statusEvent = dynamic_cast<StatusEvent*>(&event);
+    if (statusEvent == NULL)
+        return false;
+
+    boost::scoped_ptr<LocationId> location(statusEvent->getOriginator());
+    std::ostringstream key;
+    key << location->getHostName() << "/" << location->getProcessID() << "/" << location->getLocalID();
+    originator = key.str();
+    return true;
+}
+
+PTR(PropertySet) DeltaWriter::write(std::string const& originator, PropertySet const& properties,
+                                    long long& sequence) {
+    // encode every value first, so that a value which can not be encoded
+    // leaves the state of the originator as it was
+    std::map<std::string, std::string> values;
+    std::vector<std::string> names = properties.names();
+    for (std::string const& name : names) {
+        std::string& value = values[name];
+        unsigned char tag = BinaryWriter::tagOf(properties, name);
+        value.push_back(tag);
+        BinaryWriter::writeValues(properties, name, tag, value);
+    }
+
+    std::map<std::string, State>::iterator it = _originators.find(originator);
+    if (it == _originators.end()) {
+        if (_originators.size() >= MAX_ORIGINATORS)
+            evict();
+        State state;
+        state.sequence = -1;
+        it = _originators.insert(std::make_pair(originator, state)).first;
+    }
+    State& state = it->second;
+    state.lastUsed = ++_clock;
+    sequence = ++state.sequence;
+
+    std::vector<std::string> unchanged;
+    size_t kept = 0;
+    for (std::string const& name : names) {
+        std::map<std::string, std::string>::const_iterator previous = state.values.find(name);
+        if (previous == state.values.end())
+            continue;
+        kept++;
+        if (previous->second == values[name])
+            unchanged.push_back(name);
+    }
+
+    // a removed property can only be sent in a keyframe
+    bool keyframe = (sequence % _interval == 0) || (kept != state.values.size());
+    state.values.swap(values);
+    if (keyframe)
+        return PTR(PropertySet)();
+
+    PTR(PropertySet) psp = properties.deepCopy();
+    for (std::string const& name : unchanged)
+        psp->remove(name);
+    return psp;
+}
+
+void DeltaWriter::setKeyframeInterval(int interval) {
+    if (interval < 1)
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "keyframe interval must be at least 1");
+    _interval = interval;
+}
+
+void DeltaWriter::reset() {
+    _originators.clear();
+}
+
+/** private method to forget the originator which has gone longest without
+  * sending an event
+  */
+void DeltaWriter::evict() {
+    std::map<std::string, State>::iterator oldest = _originators.begin();
+    for (std::map<std::string, State>::iterator it = _originators.begin(); it != _originators.end(); ++it) {
+        if (it->second.lastUsed < oldest->second.lastUsed)
+            oldest = it;
+    }
+    if (oldest != _originators.end())
+        _originators.erase(oldest);
+}
+
+}}}
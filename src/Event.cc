@@ -31,13 +31,28 @@
  *
  */
 
+#include <algorithm>
+#include <utility>
+
 #include "boost/scoped_array.hpp"
-#include "boost/property_tree/ptree.hpp"
-#include "boost/property_tree/json_parser.hpp"
-#include "boost/foreach.hpp"
+#include "boost/scoped_ptr.hpp"
 
 #include "lsst/ctrl/events/Event.h"
 #include "lsst/ctrl/events/EventTypes.h"
+#include "lsst/ctrl/events/EventEncodings.h"
+#include "lsst/ctrl/events/DateFormat.h"
+#include "lsst/ctrl/events/HeaderPlan.h"
+#include "lsst/ctrl/events/HostTable.h"
+#include "lsst/ctrl/events/CommandEvent.h"
+#include "lsst/ctrl/events/LocationId.h"
+#include "lsst/ctrl/events/StatusEvent.h"
+#include "lsst/ctrl/events/BinaryReader.h"
+#include "lsst/ctrl/events/BinaryWriter.h"
+#include "lsst/ctrl/events/JSONReader.h"
+#include "lsst/ctrl/events/JSONWriter.h"
+#include "lsst/ctrl/events/MappedPayload.h"
+#include "lsst/ctrl/events/PayloadCompressor.h"
+#include "lsst/ctrl/events/SchemaReader.h"
 
 #include "lsst/daf/base/DateTime.h"
 #include "lsst/daf/base/PropertySet.h"
@@ -58,6 +73,20 @@ namespace ctrl {
 namespace events {
 
 
+namespace {
+
+// the reserved header values, which Event keeps as members
+KeywordSet::Keyword const RESERVED[] = {
+    KeywordSet::EVENTTIME, KeywordSet::PUBTIME, KeywordSet::RUNID,
+    KeywordSet::STATUS, KeywordSet::TOPIC, KeywordSet::TYPE
+};
+
+inline KeywordSet::Mask bit(int keyword) {
+    return 1u << keyword;
+}
+
+}
+
 const std::string Event::TYPE = "TYPE";
 const std::string Event::EVENTTIME = "EVENTTIME";
 const std::string Event::RUNID = "RUNID";
@@ -65,6 +94,17 @@ const std::string Event::STATUS = "STATUS";
 const std::string Event::TOPIC = "TOPIC";
 const std::string Event::QUEUE = "QUEUE";
 const std::string Event::PUBTIME = "PUBTIME";
+const std::string Event::ENCODING = "ENCODING";
+const std::string Event::COMPRESSION = "COMPRESSION";
+const std::string Event::SEQUENCE = "SEQUENCE";
+const std::string Event::DELTA = "DELTA";
+const std::string Event::DICTIONARY = "DICTIONARY";
+const std::string Event::NAMES = "NAMES";
+const std::string Event::CHUNKSET = "CHUNKSET";
+const std::string Event::CHUNK = "CHUNK";
+const std::string Event::CHUNKS = "CHUNKS";
+const std::string Event::CLAIMCHECK = "CLAIMCHECK";
+const std::string Event::HOSTS = "HOSTS";
 
 const std::string Event::UNINITIALIZED = "uninitialized";
 
@@ -73,29 +113,85 @@ Event::Event() {
 }
 
 void Event::_init() {
-    _keywords.insert(TYPE);
-    _keywords.insert(EVENTTIME);
-    _keywords.insert(STATUS);
-    _keywords.insert(TOPIC);
-    _keywords.insert(PUBTIME);
+    _keywords.add(KeywordSet::EVENT_KEYWORDS);
     _psp = PTR(PropertySet)(new PropertySet);
+    _eventTime = 0;
+    _pubTime = 0;
+    _reserved = 0;
+    _bodyPending = false;
+    _payloadPacked = false;
+    _invalidate();
 }
 
-Event::Event(cms::TextMessage *msg) {
+Event::Event(cms::Message *msg) {
 
     vector<std::string>names = msg->getPropertyNames();
 
-    _psp = processTextMessage(msg);
-
-    for (std::string name : names) {
+    _psp = PTR(PropertySet)(new PropertySet);
+    _payloadPacked = false;
+    _invalidate();
+    processMessage(msg);
+
+    _eventTime = msg->getCMSTimestamp();
+    _pubTime = 0;
+    _reserved = bit(KeywordSet::EVENTTIME);
+
+    // the names of the hosts in packed locations are defined before they are used
+    if (msg->propertyExists(HOSTS))
+        HostTable::getDefaultHostTable().define(msg->getStringProperty(HOSTS));
+
+    // one pass over the header: every property becomes a keyword, and is
+    // copied with its JMS type, including those of the subclasses
+    for (std::string const& name : names) {
+        // how the body was encoded is not part of the event
+        if ((name == ENCODING) || (name == COMPRESSION) || (name == SEQUENCE) || (name == DELTA) ||
+            (name == DICTIONARY) || (name == NAMES) || (name == CHUNKSET) || (name == CHUNK) ||
+            (name == CHUNKS) || (name == CLAIMCHECK) || (name == HOSTS))
+            continue;
+
+        // packed locations are received as the properties they stand for
+        if (name == StatusEvent::ORIG_ID) {
+            addLocation(msg->getLongProperty(name), name,
+                        KeywordSet::ORIG_HOSTNAME, KeywordSet::ORIG_PROCESSID, KeywordSet::ORIG_LOCALID);
+            continue;
+        }
+        if (name == CommandEvent::DEST_ID) {
+            addLocation(msg->getLongProperty(name), name,
+                        KeywordSet::DEST_HOSTNAME, KeywordSet::DEST_PROCESSID, KeywordSet::DEST_LOCALID);
+            continue;
+        }
         _keywords.insert(name);
-    }
 
-    _psp->set(EVENTTIME, msg->getCMSTimestamp());
+        // the reserved header values go to their members
+        int keyword = KeywordSet::find(name);
+        switch (keyword) {
+            case KeywordSet::EVENTTIME:
+                _eventTime = msg->getLongProperty(name);
+                break;
+            case KeywordSet::PUBTIME:
+                _pubTime = msg->getLongProperty(name);
+                break;
+            case KeywordSet::TYPE:
+                _type = msg->getStringProperty(name);
+                break;
+            case KeywordSet::STATUS:
+                _status = msg->getStringProperty(name);
+                break;
+            case KeywordSet::TOPIC:
+                _topic = msg->getStringProperty(name);
+                break;
+            case KeywordSet::RUNID:
+                _runId = msg->getStringProperty(name);
+                break;
+            default:
+                keyword = -1;
+                break;
+        }
+        if (keyword >= 0) {
+            _reserved |= bit(keyword);
+            continue;
+        }
 
-    for (std::string n : names) {
-        //std::string const& name = *n;
-        std::string const& name = n;
         cms::Message::ValueType vType = msg->getPropertyValueType(name);
         switch(vType) {
             case cms::Message::NULL_TYPE:
@@ -137,393 +233,705 @@ Event::Event(cms::TextMessage *msg) {
 }
 
 vector<std::string> Event::getFilterablePropertyNames() {
-    vector<std::string> _names;
-    for (std::string keyIterator : _keywords) {
-        _names.push_back(keyIterator);
-    }
-    return _names;
+    vector<std::string> names;
+    names.reserve(_keywords.size());
+    _keywords.forEach([&names](std::string const& name) { names.push_back(name); });
+    return names;
 }
 
 vector<std::string> Event::getCustomPropertyNames() {
-    vector<std::string> names = _psp->names();
+    decodeBody();
 
-    vector<std::string>::iterator nameIterator;
-    set<std::string>::iterator keyIterator;
+    vector<std::string> names = _psp->names();
 
-    for (nameIterator = names.begin(); nameIterator != names.end();) {
-            keyIterator = _keywords.find(*nameIterator);
-            if (keyIterator == _keywords.end())
-                nameIterator++;
-            else
-                names.erase(nameIterator);
-    }
+    KeywordSet const& keywords = _keywords;
+    names.erase(std::remove_if(names.begin(), names.end(),
+                               [&keywords](std::string const& name) { return keywords.contains(name); }),
+                names.end());
     return names;
 }
 
 Event::Event(PropertySet const& ps) {
     const std::string empty;
     PropertySet p;
-    _constructor(empty, ps, p);
+    _constructor(empty, ps.deepCopy(), p);
 }
 
 Event::Event(PropertySet const& ps, PropertySet const& filterable) {
     const std::string empty;
-    _constructor(empty, ps, filterable);
+    _constructor(empty, ps.deepCopy(), filterable);
 }
 
 Event::Event(std::string const& runId, CONST_PTR(PropertySet) psp) {
     PropertySet p;
-    _constructor(runId, *psp, p);
+    _constructor(runId, psp->deepCopy(), p);
 }
 
 Event::Event(std::string const& runId, PropertySet const& ps) {
     PropertySet p;
-    _constructor(runId, ps, p);
+    _constructor(runId, ps.deepCopy(), p);
 }
 
 Event::Event(std::string const& runId, PropertySet const& ps, PropertySet const& filterable) {
-    _constructor(runId, ps, filterable);
+    _constructor(runId, ps.deepCopy(), filterable);
+}
+
+Event::Event(PTR(PropertySet)&& psp) {
+    const std::string empty;
+    PropertySet p;
+    _constructor(empty, std::move(psp), p);
+}
+
+Event::Event(PTR(PropertySet)&& psp, PropertySet const& filterable) {
+    const std::string empty;
+    _constructor(empty, std::move(psp), filterable);
+}
+
+Event::Event(std::string const& runId, PTR(PropertySet)&& psp) {
+    PropertySet p;
+    _constructor(runId, std::move(psp), p);
+}
+
+Event::Event(std::string const& runId, PTR(PropertySet)&& psp, PropertySet const& filterable) {
+    _constructor(runId, std::move(psp), filterable);
 }
 
-void Event::_constructor(std::string const& runId, PropertySet const& ps, PropertySet const& filterable) {
+/** private method common to all constructors, which takes over psp unless
+  * it is shared; the constructors which are given a PropertySet to copy
+  * pass a deep copy of it
+  */
+void Event::_constructor(std::string const& runId, PTR(PropertySet) psp, PropertySet const& filterable) {
+    if (!psp)
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "Event PropertySet is null");
+
     _init();
 
-    _psp = ps.deepCopy();
+    _psp = std::move(psp);
+    // a set which the caller still holds is copied, so that it is left
+    // as it was
+    _detach();
 
+    if (filterable.nameCount() > 0) {
+        vector<std::string> names = filterable.names();
 
-    // do NOT alter the property set we were given. Make a copy of it,
-    // and modify that one.
+        for (std::string name : names) {
+            _keywords.insert(name);
+        }
 
-    if (!_psp->exists(STATUS)) {
-        _psp->set(STATUS, "unknown");
-    }
-    
-    if (!_psp->exists(EVENTTIME)) {
-        updateEventTime();
+        // the header values are scalars, so they need no deep copy
+        _psp->combine(CONST_PTR(PropertySet)(&filterable, [](PropertySet const*) {}));
     }
-   
+
+    takeReserved();
+
     // _runId is filled in here and is ignored in the passed PropertySet
     if (!runId.empty()) {
         _keywords.insert(RUNID);
-        _psp->set(RUNID, runId);
+        _runId = runId;
+        _reserved |= bit(KeywordSet::RUNID);
+        if (_psp->exists(RUNID))
+            _psp->remove(RUNID);
     }
+}
 
-    if (!_psp->exists(TYPE)) 
-        _psp->set(TYPE, EventTypes::EVENT);
+/** private method to move the reserved header values given to a
+  * constructor out of _psp into their members, with their defaults
+  */
+void Event::takeReserved() {
+    _status = _psp->exists(STATUS) ? _psp->get<std::string>(STATUS) : std::string("unknown");
+    _eventTime = _psp->exists(EVENTTIME) ? _psp->getAsInt64(EVENTTIME) : dafBase::DateTime::now().nsecs();
+    _type = _psp->exists(TYPE) ? _psp->get<std::string>(TYPE) : EventTypes::EVENT;
 
     // _topic is filled in on publish and is ignored in the passed PropertySet
-    _psp->set(TOPIC, Event::UNINITIALIZED);
+    _topic = Event::UNINITIALIZED;
 
     // _pubTime is filled in on publish and is ignored in the passed PropertySet
-    _psp->set(PUBTIME, (long long)0);
+    _pubTime = 0;
+
+    for (KeywordSet::Keyword keyword : RESERVED) {
+        if (keyword == KeywordSet::RUNID)
+            continue;
+        std::string const& name = KeywordSet::names()[keyword];
+        if (_psp->exists(name))
+            _psp->remove(name);
+        _reserved |= bit(keyword);
+    }
+}
 
-    if (filterable.nameCount() > 0) {
-        vector<std::string> names = filterable.names();
+/** private method to add the header properties of a location which was
+  * received as a packed ID; the ID must not be given the name of another
+  * host, so one whose code is shared by two hosts is kept packed, as the
+  * property idName, and one whose host is not known is an error
+  */
+void Event::addLocation(long long id, std::string const& idName, int hostname, int pid, int local) {
+    LocationId location(id);
+    if (location.getHostName().empty()) {
+        if (!HostTable::getDefaultHostTable().isConflicting(LocationId::getHostCode(id)))
+            throw LSST_EXCEPT(pexExceptions::RuntimeError,
+                              "Host code " + std::to_string(LocationId::getHostCode(id)) + " is not known");
+        _keywords.insert(idName);
+        _psp->set(idName, id);
+        return;
+    }
 
-        for (std::string name : names) {
-            _keywords.insert(name);
-        }
+    std::string const* names = KeywordSet::names();
+    _keywords.insert(names[hostname]);
+    _keywords.insert(names[pid]);
+    _keywords.insert(names[local]);
+    _psp->set(names[hostname], location.getHostName());
+    _psp->set(names[pid], location.getProcessID());
+    _psp->set(names[local], location.getLocalID());
+}
 
-        _psp->combine(filterable.PropertySet::deepCopy());
-    }
+/** private method to check that a reserved header value is set
+  */
+void Event::checkReserved(int keyword) const {
+    if ((_reserved & bit(keyword)) == 0)
+        throw LSST_EXCEPT(pexExceptions::RuntimeError,
+                          std::string("property ") + KeywordSet::names()[keyword] + " not found");
 }
 
-void Event::populateHeader(cms::TextMessage* msg)  const {
-    for (std::string name : _keywords) {
-        std::type_info const& t = _psp->typeOf(name);
-        if (t == typeid(bool)) {
-            msg->setBooleanProperty(name, _psp->get<bool>(name));
-        } else if (t == typeid(short)) {
-            msg->setShortProperty(name, _psp->get<short>(name));
-        } else if (t == typeid(int)) {
-            msg->setIntProperty(name, _psp->get<int>(name));
-        } else if (t == typeid(long)) {
-            msg->setLongProperty(name, _psp->get<long>(name));
-        } else if (t == typeid(long long)) {
-            msg->setLongProperty(name, _psp->get<long long>(name));
-        } else if (t == typeid(double)) {
-            msg->setDoubleProperty(name, _psp->get<double>(name));
-        } else if (t == typeid(float)) {
-            msg->setFloatProperty(name, _psp->get<float>(name));
-        } else if (t == typeid(std::string)) {
-            msg->setStringProperty(name, _psp->get<std::string>(name));
-        } else {
-            std::string msg("Data type represented in "+ name +" is not permitted in event header");
-            throw LSST_EXCEPT(pexExceptions::RuntimeError, msg);
-        }
-    }
+void Event::populateHeader(cms::Message* msg, bool compact)  const {
+    std::lock_guard<std::recursive_mutex> lock(_lazy.mutex);
+    if (!_plan || (_plan->isCompact() != compact))
+        _plan = HeaderPlan::get(*this, _planKey, compact);
+    _plan->write(*this, msg);
 }
-            
 
-long long Event::getEventTime() {
-    return _psp->get<long long>(EVENTTIME);
+CONST_PTR(PropertySet) Event::_properties() const {
+    std::lock_guard<std::recursive_mutex> lock(_lazy.mutex);
+    decodeBody();
+    return _psp;
+}
+
+// _psp is shared with the callers of getPropertySet(), and with copies of
+// this event
+void Event::_detach() const {
+    if (!_psp.unique())
+        _psp = _psp->deepCopy();
+}
+
+void Event::_setType(std::string const& type) {
+    _type = type;
+    _reserved |= bit(KeywordSet::TYPE);
+    invalidateView();
+}
+
+void Event::_invalidate() {
+    invalidateView();
+    _plan.reset();
+    _custom.reset();
+    _payload.clear();
+    _payloadEncoding.clear();
+}
+
+/** private method to discard what depends on the reserved header values;
+  * the header plan only depends on which are set, and the body holds only
+  * custom properties, so they are kept
+  */
+void Event::invalidateView() {
+    _view.reset();
+}
+
+
+long long Event::getEventTime() const {
+    checkReserved(KeywordSet::EVENTTIME);
+    return _eventTime;
 }
 
 void Event::setEventTime(long long nsecs) {
-    _psp->set(EVENTTIME,  nsecs);
+    _eventTime = nsecs;
+    _reserved |= bit(KeywordSet::EVENTTIME);
+    invalidateView();
 }
 
 void Event::updateEventTime() {
-    _psp->set(EVENTTIME,  (long long)dafBase::DateTime::now().nsecs());
+    setEventTime(dafBase::DateTime::now().nsecs());
 }
 
 
-std::string Event::getEventDate() {
-    long long eventTime = _psp->get<long long>(EVENTTIME);
-    dafBase::DateTime dateTime(eventTime);
-    
-    struct tm gmTime = dateTime.gmtime();
-    return asctime(&gmTime);
+std::string Event::getEventDate() const {
+    std::string date;
+    getEventDate(date);
+    return date;
 }
 
+void Event::getEventDate(std::string& date) const {
+    checkReserved(KeywordSet::EVENTTIME);
+    DateFormat::format(_eventTime, date);
+}
 
-PTR(PropertySet) Event::getCustomPropertySet() const {
-    PTR(PropertySet) psp = _psp->deepCopy();
 
-    for (std::string keyword : _keywords) {
-        psp->remove(keyword);
-    }
+CONST_PTR(PropertySet) Event::getCustomPropertySet() const {
+    std::lock_guard<std::recursive_mutex> lock(_lazy.mutex);
+    decodeBody();
+
+    if (!_custom)
+        _custom = makeCustom();
+    return _custom;
+}
+
+PTR(PropertySet) Event::copyCustomPropertySet() const {
+    std::lock_guard<std::recursive_mutex> lock(_lazy.mutex);
+    decodeBody();
+
+    return _custom ? _custom->deepCopy() : makeCustom();
+}
+
+CONST_PTR(PropertySet) Event::getPropertySet() const {
+    std::lock_guard<std::recursive_mutex> lock(_lazy.mutex);
+    decodeBody();
+
+    if (!_view)
+        _view = makeView();
+    return _view;
+}
+
+PTR(PropertySet) Event::copyPropertySet() const {
+    std::lock_guard<std::recursive_mutex> lock(_lazy.mutex);
+    decodeBody();
+
+    return _view ? _view->deepCopy() : makeView();
+}
+
+/** private method to make a new PropertySet of the custom properties, with
+  * the lock held and the body decoded
+  */
+PTR(PropertySet) Event::makeCustom() const {
+    PTR(PropertySet) psp = _psp->deepCopy();
+    _keywords.forEach([&psp](std::string const& keyword) { psp->remove(keyword); });
     return psp;
 }
 
-PTR(PropertySet) Event::getPropertySet() const {
-    if (_psp != 0) {
-            PTR(PropertySet) psp = _psp->deepCopy();
-            return psp;
-    }
-    PTR(PropertySet) psp(new PropertySet);
+/** private method to make a new PropertySet of the properties, with the
+  * lock held and the body decoded; the reserved header values are only
+  * added to a PropertySet here
+  */
+PTR(PropertySet) Event::makeView() const {
+    // a deep copy, so that no nested PropertySet is shared with _psp
+    PTR(PropertySet) psp = _psp->deepCopy();
+    if (_reserved & bit(KeywordSet::EVENTTIME))
+        psp->set(EVENTTIME, _eventTime);
+    if (_reserved & bit(KeywordSet::PUBTIME))
+        psp->set(PUBTIME, _pubTime);
+    if (_reserved & bit(KeywordSet::RUNID))
+        psp->set(RUNID, _runId);
+    if (_reserved & bit(KeywordSet::STATUS))
+        psp->set(STATUS, _status);
+    if (_reserved & bit(KeywordSet::TOPIC))
+        psp->set(TOPIC, _topic);
+    if (_reserved & bit(KeywordSet::TYPE))
+        psp->set(TYPE, _type);
     return psp;
 }
 
 void Event::setPubTime(long long t) {
-    _psp->set(PUBTIME, t);
+    _pubTime = t;
+    _reserved |= bit(KeywordSet::PUBTIME);
+    invalidateView();
 }
 
-long long Event::getPubTime() {
-    return _psp->get<long long>(PUBTIME);
+long long Event::getPubTime() const {
+    checkReserved(KeywordSet::PUBTIME);
+    return _pubTime;
 }
 
-std::string Event::getPubDate() {
-    long long _pubTime = _psp->get<long long>(PUBTIME);
+std::string Event::getPubDate() const {
+    std::string date;
+    getPubDate(date);
+    return date;
+}
+
+void Event::getPubDate(std::string& date) const {
+    checkReserved(KeywordSet::PUBTIME);
     if (_pubTime == 0)
-        return std::string();
+        date.clear();
+    else
+        DateFormat::format(_pubTime, date);
+}
+
+std::string const& Event::getRunId() const {
+    if (_reserved & bit(KeywordSet::RUNID))
+        return _runId;
+
+    std::lock_guard<std::recursive_mutex> lock(_lazy.mutex);
+    decodeBody();
+    if (_psp->exists(RUNID)) {
+        // only written when it changes, since other threads may be reading it
+        std::string runid = _psp->get<std::string>(RUNID);
+        if (runid != _customRunId)
+            _customRunId = runid;
+        return _customRunId;
+    }
+    throw LSST_EXCEPT(pexExceptions::RuntimeError, std::string("property RUNID not found"));
+}
 
-    dafBase::DateTime dateTime(_pubTime);
-    
-    struct tm pubTime = dateTime.gmtime();
-    return asctime(&pubTime);
+void Event::setRunId(std::string const& runid) {
+    reserveRunId();
+    _runId = runid;
 }
 
-std::string Event::getRunId() {
-    if (_psp->exists(RUNID))
-        return _psp->get<std::string>(RUNID);
-    throw LSST_EXCEPT(pexExceptions::RuntimeError, std::string("property RUNID not found"));
+void Event::setRunId(char const* runid) {
+    reserveRunId();
+    _runId = runid;
+}
+
+/** private method to make RUNID a reserved header value, which replaces
+  * any RUNID given as a custom property; the caller sets _runId
+  */
+void Event::reserveRunId() {
+    if (_psp->exists(RUNID)) {
+        _detach();
+        _psp->remove(RUNID);
+        _invalidate();
+    }
+    if ((_keywords.mask() & bit(KeywordSet::RUNID)) == 0) {
+        _keywords.insert(RUNID);
+        _plan.reset();
+    }
+    _reserved |= bit(KeywordSet::RUNID);
+    invalidateView();
+}
+
+std::string const& Event::getType() const {
+    checkReserved(KeywordSet::TYPE);
+    return _type;
 }
 
-void Event::setRunId(std::string runid) {
-    _keywords.insert(RUNID);
-    _psp->set(RUNID, runid);
+std::string const& Event::getStatus() const {
+    checkReserved(KeywordSet::STATUS);
+    return _status;
 }
 
-std::string Event::getType() {
-    return _psp->get<std::string>(TYPE);
+// assigning to the members reuses their storage, so setting values no
+// longer than those they replace allocates nothing
+void  Event::setStatus(std::string const& status) {
+    _status = status;
+    _reserved |= bit(KeywordSet::STATUS);
+    invalidateView();
 }
 
-std::string Event::getStatus() {
-    return _psp->get<std::string>(STATUS);
+void  Event::setStatus(char const* status) {
+    _status = status;
+    _reserved |= bit(KeywordSet::STATUS);
+    invalidateView();
 }
 
-void  Event::setStatus(std::string status) {
-    _psp->set(STATUS, status);
+void Event::setTopic(std::string const& topic) {
+    _topic = topic;
+    _reserved |= bit(KeywordSet::TOPIC);
+    invalidateView();
 }
 
-void Event::setTopic(std::string topic) {
-    _psp->set(TOPIC, topic);
+void Event::setTopic(char const* topic) {
+    _topic = topic;
+    _reserved |= bit(KeywordSet::TOPIC);
+    invalidateView();
 }
 
-std::string Event::getTopic() {
-    return _psp->get<std::string>(TOPIC);
+std::string const& Event::getTopic() const {
+    checkReserved(KeywordSet::TOPIC);
+    return _topic;
 }
 
 void Event::marshall(cms::TextMessage *msg) {
-    PTR(PropertySet) psp;
+    populateHeader(msg);
+    msg->setText(cachedPayload(EventEncodings::JSON));
+}
 
+void Event::marshall(cms::BytesMessage *msg) {
     populateHeader(msg);
-    psp = getCustomPropertySet();
-    std::string payload = marshall(*psp);
-    msg->setText(payload);
+    std::string const& payload = cachedPayload(EventEncodings::BINARY);
+    msg->setBodyBytes(reinterpret_cast<unsigned char const*>(payload.data()), payload.size());
+    msg->setStringProperty(ENCODING, EventEncodings::BINARY);
 }
 
-template<typename T>void Event::add(std::string const& name, std::string const& tag, PropertySet const& ps, boost::property_tree::ptree& child) {
+void Event::marshall(cms::BytesMessage *msg, SchemaWriter& writer) {
+    populateHeader(msg);
+    std::string const& payload = marshallPayload(EventEncodings::SCHEMA, writer);
+    msg->setBodyBytes(reinterpret_cast<unsigned char const*>(payload.data()), payload.size());
+    msg->setStringProperty(ENCODING, EventEncodings::SCHEMA);
+}
 
-    std::vector<T> vec = ps.getArray<T>(name);
+std::string const& Event::marshallPayload(std::string const& encoding, SchemaWriter& writer, bool pack) {
+    if (encoding != EventEncodings::SCHEMA)
+        return cachedPayload(encoding, pack);
 
-    boost::property_tree::ptree children;
-    for (auto iter: vec) {
-        boost::property_tree::ptree pt;
-        pt.put("", iter);
-        children.push_back(std::make_pair(tag, pt));
-    }
-    child.put_child(name, children);
+    // whether a schema body carries its definition depends on the writer,
+    // so it is written every time, and replaces any kept body
+    writer.write(*getCustomPropertySet(), _payload);
+    _payloadEncoding.clear();
+    return _payload;
 }
 
-std::string Event::marshall(PropertySet const& ps) {
-    std::vector<std::string> names = ps.paramNames(false);
-
-    boost::property_tree::ptree child;
- 
-    for (std::string name : names) {
-        if (ps.typeOf(name) == typeid(bool)) {
-            add<bool>(name, "bool", ps, child);
-        } else if (ps.typeOf(name) == typeid(long)) {
-            add<long>(name, "long", ps, child);
-        } else if (ps.typeOf(name) == typeid(long long)) {
-            add<long long>(name, "long long", ps, child);
-        } else if (ps.typeOf(name) == typeid(int)) {
-            add<int>(name, "int", ps, child);
-        } else if (ps.typeOf(name) == typeid(float)) {
-            add<float>(name, "float", ps, child);
-        } else if (ps.typeOf(name) == typeid(double)) {
-            add<double>(name, "double", ps, child);
-        } else if (ps.typeOf(name) == typeid(std::string)) {
-            add<std::string>(name, "string", ps, child);
-        } else if (ps.typeOf(name) == typeid(lsst::daf::base::DateTime)) {
-            std::vector<lsst::daf::base::DateTime> vec  = ps.getArray<lsst::daf::base::DateTime>(name);
-            for (lsst::daf::base::DateTime dateTime : vec) {
-                boost::property_tree::ptree pt;
-                pt.put("datetime", (dateTime).nsecs());
-                child.put_child(name, pt);
-            }
-        } else {
-            std::string msg("Couldn't marshall "+name);
-            throw LSST_EXCEPT(pexExceptions::RuntimeError, msg);
-        }
-    }
-    std::ostringstream payload;
-    write_json(payload, child, false);
-
-    return payload.str();
+/** private method to add properties, which are not copied, to the custom
+  * properties of this event; used by DeltaReader to complete an event sent
+  * as a delta
+  */
+void Event::addCustomProperties(PTR(PropertySet) properties) {
+    decodeBody();
+    _detach();
+    _psp->combine(properties);
+    _invalidate();
 }
 
-/** private method unmarshall the DataProperty from the TextMessage
+/** private method to get the body in the JSON or binary encoding, with
+  * numeric arrays in JSON packed if pack is set, which is only marshalled
+  * again if the encoding or packing differs from the last one
   */
-PTR(PropertySet) Event::processTextMessage(cms::TextMessage* textMessage) {
-    if (textMessage == NULL)
-        return PTR(PropertySet)();
+std::string const& Event::cachedPayload(std::string const& encoding, bool pack) {
+    bool packed = pack && (encoding != EventEncodings::BINARY);
+    if (!_payloadEncoding.empty() && (encoding == _payloadEncoding) && (packed == _payloadPacked))
+        return _payload;
 
-    std::string text = textMessage->getText();
+    _payloadEncoding.clear();
+    if (encoding == EventEncodings::BINARY)
+        BinaryWriter::write(*getCustomPropertySet(), _payload);
+    else
+        JSONWriter::write(*getCustomPropertySet(), _payload, packed);
+    _payloadEncoding = encoding;
+    _payloadPacked = packed;
+    return _payload;
+}
 
-    PTR(PropertySet) unmarsh = unmarshall(text);
-    return unmarsh;
+std::string Event::marshall(PropertySet const& ps) {
+    return JSONWriter::write(ps);
 }
 
-/** private method to try to add data to a property set
- * \param typeInfo a string containing the name of the data type
- * \param item a node of a boost::property_tree::ptree containing data
- * \param key the name of the data
- * \param ps a PropertySet to store the name and data into.
- * \return true if data was added to the PropertySet
+/** private method to keep the message body, after checking that the
+  * ENCODING and COMPRESSION header properties name a decoder for it.
+  * Messages without an ENCODING property are JSON encoded TextMessages;
+  * uncompressed JSON may also be sent as a BytesMessage.
+  * The body is decoded by decodeBody() when it is first needed.
   */
-bool Event::addDataItem(std::string const& typeInfo, boost::property_tree::ptree& item, std::string const&  key, PropertySet& ps) {
-    if (typeInfo == "string") {
-        std::string value = item.get_value<std::string>();
-        ps.add(key, value);
-    } else if (typeInfo == "bool") {
-        bool value = item.get_value<bool>();
-        ps.add(key, value);
-    } else if (typeInfo == "long") {
-        long value = item.get_value<long>();
-        ps.add(key, value);
-    } else if (typeInfo == "long long") {
-        long long value = item.get_value<long long>();
-        ps.add(key, value);
-    } else if (typeInfo == "int") {
-        int value = item.get_value<int>();
-        ps.add(key, value);
-    } else if (typeInfo == "float") {
-        float value = item.get_value<float>();
-        ps.add(key, value);
-    } else if (typeInfo == "double") {
-        double value = item.get_value<double>();
-        ps.add(key, value);
-    } else if (typeInfo == "datetime") {
-        long long value = item.get_value<long long>();
-        ps.add(key, lsst::daf::base::DateTime(value, lsst::daf::base::DateTime::UTC));
+void Event::processMessage(cms::Message* msg) {
+    _bodyPending = false;
+    _bodyNames.reset();
+    _bodyClaim.clear();
+    if (msg == NULL)
+        return;
+
+    _bodyEncoding = EventEncodings::JSON;
+    if (msg->propertyExists(ENCODING))
+        _bodyEncoding = msg->getStringProperty(ENCODING);
+
+    if ((_bodyEncoding != EventEncodings::JSON) && (_bodyEncoding != EventEncodings::BINARY) &&
+        (_bodyEncoding != EventEncodings::SCHEMA))
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "Unknown event encoding \""+_bodyEncoding+"\"");
+
+    _bodyCompression.clear();
+    if (msg->propertyExists(COMPRESSION))
+        _bodyCompression = msg->getStringProperty(COMPRESSION);
+
+    if (!_bodyCompression.empty() && (_bodyCompression != PayloadCompressor::DEFLATE))
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "Unknown event compression \""+_bodyCompression+"\"");
+
+    // the body of an event sent by claim check is mapped from its file
+    // when it is decoded
+    if (msg->propertyExists(CLAIMCHECK)) {
+        _bodyClaim = msg->getStringProperty(CLAIMCHECK);
+        _bodyPending = true;
+        return;
+    }
+
+    // JSON reassembled from chunks arrives as a BytesMessage
+    cms::TextMessage* textMessage = dynamic_cast<cms::TextMessage*>(msg);
+    if ((_bodyEncoding == EventEncodings::JSON) && _bodyCompression.empty() && (textMessage != NULL)) {
+        _body = textMessage->getText();
     } else {
-        return false;
+        cms::BytesMessage* bytesMessage = dynamic_cast<cms::BytesMessage*>(msg);
+        if (bytesMessage == NULL)
+            throw LSST_EXCEPT(pexExceptions::RuntimeError, _bodyEncoding+" encoded event is not a BytesMessage");
+
+        int length = bytesMessage->getBodyLength();
+        boost::scoped_array<unsigned char> body(bytesMessage->getBodyBytes());
+        _body.assign(reinterpret_cast<char const*>(body.get()), length);
     }
-    return true;
+    _bodyPending = true;
 }
 
-/** private method to iterate through the representation of a propertyset
-  * within the boost::property_tree::ptree
-  * \param child a boost::property_tree::ptree to iterate through
-  * \return a PTR(PropertySet) containing the data that was stored in child.
+/** private method to decode the message body kept by processMessage(), if
+  * it has not been decoded yet, and add its properties to this event.
+  * Header properties take precedence over body properties of the same name.
+  * A body which fails to decode is kept, so that every later access fails
+  * the same way.
   */
-PTR(PropertySet) Event::parsePropertySet(boost::property_tree::ptree child) {
-    PTR(PropertySet) psp(new PropertySet);
-    
-    BOOST_FOREACH(boost::property_tree::ptree::value_type const &v, child.get_child("")) {
-        std::string label = v.first;
-        BOOST_FOREACH(boost::property_tree::ptree::value_type &v2, child.get_child(label)) {
-            const bool b = addDataItem(v2.first, v2.second, label, *psp);
-            if (!b) {
-                PTR(PropertySet) p2 = parsePropertySet(child.get_child(label));
-                psp->add(label, p2);
-                break;
-            }
-        }
+void Event::decodeBody() const {
+    std::lock_guard<std::recursive_mutex> lock(_lazy.mutex);
+    if (!_bodyPending)
+        return;
+
+    boost::scoped_ptr<MappedPayload> mapped;
+    unsigned char const* body = reinterpret_cast<unsigned char const*>(_body.data());
+    size_t length = _body.size();
+    if (!_bodyClaim.empty()) {
+        mapped.reset(new MappedPayload(_bodyClaim));
+        body = mapped->data();
+        length = mapped->size();
     }
-    return psp;
+
+    std::string inflated;
+    if (!_bodyCompression.empty()) {
+        PayloadCompressor::inflate(body, length, inflated);
+        body = reinterpret_cast<unsigned char const*>(inflated.data());
+        length = inflated.size();
+    }
+
+    PTR(PropertySet) psp;
+    if (_bodyEncoding == EventEncodings::SCHEMA) {
+        psp = PTR(PropertySet)(new PropertySet);
+        SchemaReader::read(body, length, *psp);
+    } else if (_bodyEncoding == EventEncodings::BINARY) {
+        psp = PTR(PropertySet)(new PropertySet);
+        BinaryReader::read(body, length, *psp);
+    } else {
+        psp = unmarshall(reinterpret_cast<char const*>(body), length);
+    }
+
+    for (std::string const& name : _psp->names()) {
+        if (psp->exists(name))
+            psp->remove(name);
+    }
+    for (KeywordSet::Keyword keyword : RESERVED) {
+        std::string const& name = KeywordSet::names()[keyword];
+        if ((_reserved & bit(keyword)) && psp->exists(name))
+            psp->remove(name);
+    }
+    // the header properties are added to the body properties, rather than
+    // the other way around, so that no set another thread holds is changed
+    psp->combine(_psp);
+    _psp = psp;
+
+    std::string().swap(_body);
+    _bodyPending = false;
 }
 
 /** private method unmarshall the DataProperty from a text string
   * \param text a JSON text string
+  * \param length the length of text
   * \return a PTR(PropertySet) containing the data that was stored in text
   */
-PTR(PropertySet) Event::unmarshall(std::string const& text) {
-
-    boost::property_tree::ptree pt;
-    std::istringstream is (text);
-    read_json(is, pt);
-
+PTR(PropertySet) Event::unmarshall(char const* text, size_t length) const {
     PTR(PropertySet) psp(new PropertySet);
+    JSONReader::read(text, length, _bodyNames.get(), *psp);
+    return psp;
+}
 
-    BOOST_FOREACH(boost::property_tree::ptree::value_type &v, pt) {
-        std::string key = v.first;
-
-        boost::property_tree::ptree child = v.second;
-        BOOST_FOREACH(boost::property_tree::ptree::value_type &v2, child) {
-            std::string key2 = v2.first;
-
-            const bool b = addDataItem(key2, v2.second, key, *psp);
-            if (!b) {
-                std::string value = v2.second.get_value<std::string>();
-                PTR(PropertySet) p = parsePropertySet(child);
-                psp->add(key, p);
-                break;
-            }
+void Event::reset() {
+    // a body which was never decoded is dropped with the other properties
+    bool changed = _bodyPending;
+    _bodyPending = false;
+    _body.clear();
+    _bodyClaim.clear();
+    _bodyNames.reset();
+
+    _keywords.clear();
+    _keywords.add(KeywordSet::EVENT_KEYWORDS);
+
+    // the header properties which the event type defines are kept; only
+    // if there are others is the list of names fetched to remove them
+    KeywordSet::Mask kept = _keywords.types() & ~KeywordSet::RESERVED_KEYWORDS;
+    size_t count = 0;
+    for (int keyword = 0; keyword < KeywordSet::KEYWORD_COUNT; keyword++) {
+        if ((kept & bit(keyword)) && _psp->exists(KeywordSet::names()[keyword]))
+            count++;
+    }
+    if (_psp->nameCount() != count) {
+        _detach();
+        for (std::string const& name : _psp->names()) {
+            int keyword = KeywordSet::find(name);
+            if ((keyword < 0) || ((kept & bit(keyword)) == 0))
+                _psp->remove(name);
         }
+        changed = true;
     }
-        
-    return psp;
-}
 
-Event::~Event() {
+    if (_type.empty())
+        _type = EventTypes::EVENT;
+    _status = "unknown";
+    _topic = Event::UNINITIALIZED;
+    _runId.clear();
+    _eventTime = dafBase::DateTime::now().nsecs();
+    _pubTime = 0;
+    _reserved = KeywordSet::EVENT_KEYWORDS;
+
+    if (changed) {
+        _invalidate();
+    } else {
+        invalidateView();
+        _plan.reset();
+    }
 }
 
-template void Event::add<bool>(std::string const& name, std::string const& tag, PropertySet const& ps, boost::property_tree::ptree& child);
+void Event::reset(PropertySet const& properties) {
+    PropertySet filterable;
+    reset(properties, filterable);
+}
 
-template void Event::add<int>(std::string const& name, std::string const& tag, PropertySet const& ps, boost::property_tree::ptree& child);
+void Event::reset(PropertySet const& properties, PropertySet const& filterable) {
+    reset();
+    if ((properties.nameCount() == 0) && (filterable.nameCount() == 0))
+        return;
 
-template void Event::add<float>(std::string const& name, std::string const& tag, PropertySet const& ps, boost::property_tree::ptree& child);
+    vector<std::string> const filterableNames = filterable.names();
+    for (std::string const& name : filterableNames) {
+        _keywords.insert(name);
+    }
 
-template void Event::add<double>(std::string const& name, std::string const& tag, PropertySet const& ps, boost::property_tree::ptree& child);
+    // the values are copied into _psp, which after reset() only holds the
+    // keywords of the event type, rather than into a new PropertySet; it is
+    // only copied first if a copy of this event still shares it
+    _detach();
+
+    // as in the constructors, only the status and event time may be given;
+    // the other keywords of the event type keep their values.  The values
+    // of filterable follow those of properties, so they win.
+    KeywordSet::Mask defined = _keywords.types() & ~bit(KeywordSet::RUNID);
+    auto take = [&](PropertySet const& source, std::string const& name) {
+        if (name == STATUS)
+            _status = source.get<std::string>(STATUS);
+        else if (name == EVENTTIME)
+            _eventTime = source.getAsInt64(EVENTTIME);
+        int keyword = KeywordSet::find(name);
+        if ((keyword < 0) || ((defined & bit(keyword)) == 0))
+            copyProperty(source, name);
+    };
+    for (std::string const& name : properties.names()) {
+        take(properties, name);
+    }
+    for (std::string const& name : filterableNames) {
+        take(filterable, name);
+    }
+    _invalidate();
+}
 
-template void Event::add<long>(std::string const& name, std::string const& tag,PropertySet const& ps, boost::property_tree::ptree& child);
+/** private method to add the values of a top level property of source to
+  * _psp; a PropertySet value is copied, so that none is shared with source
+  */
+void Event::copyProperty(PropertySet const& source, std::string const& name) {
+    if (source.isPropertySetPtr(name)) {
+        if (source.valueCount(name) == 1) {
+            _psp->add(name, source.getAsPropertySetPtr(name)->deepCopy());
+        } else {
+            for (PTR(PropertySet) const& nested : source.getArray<PTR(PropertySet)>(name)) {
+                _psp->add(name, nested->deepCopy());
+            }
+        }
+        return;
+    }
 
-template void Event::add<long long>(std::string const& name, std::string const& tag, PropertySet const& ps, boost::property_tree::ptree& child);
+    CONST_PTR(PropertySet) from(&source, [](PropertySet const*) {});
+    if (!_psp->exists(name)) {
+        _psp->copy(name, from, name);
+    } else {
+        // a name given in both properties and filterable has both values
+        PropertySet values;
+        values.copy(name, from, name);
+        _psp->combine(CONST_PTR(PropertySet)(&values, [](PropertySet const*) {}));
+    }
+}
 
-template void Event::add<std::string>(std::string const& name, std::string const& tag, PropertySet const& ps, boost::property_tree::ptree& child);
+Event::~Event() {
+}
 
 }}}
@@ -33,6 +33,7 @@
 #include <stdexcept>
 #include <limits>
 #include <cstring>
+#include <utility>
 #include <unistd.h>
 
 #include <log4cxx/helpers/stringhelper.h>
@@ -137,9 +138,8 @@ void EventAppender::append(const spi::LoggingEventPtr& event, helpers::Pool& p)
 
     logProp->set(LogEvent::LOCATION, loc);
 
-    PTR(LocationId) originatorId(new LocationId());
-
-    ctrlEvents::LogEvent e = ctrlEvents::LogEvent(*originatorId, *logProp);
+    // logProp was built only for this event, so the event takes it over
+    ctrlEvents::LogEvent e(_originatorId, std::move(logProp));
     if (!_runid.empty())
         e.setRunId(_runid);
 
@@ -0,0 +1,63 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file EventBatch.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Events received together
+ *
+ */
+
+#include <sstream>
+
+#include "lsst/ctrl/events/EventBatch.h"
+
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+EventBatch::EventBatch(int capacity) {
+    if (capacity > 0)
+        _events.reserve(capacity);
+}
+
+PTR(Event) EventBatch::getEvent(int i) const {
+    if ((i < 0) || (i >= size())) {
+        std::ostringstream msg;
+        msg << "EventBatch index " << i << " out of range for " << size() << " events";
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, msg.str());
+    }
+    return _events[i];
+}
+
+EventBatch::~EventBatch() {
+}
+
+}}}
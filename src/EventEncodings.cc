@@ -0,0 +1,44 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file EventEncodings.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Names of event body encodings
+ *
+ */
+
+#include "lsst/ctrl/events/EventEncodings.h"
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+    const std::string EventEncodings::JSON = "json";
+    const std::string EventEncodings::BINARY = "binary";
+    const std::string EventEncodings::SCHEMA = "schema";
+
+}}}
@@ -27,10 +27,12 @@
  *
  * @ingroup ctrl/events
  *
- * @brief Create the proper type of event, given a cms::TextMessage
+ * @brief Create the proper type of event, given a cms::Message
  *
  */
 
+#include "boost/make_shared.hpp"
+
 #include "lsst/ctrl/events/StatusEvent.h"
 #include "lsst/ctrl/events/CommandEvent.h"
 #include "lsst/ctrl/events/LogEvent.h"
@@ -48,19 +50,18 @@ EventFactory::EventFactory() {
 EventFactory::~EventFactory() {
 }
 
-PTR(Event) EventFactory::createEvent(cms::TextMessage* msg) {
-    std::vector<std::string> names = msg->getPropertyNames();
-
-    std::string _type = msg->getStringProperty("TYPE");
+// the Event and its reference count are allocated together
+PTR(Event) EventFactory::createEvent(cms::Message* msg) {
+    std::string _type = msg->getStringProperty(Event::TYPE);
 
     if (_type == EventTypes::LOG) {
-        return PTR(LogEvent)(new LogEvent(msg));
+        return boost::make_shared<LogEvent>(msg);
     } else if (_type == EventTypes::STATUS) {
-        return PTR(StatusEvent)(new StatusEvent(msg));
+        return boost::make_shared<StatusEvent>(msg);
     } else if (_type == EventTypes::COMMAND) {
-        return PTR(CommandEvent)(new CommandEvent(msg));
+        return boost::make_shared<CommandEvent>(msg);
     } else {
-        return PTR(Event)(new Event(msg));
+        return boost::make_shared<Event>(msg);
     }
 }
 
@@ -0,0 +1,128 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file EventSchema.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Shape of an event body, identified by a schema ID
+ *
+ */
+
+#include <algorithm>
+
+#include "lsst/ctrl/events/EventSchema.h"
+#include "lsst/ctrl/events/BinaryReader.h"
+#include "lsst/ctrl/events/BinaryWriter.h"
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+namespace {
+
+bool fieldOrder(EventSchema::Field const& a, EventSchema::Field const& b) {
+    return a.name < b.name;
+}
+
+}
+
+EventSchema::EventSchema(std::vector<Field> const& fields) : _fields(fields) {
+    std::sort(_fields.begin(), _fields.end(), fieldOrder);
+
+    // FNV-1a over each name, a separator and the type tag
+    unsigned long long hash = 14695981039346656037ULL;
+    for (Field const& field : _fields) {
+        for (char c : field.name) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+        }
+        hash = (hash ^ 0) * 1099511628211ULL;
+        hash = (hash ^ field.tag) * 1099511628211ULL;
+    }
+    _id = hash;
+}
+
+PTR(EventSchema) EventSchema::create(PropertySet const& ps) {
+    std::vector<Field> fields;
+    addFields(ps, "", fields);
+    return PTR(EventSchema)(new EventSchema(fields));
+}
+
+/** private method to add the fields of ps, prefixing their names with
+  * prefix; single nested PropertySets are descended into.
+  */
+void EventSchema::addFields(PropertySet const& ps, std::string const& prefix, std::vector<Field>& fields) {
+    std::vector<std::string> names = ps.names(true);
+
+    for (std::string const& name : names) {
+        unsigned char tag = BinaryWriter::tagOf(ps, name);
+        if ((tag == BinaryWriter::PROPERTYSET) && (ps.valueCount(name) == 1)) {
+            PTR(PropertySet) nested = ps.getAsPropertySetPtr(name);
+            if (nested->nameCount() > 0) {
+                addFields(*nested, prefix+name+".", fields);
+                continue;
+            }
+        }
+        Field field;
+        field.name = prefix+name;
+        field.tag = tag;
+        fields.push_back(field);
+    }
+}
+
+PTR(EventSchema) EventSchema::read(BinaryReader& reader) {
+    std::vector<Field> fields;
+
+    unsigned long long count = reader.readVarint();
+    for (unsigned long long i = 0; i < count; i++) {
+        Field field;
+        reader.readString(field.name);
+        field.tag = reader.readByte();
+        if ((field.tag < BinaryWriter::BOOL) || (field.tag > BinaryWriter::PROPERTYSET))
+            reader.error("unknown type tag for "+field.name);
+        fields.push_back(field);
+    }
+    return PTR(EventSchema)(new EventSchema(fields));
+}
+
+void EventSchema::write(std::string& out) const {
+    BinaryWriter::writeVarint(_fields.size(), out);
+    for (Field const& field : _fields) {
+        BinaryWriter::writeString(field.name, out);
+        out.push_back(field.tag);
+    }
+}
+
+bool EventSchema::operator==(EventSchema const& other) const {
+    if (_fields.size() != other._fields.size())
+        return false;
+    for (size_t i = 0; i < _fields.size(); i++) {
+        if ((_fields[i].name != other._fields[i].name) || (_fields[i].tag != other._fields[i].tag))
+            return false;
+    }
+    return true;
+}
+
+}}}
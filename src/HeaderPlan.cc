@@ -0,0 +1,293 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file HeaderPlan.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief The compiled steps which write the header properties of an Event
+ *
+ */
+
+#include <map>
+#include <mutex>
+#include <typeinfo>
+
+#include "lsst/ctrl/events/HeaderPlan.h"
+#include "lsst/ctrl/events/CommandEvent.h"
+#include "lsst/ctrl/events/Event.h"
+#include "lsst/ctrl/events/HostTable.h"
+#include "lsst/ctrl/events/KeywordSet.h"
+#include "lsst/ctrl/events/LocationId.h"
+#include "lsst/ctrl/events/StatusEvent.h"
+
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+
+using lsst::daf::base::PropertySet;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+namespace {
+
+inline KeywordSet::Mask bit(int keyword) {
+    return 1u << keyword;
+}
+
+struct PlanCache {
+    std::mutex mutex;
+    std::map<std::string, CONST_PTR(HeaderPlan)> plans;
+};
+
+PlanCache& getCache() {
+    static PlanCache cache;
+    return cache;
+}
+
+// a code for each type which a header property may have, or '-' for a
+// keyword of the event type which it does not have, such as the location
+// of an event received with its ID left packed
+char typeCode(PropertySet const& ps, std::string const& name) {
+    if (!ps.exists(name))
+        return '-';
+    std::type_info const& t = ps.typeOf(name);
+    if (t == typeid(bool))
+        return 'b';
+    if (t == typeid(short))
+        return 's';
+    if (t == typeid(int))
+        return 'i';
+    if (t == typeid(long))
+        return 'l';
+    if (t == typeid(long long))
+        return 'L';
+    if (t == typeid(double))
+        return 'd';
+    if (t == typeid(float))
+        return 'f';
+    if (t == typeid(std::string))
+        return 'S';
+    throw LSST_EXCEPT(pexExceptions::RuntimeError,
+                      "Data type represented in " + name + " is not permitted in event header");
+}
+
+}
+
+CONST_PTR(HeaderPlan) HeaderPlan::get(Event const& event, std::string& key, bool compact) {
+    KeywordSet::Mask mask = event._keywords.mask();
+    KeywordSet::Mask missing = mask & KeywordSet::RESERVED_KEYWORDS & ~event._reserved;
+    for (int keyword = 0; missing != 0; keyword++) {
+        if (missing & bit(keyword))
+            event.checkReserved(keyword);
+    }
+
+    // the key is the mask of the keywords in the table, followed by the
+    // types of those which are properties, and the other names and types;
+    // whether locations are packed also depends on the event type
+    key.assign(1, compact ? 'c' : 'p');
+    key.append(reinterpret_cast<char const*>(&mask), sizeof(mask));
+    if (compact) {
+        KeywordSet::Mask types = event._keywords.types();
+        key.append(reinterpret_cast<char const*>(&types), sizeof(types));
+    }
+    std::string const* table = KeywordSet::names();
+    for (int keyword = 0; keyword < KeywordSet::KEYWORD_COUNT; keyword++) {
+        if (mask & ~KeywordSet::RESERVED_KEYWORDS & bit(keyword))
+            key += typeCode(*event._psp, table[keyword]);
+    }
+    for (std::string const& name : event._keywords.others()) {
+        key += name;
+        key += '\0';
+        key += typeCode(*event._psp, name);
+    }
+
+    PlanCache& cache = getCache();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        std::map<std::string, CONST_PTR(HeaderPlan)>::const_iterator it = cache.plans.find(key);
+        if (it != cache.plans.end())
+            return it->second;
+    }
+
+    CONST_PTR(HeaderPlan) plan(new HeaderPlan(event, compact));
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.plans.size() >= MAX_CACHED)
+        return plan;
+    return cache.plans.insert(std::make_pair(key, plan)).first->second;
+}
+
+size_t HeaderPlan::getCacheSize() {
+    PlanCache& cache = getCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.plans.size();
+}
+
+/** private method to compile the plan for the header properties of event,
+  * whose types have been checked by get()
+  */
+HeaderPlan::HeaderPlan(Event const& event, bool compact) : _compact(compact) {
+    KeywordSet::Mask packed = compact ? packedLocations(event) : 0;
+
+    event._keywords.forEach([this, &event, packed](std::string const& name) {
+        Step step;
+        step.name = name;
+        int keyword = KeywordSet::find(name);
+
+        // a packed location is written in the place of its host name
+        if ((keyword >= 0) && (packed & bit(keyword))) {
+            if (keyword == KeywordSet::ORIG_HOSTNAME) {
+                step.name = StatusEvent::ORIG_ID;
+                step.writer = &writeLocation<KeywordSet::ORIG_HOSTNAME, KeywordSet::ORIG_PROCESSID,
+                                             KeywordSet::ORIG_LOCALID>;
+                _steps.push_back(step);
+            } else if (keyword == KeywordSet::DEST_HOSTNAME) {
+                step.name = CommandEvent::DEST_ID;
+                step.writer = &writeLocation<KeywordSet::DEST_HOSTNAME, KeywordSet::DEST_PROCESSID,
+                                             KeywordSet::DEST_LOCALID>;
+                _steps.push_back(step);
+            }
+            return;
+        }
+
+        switch (keyword) {
+            case KeywordSet::EVENTTIME:
+                step.writer = &writeTime<&Event::_eventTime>;
+                break;
+            case KeywordSet::PUBTIME:
+                step.writer = &writeTime<&Event::_pubTime>;
+                break;
+            case KeywordSet::TYPE:
+                step.writer = &writeText<&Event::_type>;
+                break;
+            case KeywordSet::STATUS:
+                step.writer = &writeText<&Event::_status>;
+                break;
+            case KeywordSet::TOPIC:
+                step.writer = &writeText<&Event::_topic>;
+                break;
+            case KeywordSet::RUNID:
+                step.writer = &writeText<&Event::_runId>;
+                break;
+            default:
+                if (typeCode(*event._psp, name) == '-')
+                    return;
+                step.writer = propertyWriter(event, name);
+                break;
+        }
+        _steps.push_back(step);
+    });
+}
+
+/** private method to find the locations of event which can be packed: the
+  * originator or destination of its type, whose properties have the types
+  * LocationId gives them
+  * @return the mask of the keywords of those locations
+  */
+KeywordSet::Mask HeaderPlan::packedLocations(Event const& event) {
+    static int const locations[2][3] = {
+        {KeywordSet::ORIG_HOSTNAME, KeywordSet::ORIG_PROCESSID, KeywordSet::ORIG_LOCALID},
+        {KeywordSet::DEST_HOSTNAME, KeywordSet::DEST_PROCESSID, KeywordSet::DEST_LOCALID}
+    };
+
+    std::string const* table = KeywordSet::names();
+    PropertySet const& ps = *event._psp;
+    KeywordSet::Mask packed = 0;
+    for (int const* location : locations) {
+        KeywordSet::Mask keywords = bit(location[0]) | bit(location[1]) | bit(location[2]);
+        if (((event._keywords.types() & keywords) != keywords) || ((event._keywords.mask() & keywords) != keywords))
+            continue;
+        if ((typeCode(ps, table[location[0]]) == 'S') && (typeCode(ps, table[location[1]]) == 'i') &&
+            (typeCode(ps, table[location[2]]) == 'i'))
+            packed |= keywords;
+    }
+    return packed;
+}
+
+/** private method to choose the step which writes a property of the type
+  * held by event
+  */
+HeaderPlan::Writer HeaderPlan::propertyWriter(Event const& event, std::string const& name) {
+    switch (typeCode(*event._psp, name)) {
+        case 'b':
+            return &writeProperty<bool, bool, &cms::Message::setBooleanProperty>;
+        case 's':
+            return &writeProperty<short, short, &cms::Message::setShortProperty>;
+        case 'i':
+            return &writeProperty<int, int, &cms::Message::setIntProperty>;
+        case 'l':
+            return &writeProperty<long, long long, &cms::Message::setLongProperty>;
+        case 'L':
+            return &writeProperty<long long, long long, &cms::Message::setLongProperty>;
+        case 'd':
+            return &writeProperty<double, double, &cms::Message::setDoubleProperty>;
+        case 'f':
+            return &writeProperty<float, float, &cms::Message::setFloatProperty>;
+        default:
+            return &writeProperty<std::string, std::string const&, &cms::Message::setStringProperty>;
+    }
+}
+
+template<typename T, typename V, void (cms::Message::*setter)(std::string const&, V)>
+void HeaderPlan::writeProperty(Event const& event, std::string const& name, cms::Message* msg) {
+    (msg->*setter)(name, event._psp->get<T>(name));
+}
+
+template<long long Event::*member>
+void HeaderPlan::writeTime(Event const& event, std::string const& name, cms::Message* msg) {
+    msg->setLongProperty(name, event.*member);
+}
+
+template<std::string Event::*member>
+void HeaderPlan::writeText(Event const& event, std::string const& name, cms::Message* msg) {
+    msg->setStringProperty(name, event.*member);
+}
+
+template<int hostname, int pid, int local>
+void HeaderPlan::writeLocation(Event const& event, std::string const& name, cms::Message* msg) {
+    std::string const* table = KeywordSet::names();
+    PropertySet const& ps = *event._psp;
+    std::string host = ps.get<std::string>(table[hostname]);
+    int processId = ps.get<int>(table[pid]);
+    int localId = ps.get<int>(table[local]);
+
+    // a location which does not fit in an ID, or whose host shares its code
+    // with another, is sent as its properties
+    unsigned int hostCode;
+    if (!host.empty() && LocationId::fits(processId, localId) &&
+        HostTable::getDefaultHostTable().intern(host, hostCode)) {
+        msg->setLongProperty(name, LocationId::pack(hostCode, processId, localId));
+    } else {
+        msg->setStringProperty(table[hostname], host);
+        msg->setIntProperty(table[pid], processId);
+        msg->setIntProperty(table[local], localId);
+    }
+}
+
+}}}
@@ -0,0 +1,177 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file HostTable.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Per-process table of the host names in packed LocationIds
+ *
+ */
+
+#include <cstdlib>
+
+#include "lsst/ctrl/events/HostTable.h"
+#include "lsst/ctrl/events/Event.h"
+
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+namespace {
+
+/* the last host name a thread added to a table with intern(hostname, code),
+ * while the table had found the given number of conflicts */
+struct LastHost {
+    HostTable const* table;
+    size_t conflicts;
+    std::string hostname;
+    unsigned int code;
+    bool unique;
+};
+
+}
+
+HostTable::HostTable() : _conflictCount(0) {
+}
+
+HostTable& HostTable::getDefaultHostTable() {
+    static HostTable table;
+    return table;
+}
+
+unsigned int HostTable::getCode(std::string const& hostname) {
+    // 32 bit FNV-1a
+    unsigned int hash = 2166136261u;
+    for (char c : hostname) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+unsigned int HostTable::intern(std::string const& hostname) {
+    unsigned int code = getCode(hostname);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    add(code, hostname);
+    return code;
+}
+
+bool HostTable::intern(std::string const& hostname, unsigned int& code) {
+    static thread_local LastHost last = {NULL, 0, std::string(), 0, false};
+
+    size_t conflicts = _conflictCount.load();
+    if ((last.table == this) && (last.conflicts == conflicts) && (last.hostname == hostname)) {
+        code = last.code;
+        return last.unique;
+    }
+
+    code = getCode(hostname);
+    bool unique;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        add(code, hostname);
+        unique = (_conflicts.find(code) == _conflicts.end());
+        conflicts = _conflictCount.load();
+    }
+    last.table = this;
+    last.conflicts = conflicts;
+    last.hostname = hostname;
+    last.code = code;
+    last.unique = unique;
+    return unique;
+}
+
+bool HostTable::isConflicting(unsigned int code) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _conflicts.find(code) != _conflicts.end();
+}
+
+size_t HostTable::getConflictCount() const {
+    return _conflictCount.load();
+}
+
+bool HostTable::lookup(unsigned int code, std::string& hostname) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::map<unsigned int, std::string>::const_iterator it = _names.find(code);
+    if ((it == _names.end()) || (_conflicts.find(code) != _conflicts.end()))
+        return false;
+    hostname = it->second;
+    return true;
+}
+
+std::string HostTable::getDefinition(unsigned int code) {
+    std::string hostname;
+    if (!lookup(code, hostname))
+        return std::string();
+    return std::to_string(code) + " " + hostname;
+}
+
+void HostTable::define(std::string const& definitions) {
+    size_t start = 0;
+    while (start < definitions.size()) {
+        size_t end = definitions.find('\n', start);
+        if (end == std::string::npos)
+            end = definitions.size();
+        std::string line = definitions.substr(start, end - start);
+        start = end + 1;
+
+        size_t space = line.find(' ');
+        if ((space == 0) || (space == std::string::npos) || (space > 10) || (space + 1 == line.size()) ||
+            (line.find_first_not_of("0123456789") != space))
+            throw LSST_EXCEPT(pexExceptions::RuntimeError, "malformed "+Event::HOSTS+" \""+line+"\"");
+        unsigned long long code = strtoull(line.c_str(), NULL, 10);
+        if (code >= (1ull << CODE_BITS))
+            throw LSST_EXCEPT(pexExceptions::RuntimeError, "malformed "+Event::HOSTS+" \""+line+"\"");
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        add(static_cast<unsigned int>(code), line.substr(space + 1));
+    }
+}
+
+size_t HostTable::size() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _names.size();
+}
+
+/** private method to add a host with the lock held; a second name for a
+  * code marks the code as conflicting
+  */
+void HostTable::add(unsigned int code, std::string const& hostname) {
+    std::map<unsigned int, std::string>::const_iterator it = _names.find(code);
+    if (it == _names.end()) {
+        _names[code] = hostname;
+    } else if ((it->second != hostname) && _conflicts.insert(code).second) {
+        _conflictCount++;
+    }
+}
+
+}}}
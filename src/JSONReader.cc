@@ -0,0 +1,521 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file JSONReader.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Single pass decoder of JSON event bodies into PropertySets
+ *
+ */
+
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#include "boost/cstdint.hpp"
+
+#include "lsst/ctrl/events/JSONReader.h"
+#include "lsst/ctrl/events/JSONScanner.h"
+#include "lsst/ctrl/events/NameDecoder.h"
+#include "lsst/ctrl/events/NumberFormat.h"
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+namespace dafBase = lsst::daf::base;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+namespace {
+
+bool isTag(std::string const& key) {
+    switch (key.size()) {
+        case 3:
+            return key == "int";
+        case 4:
+            return key == "long" || key == "bool";
+        case 5:
+            return key == "float";
+        case 6:
+            return key == "double" || key == "string";
+        case 8:
+            return key == "datetime";
+        case 9:
+            return key == "long long";
+        default:
+            return false;
+    }
+}
+
+template<typename T>
+bool toNumber(std::string const& value, T& result) {
+    return NumberFormat::parse(value.data(), value.data() + value.size(), result);
+}
+
+/* true if key is the tag of a packed array, such as "packed double" */
+bool isPackedTag(std::string const& key) {
+    return (key.size() > 7) && (key.compare(0, 7, "packed ") == 0);
+}
+
+/* the value of each base64 digit, or -1 */
+std::vector<signed char> makeBase64Table() {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::vector<signed char> table(256, -1);
+    for (int i = 0; i < 64; i++)
+        table[static_cast<unsigned char>(alphabet[i])] = i;
+    return table;
+}
+
+/* decode base64 text into bytes; false if the text is malformed */
+bool decodeBase64(std::string const& text, std::vector<unsigned char>& bytes) {
+    static const std::vector<signed char> table = makeBase64Table();
+
+    size_t size = text.size();
+    if (size % 4 != 0)
+        return false;
+    size_t padding = 0;
+    if ((size > 0) && (text[size - 1] == '='))
+        padding = (text[size - 2] == '=') ? 2 : 1;
+
+    bytes.resize(size / 4 * 3 - padding);
+    unsigned char* out = bytes.empty() ? NULL : &bytes[0];
+    size_t written = 0;
+    for (size_t i = 0; i < size; i += 4) {
+        boost::uint32_t group = 0;
+        int count = 4;
+        for (int j = 0; j < 4; j++) {
+            unsigned char c = text[i + j];
+            if ((c == '=') && (i + 4 == size) && (j >= 4 - static_cast<int>(padding))) {
+                count--;
+                group <<= 6;
+                continue;
+            }
+            signed char v = table[c];
+            if (v < 0)
+                return false;
+            group = (group << 6) | v;
+        }
+        out[written++] = static_cast<unsigned char>(group >> 16);
+        if (count > 2)
+            out[written++] = static_cast<unsigned char>(group >> 8);
+        if (count > 3)
+            out[written++] = static_cast<unsigned char>(group);
+    }
+    return true;
+}
+
+/* load a little-endian value of size bytes from p */
+boost::uint64_t loadLittleEndian(unsigned char const* p, size_t size) {
+    boost::uint64_t value = 0;
+    for (size_t i = size; i > 0; i--)
+        value = (value << 8) | p[i - 1];
+    return value;
+}
+
+template<typename W>
+W loadLittleEndian(unsigned char const* p);
+
+template<>
+boost::int32_t loadLittleEndian<boost::int32_t>(unsigned char const* p) {
+    return static_cast<boost::int32_t>(static_cast<boost::uint32_t>(loadLittleEndian(p, 4)));
+}
+
+template<>
+boost::int64_t loadLittleEndian<boost::int64_t>(unsigned char const* p) {
+    return static_cast<boost::int64_t>(loadLittleEndian(p, 8));
+}
+
+template<>
+float loadLittleEndian<float>(unsigned char const* p) {
+    boost::uint32_t bits = static_cast<boost::uint32_t>(loadLittleEndian(p, 4));
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+template<>
+double loadLittleEndian<double>(unsigned char const* p) {
+    boost::uint64_t bits = loadLittleEndian(p, 8);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/* true if value, packed as W, fits in a T */
+template<typename T, typename W>
+bool fits(W value) {
+    return (sizeof(T) >= sizeof(W)) || ((value >= LONG_MIN) && (value <= LONG_MAX));
+}
+
+bool toBool(std::string const& value, bool& result) {
+    if (value == "true" || value == "1") {
+        result = true;
+    } else if (value == "false" || value == "0") {
+        result = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+}
+
+PTR(PropertySet) JSONReader::read(std::string const& text) {
+    PTR(PropertySet) psp(new PropertySet);
+    read(text.data(), text.size(), *psp);
+    return psp;
+}
+
+void JSONReader::read(char const* text, size_t length, PropertySet& ps) {
+    read(text, length, NULL, ps);
+}
+
+void JSONReader::read(char const* text, size_t length, std::vector<std::string> const* names, PropertySet& ps) {
+    JSONReader reader(text, length, names);
+
+    reader.skipWhitespace();
+    reader.parseObject(ps);
+    reader.skipWhitespace();
+    if (reader._pos != reader._end)
+        reader.error("unexpected text after end of object");
+}
+
+JSONReader::JSONReader(char const* text, size_t length, std::vector<std::string> const* names) :
+    _begin(text),
+    _pos(text),
+    _end(text + length),
+    _names(names)
+    {}
+
+/** private method to parse an object whose members are added to ps
+  */
+void JSONReader::parseObject(PropertySet& ps) {
+    expect('{');
+    skipWhitespace();
+    if ((_pos < _end) && (*_pos == '}')) {
+        _pos++;
+        return;
+    }
+    std::string key;
+    parseString(key);
+    parseMembers(ps, key);
+}
+
+/** private method to parse the members of an object, starting with the
+  * value of the member named key, whose name has already been read. The
+  * closing brace of the object is consumed.
+  */
+void JSONReader::parseMembers(PropertySet& ps, std::string& key) {
+    for (;;) {
+        skipWhitespace();
+        expect(':');
+        if (_names != NULL)
+            NameDecoder::expand(*_names, key);
+        parseMember(ps, key);
+        skipWhitespace();
+        if ((_pos < _end) && (*_pos == ',')) {
+            _pos++;
+            skipWhitespace();
+            parseString(key);
+        } else {
+            expect('}');
+            return;
+        }
+    }
+}
+
+/** private method to parse the value of the property called name.  This
+  * is either an object of type tagged values, such as {"int":"1","int":"2"},
+  * which are added to ps, or an object representing a nested PropertySet.
+  * The first key of the object decides which.
+  */
+void JSONReader::parseMember(PropertySet& ps, std::string const& name) {
+    skipWhitespace();
+    if ((_pos < _end) && (*_pos != '{')) {
+        // a bare value has no type tag, and has never been unmarshalled
+        parseScalar(_value);
+        return;
+    }
+    expect('{');
+    skipWhitespace();
+    if ((_pos < _end) && (*_pos == '}')) {
+        _pos++;
+        return;
+    }
+
+    parseString(_tag);
+    if (isPackedTag(_tag)) {
+        parsePacked(ps, name);
+        return;
+    }
+    if (!isTag(_tag)) {
+        PTR(PropertySet) psp(new PropertySet);
+        std::string key(_tag);
+        parseMembers(*psp, key);
+        ps.add(name, psp);
+        return;
+    }
+
+    for (;;) {
+        skipWhitespace();
+        expect(':');
+        skipWhitespace();
+        parseScalar(_value);
+        if (!addDataItem(_tag, _value, name, ps))
+            error("bad "+_tag+" value \""+_value+"\" for "+name);
+        skipWhitespace();
+        if ((_pos < _end) && (*_pos == ',')) {
+            _pos++;
+            skipWhitespace();
+            parseString(_tag);
+            if (!isTag(_tag))
+                error("unexpected key \""+_tag+"\" in values of "+name);
+        } else {
+            expect('}');
+            return;
+        }
+    }
+}
+
+/** private method to parse the value of a packed array, whose tag has
+  * already been read, adding all of its values to ps at once.  The packed
+  * value is the only member of its object.
+  */
+void JSONReader::parsePacked(PropertySet& ps, std::string const& name) {
+    skipWhitespace();
+    expect(':');
+    skipWhitespace();
+    parseString(_value);
+    if (!decodeBase64(_value, _packed))
+        error("bad "+_tag+" value for "+name);
+
+    if (_tag == "packed double") {
+        addPacked<double, double>(ps, name);
+    } else if (_tag == "packed int") {
+        addPacked<int, boost::int32_t>(ps, name);
+    } else if (_tag == "packed long long") {
+        addPacked<long long, boost::int64_t>(ps, name);
+    } else if (_tag == "packed long") {
+        addPacked<long, boost::int64_t>(ps, name);
+    } else if (_tag == "packed float") {
+        addPacked<float, float>(ps, name);
+    } else {
+        error("unknown type \""+_tag+"\" for "+name);
+    }
+
+    skipWhitespace();
+    expect('}');
+}
+
+/** private method to convert the decoded bytes of a packed array, each
+  * value stored little-endian as type W, and add them to ps as type T
+  */
+template<typename T, typename W>
+void JSONReader::addPacked(PropertySet& ps, std::string const& name) {
+    if (_packed.empty() || (_packed.size() % sizeof(W) != 0))
+        error("bad "+_tag+" length for "+name);
+
+    size_t count = _packed.size() / sizeof(W);
+    std::vector<T> values(count);
+    for (size_t i = 0; i < count; i++) {
+        W value = loadLittleEndian<W>(&_packed[i * sizeof(W)]);
+        if (!fits<T, W>(value))
+            error("bad "+_tag+" value for "+name);
+        values[i] = static_cast<T>(value);
+    }
+    ps.add(name, values);
+}
+
+/** private method to add a value to a property set
+ * \param tag the name of the data type
+ * \param value the text of the value
+ * \param name the name of the property
+ * \param ps a PropertySet to store the name and data into.
+ * \return true if value could be converted and was added to the PropertySet
+  */
+bool JSONReader::addDataItem(std::string const& tag, std::string const& value, std::string const& name, PropertySet& ps) {
+    if (tag == "string") {
+        ps.add(name, value);
+    } else if (tag == "double") {
+        double d;
+        if (!toNumber(value, d))
+            return false;
+        ps.add(name, d);
+    } else if (tag == "int") {
+        int i;
+        if (!toNumber(value, i))
+            return false;
+        ps.add(name, i);
+    } else if (tag == "long long") {
+        long long ll;
+        if (!toNumber(value, ll))
+            return false;
+        ps.add(name, ll);
+    } else if (tag == "long") {
+        long l;
+        if (!toNumber(value, l))
+            return false;
+        ps.add(name, l);
+    } else if (tag == "float") {
+        float f;
+        if (!toNumber(value, f))
+            return false;
+        ps.add(name, f);
+    } else if (tag == "bool") {
+        bool b;
+        if (!toBool(value, b))
+            return false;
+        ps.add(name, b);
+    } else if (tag == "datetime") {
+        long long nsecs;
+        if (!toNumber(value, nsecs))
+            return false;
+        ps.add(name, dafBase::DateTime(nsecs, dafBase::DateTime::UTC));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/** private method to parse a quoted string, decoding escapes, into out
+  */
+void JSONReader::parseString(std::string& out) {
+    expect('"');
+    out.clear();
+    for (;;) {
+        char const* start = _pos;
+        _pos = JSONScanner::findQuoteOrEscape(_pos, _end);
+        out.append(start, _pos - start);
+
+        if (_pos >= _end)
+            error("unterminated string");
+        if (*_pos++ == '"')
+            return;
+
+        if (_pos >= _end)
+            error("unterminated string");
+        char c = *_pos++;
+        switch (c) {
+            case '"':  out.push_back('"'); break;
+            case '\\': out.push_back('\\'); break;
+            case '/':  out.push_back('/'); break;
+            case 'b':  out.push_back('\b'); break;
+            case 'f':  out.push_back('\f'); break;
+            case 'n':  out.push_back('\n'); break;
+            case 'r':  out.push_back('\r'); break;
+            case 't':  out.push_back('\t'); break;
+            case 'u':  parseUnicodeEscape(out); break;
+            default:
+                error("bad escape sequence");
+        }
+    }
+}
+
+/** private method to decode the four hex digits following \\u, storing
+  * the code point as UTF-8
+  */
+void JSONReader::parseUnicodeEscape(std::string& out) {
+    unsigned long code = 0;
+    for (int i = 0; i < 4; i++) {
+        if (_pos >= _end)
+            error("unterminated string");
+        char c = *_pos++;
+        code <<= 4;
+        if (c >= '0' && c <= '9')
+            code |= c - '0';
+        else if (c >= 'a' && c <= 'f')
+            code |= c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+            code |= c - 'A' + 10;
+        else
+            error("bad unicode escape");
+    }
+
+    // combine a surrogate pair
+    if ((code >= 0xD800) && (code <= 0xDBFF) && (_end - _pos >= 6) && (_pos[0] == '\\') && (_pos[1] == 'u')) {
+        unsigned long low = strtoul(std::string(_pos + 2, 4).c_str(), NULL, 16);
+        if ((low >= 0xDC00) && (low <= 0xDFFF)) {
+            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+            _pos += 6;
+        }
+    }
+
+    if (code < 0x80) {
+        out.push_back(static_cast<char>(code));
+    } else if (code < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else if (code < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
+
+/** private method to parse a value, either a quoted string or a bare
+  * literal such as a number, into out
+  */
+void JSONReader::parseScalar(std::string& out) {
+    if ((_pos < _end) && (*_pos == '"')) {
+        parseString(out);
+        return;
+    }
+    char const* start = _pos;
+    while ((_pos < _end) && (*_pos != ',') && (*_pos != '}') && (*_pos != ']') &&
+           (*_pos != ' ') && (*_pos != '\t') && (*_pos != '\n') && (*_pos != '\r'))
+        _pos++;
+    if (_pos == start)
+        error("missing value");
+    out.assign(start, _pos - start);
+}
+
+void JSONReader::skipWhitespace() {
+    while ((_pos < _end) && ((*_pos == ' ') || (*_pos == '\t') || (*_pos == '\n') || (*_pos == '\r')))
+        _pos++;
+}
+
+void JSONReader::expect(char c) {
+    if ((_pos >= _end) || (*_pos != c))
+        error(std::string("expected '")+c+"'");
+    _pos++;
+}
+
+void JSONReader::error(std::string const& reason) {
+    std::ostringstream msg;
+    msg << "Couldn't unmarshall event: " << reason << " at offset " << (_pos - _begin);
+    throw LSST_EXCEPT(pexExceptions::RuntimeError, msg.str());
+}
+
+}}}
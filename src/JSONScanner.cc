@@ -0,0 +1,263 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file JSONScanner.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Scanning and number conversion primitives for JSON event bodies
+ *
+ */
+
+#include <cfloat>
+
+#include "lsst/ctrl/events/JSONScanner.h"
+
+#include "lsst/pex/exceptions.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LSST_CTRL_EVENTS_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace pexExceptions = lsst::pex::exceptions;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+namespace {
+
+char const* findScalar(char const* pos, char const* end) {
+    while ((pos < end) && (*pos != '"') && (*pos != '\\'))
+        pos++;
+    return pos;
+}
+
+#ifdef LSST_CTRL_EVENTS_X86_SIMD
+
+__attribute__((target("sse2")))
+char const* findSse2(char const* pos, char const* end) {
+    __m128i const quote = _mm_set1_epi8('"');
+    __m128i const escape = _mm_set1_epi8('\\');
+    while (end - pos >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(pos));
+        unsigned mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, escape)));
+        if (mask != 0)
+            return pos + __builtin_ctz(mask);
+        pos += 16;
+    }
+    return findScalar(pos, end);
+}
+
+__attribute__((target("avx2")))
+char const* findAvx2(char const* pos, char const* end) {
+    __m256i const quote = _mm256_set1_epi8('"');
+    __m256i const escape = _mm256_set1_epi8('\\');
+    while (end - pos >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(pos));
+        unsigned mask = _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(block, quote), _mm256_cmpeq_epi8(block, escape)));
+        if (mask != 0)
+            return pos + __builtin_ctz(mask);
+        pos += 32;
+    }
+    return findSse2(pos, end);
+}
+
+bool hasSse2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+}
+
+bool hasAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif
+
+typedef char const* (*FindFunction)(char const*, char const*);
+
+FindFunction selectFind(std::string const& name) {
+    if (name == "scalar")
+        return findScalar;
+#ifdef LSST_CTRL_EVENTS_X86_SIMD
+    if ((name == "sse2") && hasSse2())
+        return findSse2;
+    if ((name == "avx2") && hasAvx2())
+        return findAvx2;
+#endif
+    return NULL;
+}
+
+std::string const& bestImplementation() {
+    static std::string const best =
+#ifdef LSST_CTRL_EVENTS_X86_SIMD
+        hasAvx2() ? "avx2" : hasSse2() ? "sse2" :
+#endif
+        "scalar";
+    return best;
+}
+
+// powers of ten which are exactly representable as doubles
+double const exactPowers[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+}
+
+std::atomic<JSONScanner::FindFunction> JSONScanner::_findQuoteOrEscape(JSONScanner::findFirst);
+
+/** private method called on first use, which replaces itself with the best
+  * implementation unless setImplementation has already chosen one
+  */
+char const* JSONScanner::findFirst(char const* pos, char const* end) {
+    FindFunction expected = findFirst;
+    _findQuoteOrEscape.compare_exchange_strong(expected, selectFind(bestImplementation()),
+                                               std::memory_order_acq_rel);
+    return findQuoteOrEscape(pos, end);
+}
+
+std::string JSONScanner::getImplementation() {
+    FindFunction find = _findQuoteOrEscape.load(std::memory_order_acquire);
+    if (find == findFirst)
+        return bestImplementation();
+    if (find == findScalar)
+        return "scalar";
+#ifdef LSST_CTRL_EVENTS_X86_SIMD
+    if (find == findSse2)
+        return "sse2";
+    if (find == findAvx2)
+        return "avx2";
+#endif
+    return "unknown";
+}
+
+void JSONScanner::setImplementation(std::string const& name) {
+    FindFunction find = selectFind(name);
+    if (find == NULL)
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "JSON scanner implementation \""+name+"\" is not supported");
+    _findQuoteOrEscape.store(find, std::memory_order_release);
+}
+
+bool JSONScanner::parseInteger(char const* begin, char const* end, long long& result) {
+    char const* pos = begin;
+    bool negative = (pos < end) && (*pos == '-');
+    if (negative)
+        pos++;
+
+    // 18 digits can not overflow
+    if ((pos == end) || (end - pos > 18))
+        return false;
+
+    long long value = 0;
+    for (; pos < end; pos++) {
+        unsigned digit = static_cast<unsigned char>(*pos) - '0';
+        if (digit > 9)
+            return false;
+        value = value * 10 + digit;
+    }
+    result = negative ? -value : value;
+    return true;
+}
+
+bool JSONScanner::parseDouble(char const* begin, char const* end, double& result) {
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+    char const* pos = begin;
+    bool negative = (pos < end) && (*pos == '-');
+    if (negative)
+        pos++;
+
+    unsigned long long mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool any = false;
+
+    for (; (pos < end) && (*pos >= '0') && (*pos <= '9'); pos++) {
+        any = true;
+        if ((mantissa == 0) && (*pos == '0'))
+            continue;
+        if (++digits > 19)
+            return false;
+        mantissa = mantissa * 10 + (*pos - '0');
+    }
+    if ((pos < end) && (*pos == '.')) {
+        pos++;
+        for (; (pos < end) && (*pos >= '0') && (*pos <= '9'); pos++) {
+            any = true;
+            exponent--;
+            if ((mantissa == 0) && (*pos == '0'))
+                continue;
+            if (++digits > 19)
+                return false;
+            mantissa = mantissa * 10 + (*pos - '0');
+        }
+    }
+    if (!any)
+        return false;
+
+    if ((pos < end) && ((*pos == 'e') || (*pos == 'E'))) {
+        pos++;
+        bool negativeExponent = false;
+        if ((pos < end) && ((*pos == '+') || (*pos == '-'))) {
+            negativeExponent = (*pos == '-');
+            pos++;
+        }
+        if ((pos == end) || (end - pos > 4))
+            return false;
+        int value = 0;
+        for (; pos < end; pos++) {
+            unsigned digit = static_cast<unsigned char>(*pos) - '0';
+            if (digit > 9)
+                return false;
+            value = value * 10 + digit;
+        }
+        exponent += negativeExponent ? -value : value;
+    }
+    if (pos != end)
+        return false;
+
+    if (mantissa > (1ULL << 53))
+        return false;
+
+    double value = static_cast<double>(mantissa);
+    if (mantissa == 0) {
+        value = 0.0;
+    } else if ((exponent >= 0) && (exponent <= 22)) {
+        value *= exactPowers[exponent];
+    } else if ((exponent < 0) && (exponent >= -22)) {
+        value /= exactPowers[-exponent];
+    } else {
+        return false;
+    }
+    result = negative ? -value : value;
+    return true;
+#else
+    return false;
+#endif
+}
+
+}}}
@@ -0,0 +1,343 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file JSONWriter.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Single pass writer of PropertySets into JSON event bodies
+ *
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "boost/cstdint.hpp"
+
+#include "lsst/ctrl/events/JSONWriter.h"
+#include "lsst/ctrl/events/NumberFormat.h"
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+namespace dafBase = lsst::daf::base;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+namespace {
+
+/* average number of characters used for a tag and value, used to size the output buffer */
+const size_t VALUE_SIZE_ESTIMATE = 24;
+
+void appendValue(bool value, std::string& out) {
+    if (value)
+        out.append("true", 4);
+    else
+        out.append("false", 5);
+}
+
+void appendValue(long long value, std::string& out) {
+    char buf[NumberFormat::MAX_LENGTH];
+    out.append(buf, NumberFormat::format(value, buf));
+}
+
+void appendValue(int value, std::string& out) {
+    appendValue((long long)value, out);
+}
+
+void appendValue(long value, std::string& out) {
+    appendValue((long long)value, out);
+}
+
+void appendValue(double value, std::string& out) {
+    char buf[NumberFormat::MAX_LENGTH];
+    out.append(buf, NumberFormat::format(value, buf));
+}
+
+void appendValue(float value, std::string& out) {
+    char buf[NumberFormat::MAX_LENGTH];
+    out.append(buf, NumberFormat::format(value, buf));
+}
+
+/* store value little-endian at p */
+void storeLittleEndian(boost::uint32_t value, unsigned char* p) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+void storeLittleEndian(boost::uint64_t value, unsigned char* p) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+template<typename W>
+void storeLittleEndian(W value, unsigned char* p);
+
+template<>
+void storeLittleEndian<boost::int32_t>(boost::int32_t value, unsigned char* p) {
+    storeLittleEndian(static_cast<boost::uint32_t>(value), p);
+}
+
+template<>
+void storeLittleEndian<boost::int64_t>(boost::int64_t value, unsigned char* p) {
+    storeLittleEndian(static_cast<boost::uint64_t>(value), p);
+}
+
+template<>
+void storeLittleEndian<float>(float value, unsigned char* p) {
+    boost::uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    storeLittleEndian(bits, p);
+}
+
+template<>
+void storeLittleEndian<double>(double value, unsigned char* p) {
+    boost::uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    storeLittleEndian(bits, p);
+}
+
+void appendBase64(std::vector<unsigned char> const& bytes, std::string& out) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    size_t i = 0;
+    size_t size = bytes.size();
+    out.reserve(out.size() + (size + 2) / 3 * 4);
+    for (; i + 3 <= size; i += 3) {
+        boost::uint32_t group = (bytes[i] << 16) | (bytes[i + 1] << 8) | bytes[i + 2];
+        out.push_back(alphabet[(group >> 18) & 0x3f]);
+        out.push_back(alphabet[(group >> 12) & 0x3f]);
+        out.push_back(alphabet[(group >> 6) & 0x3f]);
+        out.push_back(alphabet[group & 0x3f]);
+    }
+    if (i < size) {
+        boost::uint32_t group = bytes[i] << 16;
+        if (i + 1 < size)
+            group |= bytes[i + 1] << 8;
+        out.push_back(alphabet[(group >> 18) & 0x3f]);
+        out.push_back(alphabet[(group >> 12) & 0x3f]);
+        out.push_back((i + 1 < size) ? alphabet[(group >> 6) & 0x3f] : '=');
+        out.push_back('=');
+    }
+}
+
+}
+
+JSONWriter::JSONWriter() {
+}
+
+JSONWriter::~JSONWriter() {
+}
+
+std::string JSONWriter::write(PropertySet const& ps, bool pack) {
+    std::string out;
+    write(ps, out, pack);
+    return out;
+}
+
+void JSONWriter::write(PropertySet const& ps, std::string& out, bool pack) {
+    out.clear();
+    out.reserve(estimateSize(ps));
+    writePropertySet(ps, NULL, pack, out);
+}
+
+void JSONWriter::write(PropertySet const& ps, NameEncoder& encoder, std::string& out, bool pack) {
+    out.clear();
+    out.reserve(estimateSize(ps));
+    writePropertySet(ps, &encoder, pack, out);
+}
+
+/** private method to estimate the size of the JSON text for a PropertySet
+  * \param ps the PropertySet to be written
+  * \return the estimated number of characters
+  */
+size_t JSONWriter::estimateSize(PropertySet const& ps) {
+    size_t size = 2;
+    std::vector<std::string> names = ps.paramNames(false);
+    for (std::string const& name : names) {
+        size += name.size() + 6 + ps.valueCount(name) * VALUE_SIZE_ESTIMATE;
+    }
+    return size;
+}
+
+/** private method to write a PropertySet as a JSON object; nested
+  * PropertySets are written as nested objects.  If encoder is not NULL,
+  * property names are written as it encodes them.
+  */
+void JSONWriter::writePropertySet(PropertySet const& ps, NameEncoder* encoder, bool pack, std::string& out) {
+    std::vector<std::string> names = ps.names(true);
+
+    out.push_back('{');
+    bool first = true;
+    for (std::string const& name : names) {
+        if (ps.isPropertySetPtr(name)) {
+            PTR(PropertySet) child = ps.getAsPropertySetPtr(name);
+            // empty PropertySets have never been transmitted
+            if ((child == 0) || (child->nameCount(false) == 0))
+                continue;
+            if (!first)
+                out.push_back(',');
+            first = false;
+            writeString((encoder != NULL) ? encoder->encode(name) : name, out);
+            out.push_back(':');
+            writePropertySet(*child, encoder, pack, out);
+        } else {
+            if (!first)
+                out.push_back(',');
+            first = false;
+            writeString((encoder != NULL) ? encoder->encode(name) : name, out);
+            out.push_back(':');
+            writeValues(ps, name, pack, out);
+        }
+    }
+    out.push_back('}');
+}
+
+/** private method to write all values of name as an object of type tagged values
+  */
+void JSONWriter::writeValues(PropertySet const& ps, std::string const& name, bool pack, std::string& out) {
+    std::type_info const& t = ps.typeOf(name);
+    if (t == typeid(bool)) {
+        writeArray<bool>(ps.getArray<bool>(name), "\"bool\":\"", out);
+    } else if (t == typeid(long)) {
+        writeNumbers<long, boost::int64_t>(ps, name, "\"long\":\"", "\"packed long\":\"", pack, out);
+    } else if (t == typeid(long long)) {
+        writeNumbers<long long, boost::int64_t>(ps, name, "\"long long\":\"", "\"packed long long\":\"", pack, out);
+    } else if (t == typeid(int)) {
+        writeNumbers<int, boost::int32_t>(ps, name, "\"int\":\"", "\"packed int\":\"", pack, out);
+    } else if (t == typeid(float)) {
+        writeNumbers<float, float>(ps, name, "\"float\":\"", "\"packed float\":\"", pack, out);
+    } else if (t == typeid(double)) {
+        writeNumbers<double, double>(ps, name, "\"double\":\"", "\"packed double\":\"", pack, out);
+    } else if (t == typeid(std::string)) {
+        std::vector<std::string> vec = ps.getArray<std::string>(name);
+        out.push_back('{');
+        for (size_t i = 0; i < vec.size(); i++) {
+            if (i > 0)
+                out.push_back(',');
+            out.append("\"string\":", 9);
+            writeString(vec[i], out);
+        }
+        out.push_back('}');
+    } else if (t == typeid(dafBase::DateTime)) {
+        std::vector<dafBase::DateTime> vec = ps.getArray<dafBase::DateTime>(name);
+        out.push_back('{');
+        for (size_t i = 0; i < vec.size(); i++) {
+            if (i > 0)
+                out.push_back(',');
+            out.append("\"datetime\":\"", 12);
+            appendValue(vec[i].nsecs(), out);
+            out.push_back('"');
+        }
+        out.push_back('}');
+    } else {
+        std::string msg("Couldn't marshall "+name);
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, msg);
+    }
+}
+
+/** private method to write the numeric values of name, packed if pack is
+  * set and there are at least PACK_THRESHOLD of them; W is the type each
+  * value is packed as.
+  */
+template<typename T, typename W>
+void JSONWriter::writeNumbers(PropertySet const& ps, std::string const& name, char const* tag, char const* packedTag,
+                              bool pack, std::string& out) {
+    std::vector<T> vec = ps.getArray<T>(name);
+
+    if (pack && (vec.size() >= PACK_THRESHOLD))
+        writePacked<T, W>(vec, packedTag, out);
+    else
+        writeArray<T>(vec, tag, out);
+}
+
+/** private method to write values as a single item holding the base64
+  * encoding of their little-endian representation as type W; tag is the
+  * opening of the item up to, and including, the quote which begins the value.
+  */
+template<typename T, typename W>
+void JSONWriter::writePacked(std::vector<T> const& vec, char const* tag, std::string& out) {
+    std::vector<unsigned char> bytes(vec.size() * sizeof(W));
+    for (size_t i = 0; i < vec.size(); i++) {
+        storeLittleEndian<W>(static_cast<W>(vec[i]), &bytes[i * sizeof(W)]);
+    }
+
+    out.push_back('{');
+    out.append(tag);
+    appendBase64(bytes, out);
+    out.append("\"}", 2);
+}
+
+/** private method to write values of type T; tag is the opening of each
+  * item up to, and including, the quote which begins the value.
+  */
+template<typename T>
+void JSONWriter::writeArray(std::vector<T> const& vec, char const* tag, std::string& out) {
+    out.push_back('{');
+    for (size_t i = 0; i < vec.size(); i++) {
+        if (i > 0)
+            out.push_back(',');
+        out.append(tag);
+        appendValue(vec[i], out);
+        out.push_back('"');
+    }
+    out.push_back('}');
+}
+
+void JSONWriter::writeString(std::string const& value, std::string& out) {
+    static const char hex[] = "0123456789ABCDEF";
+
+    out.push_back('"');
+    for (std::string::const_iterator iter = value.begin(); iter != value.end(); ++iter) {
+        unsigned char c = *iter;
+        switch (c) {
+            case '"':  out.append("\\\"", 2); break;
+            case '\\': out.append("\\\\", 2); break;
+            case '/':  out.append("\\/", 2); break;
+            case '\b': out.append("\\b", 2); break;
+            case '\f': out.append("\\f", 2); break;
+            case '\n': out.append("\\n", 2); break;
+            case '\r': out.append("\\r", 2); break;
+            case '\t': out.append("\\t", 2); break;
+            default:
+                if (c < 0x20) {
+                    out.append("\\u00", 4);
+                    out.push_back(hex[c >> 4]);
+                    out.push_back(hex[c & 0xf]);
+                } else {
+                    out.push_back(c);
+                }
+                break;
+        }
+    }
+    out.push_back('"');
+}
+
+}}}
@@ -0,0 +1,100 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file KeywordSet.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief The names of the header properties of an Event
+ *
+ */
+
+#include <algorithm>
+
+#include "lsst/ctrl/events/KeywordSet.h"
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+namespace {
+
+// the same values as the constants of the event classes, which are not
+// used here because they may not be constructed yet
+char const* const KEYWORD_NAMES[KeywordSet::KEYWORD_COUNT] = {
+    "DEST_HOSTNAME", "DEST_LOCALID", "DEST_PROCESSID", "EVENTTIME", "LEVEL", "LOGGER",
+    "ORIG_HOSTNAME", "ORIG_LOCALID", "ORIG_PROCESSID", "PUBTIME", "RUNID", "STATUS",
+    "TOPIC", "TYPE"
+};
+
+}
+
+std::string const* KeywordSet::names() {
+    static std::vector<std::string> const table(KEYWORD_NAMES, KEYWORD_NAMES + KEYWORD_COUNT);
+    return table.data();
+}
+
+int KeywordSet::find(std::string const& name) {
+    int low = 0;
+    int high = KEYWORD_COUNT;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        int order = name.compare(KEYWORD_NAMES[mid]);
+        if (order == 0)
+            return mid;
+        if (order < 0)
+            high = mid;
+        else
+            low = mid + 1;
+    }
+    return -1;
+}
+
+void KeywordSet::insert(std::string const& name) {
+    int keyword = find(name);
+    if (keyword >= 0) {
+        _mask |= (1u << keyword);
+        return;
+    }
+    std::vector<std::string>::iterator it = std::lower_bound(_others.begin(), _others.end(), name);
+    if ((it == _others.end()) || (*it != name))
+        _others.insert(it, name);
+}
+
+bool KeywordSet::contains(std::string const& name) const {
+    int keyword = find(name);
+    if (keyword >= 0)
+        return (_mask & (1u << keyword)) != 0;
+    return std::binary_search(_others.begin(), _others.end(), name);
+}
+
+size_t KeywordSet::size() const {
+    size_t count = _others.size();
+    for (Mask mask = _mask; mask != 0; mask &= mask - 1)
+        count++;
+    return count;
+}
+
+}}}
@@ -33,6 +33,7 @@
 
 #include "lsst/ctrl/events/LocationId.h"
 #include "lsst/ctrl/events/Host.h"
+#include "lsst/ctrl/events/HostTable.h"
 
 namespace lsst {
 namespace ctrl {
@@ -43,21 +44,34 @@ LocationId::LocationId() {
     _hostname = host.getHostName();
     _pid = getpid();
     _localID = _localCounter++;
+
+    // the name of this host is only added to the table once
+    static unsigned int const hostCode = HostTable::getDefaultHostTable().intern(_hostname);
+    _id = fits(_pid, _localID) ? pack(hostCode, _pid, _localID) : -1;
 }
 
+// the host is added to the table when a location on it is first sent packed
 LocationId::LocationId(std::string const& hostname, int pid, int localID) : 
     _hostname(hostname),
     _pid(pid),
-    _localID(localID) 
+    _localID(localID),
+    _id(fits(pid, localID) ? pack(HostTable::getCode(hostname), pid, localID) : -1)
     {}
 
+LocationId::LocationId(long long id) : _id(id) {
+    HostTable::getDefaultHostTable().lookup(getHostCode(id), _hostname);
+    _pid = static_cast<int>((id >> LOCAL_BITS) & ((1 << PID_BITS) - 1));
+    _localID = static_cast<int>(id & ((1 << LOCAL_BITS) - 1));
+}
+
 LocationId::LocationId(LocationId const& id) {
     _hostname = id.getHostName();
     _pid = id.getProcessID();
     _localID = id.getLocalID();
+    _id = id.getId();
 }
 
-int LocationId::_localCounter = 0;
+std::atomic<int> LocationId::_localCounter(0);
 
 std::string LocationId::getHostName() const {
     return _hostname;
@@ -71,4 +85,22 @@ int LocationId::getLocalID() const {
     return _localID;
 }
 
+long long LocationId::getId() const {
+    return _id;
+}
+
+bool LocationId::fits(int pid, int localID) {
+    return (pid >= 0) && (pid < (1 << PID_BITS)) && (localID >= 0) && (localID < (1 << LOCAL_BITS));
+}
+
+long long LocationId::pack(unsigned int hostCode, int pid, int localID) {
+    return (static_cast<long long>(hostCode) << (PID_BITS + LOCAL_BITS)) |
+           (static_cast<long long>(pid & ((1 << PID_BITS) - 1)) << LOCAL_BITS) |
+           (localID & ((1 << LOCAL_BITS) - 1));
+}
+
+unsigned int LocationId::getHostCode(long long id) {
+    return static_cast<unsigned int>(id >> (PID_BITS + LOCAL_BITS));
+}
+
 }}}
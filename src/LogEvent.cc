@@ -31,6 +31,7 @@
  *
  */
 #include <iomanip>
+#include <utility>
 
 #include "lsst/ctrl/events/EventTypes.h"
 #include "lsst/ctrl/events/LogEvent.h"
@@ -68,63 +69,75 @@ LogEvent::LogEvent(LocationId const& originatorId, PropertySet const& ps) : Stat
 
     //# TODO: don't set this in EventAppender
 
-    _psp->set(LogEvent::TYPE, EventTypes::LOG);
+    _setType(EventTypes::LOG);
 }
 
+LogEvent::LogEvent(LocationId const& originatorId, PTR(PropertySet)&& psp) : StatusEvent(originatorId, std::move(psp)) {
+    _init();
 
-/** private method to add keywords used in LogEvent JMS headers
-  */
-void LogEvent::_init() {
-    _keywords.insert(LogEvent::LEVEL);
-    _keywords.insert(LogEvent::LOGGER);
+    _setType(EventTypes::LOG);
 }
 
+LogEvent::LogEvent(LocationId const& originatorId, PTR(PropertySet)&& psp, PropertySet const& filterable) :
+    StatusEvent(originatorId, std::move(psp), filterable) {
+    _init();
+
+    _setType(EventTypes::LOG);
+}
 
-/** 
- * @brief Constructor to take a JMS TextMessage and turn it into a LogEvent
- * @param msg a TextMessage
- */
-LogEvent::LogEvent(cms::TextMessage *msg) : StatusEvent(msg) {
+LogEvent::LogEvent(std::string const& runid, LocationId const& originatorId, PTR(PropertySet)&& psp) :
+    StatusEvent(runid, originatorId, std::move(psp)) {
     _init();
 
-    _psp->set(LogEvent::LEVEL, msg->getIntProperty(LogEvent::LEVEL));
-    _psp->set(LogEvent::LOGGER, msg->getStringProperty(LogEvent::LOGGER));
+    _setType(EventTypes::LOG);
+}
 
+LogEvent::LogEvent(std::string const& runid, LocationId const& originatorId, PTR(PropertySet)&& psp,
+                   PropertySet const& filterable) : StatusEvent(runid, originatorId, std::move(psp), filterable) {
+    _init();
 
+    _setType(EventTypes::LOG);
 }
 
-/** private method used to populate the LogEvent
-  */
 
-void LogEvent::populateHeader(cms::TextMessage* msg) const {
-    StatusEvent::populateHeader(msg);
+/** private method to add keywords used in LogEvent JMS headers
+  */
+void LogEvent::_init() {
+    _keywords.add(KeywordSet::LOG_KEYWORDS);
+}
 
-    msg->setIntProperty(LogEvent::LEVEL, _psp->get<int>(LogEvent::LEVEL));
-    msg->setStringProperty(LogEvent::LOGGER, _psp->get<std::string>(LogEvent::LOGGER));
 
+/** 
+ * @brief Constructor to take a JMS Message and turn it into a LogEvent;
+ *        the LEVEL and LOGGER header properties have already been copied by
+ *        Event(msg), and are only marked as the keywords of this type
+ * @param msg a cms::Message
+ */
+LogEvent::LogEvent(cms::Message *msg) : StatusEvent(msg) {
+    _init();
 }
 
 /** 
  * @brief retreive the log level
  * @return the logging level at which the LogRecord message was set
  */
-int LogEvent::getLevel() {
-    return _psp->get<int>(LogEvent::LEVEL);
+int LogEvent::getLevel() const {
+    return _properties()->get<int>(LogEvent::LEVEL);
 }
 
 /** 
  * @brief Retreive the log message 
  * @return a string containing the log message itself
  */
-std::string LogEvent::getLogger() {
-    return _psp->get<std::string>(LogEvent::LOGGER);
+std::string LogEvent::getLogger() const {
+    return _properties()->get<std::string>(LogEvent::LOGGER);
 }
 
 /** 
  * @brief Retreive the log message 
  * @return a string containing the log message itself
  */
-std::string LogEvent::getLoggingTopic() {
+std::string const& LogEvent::getLoggingTopic() const {
     return LogEvent::LOGGING_TOPIC;
 }
 
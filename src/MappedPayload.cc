@@ -0,0 +1,84 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file MappedPayload.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Read-only memory mapping of claim check files
+ *
+ */
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "lsst/ctrl/events/MappedPayload.h"
+
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+MappedPayload::MappedPayload(std::string const& path) : _data(NULL), _size(0) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "Couldn't read claimed event payload "+path+": "+
+                          strerror(errno));
+
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        std::string msg = "Couldn't read claimed event payload "+path+": "+strerror(errno);
+        close(fd);
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, msg);
+    }
+
+    // an empty file can not be mapped, and needs no mapping
+    if (status.st_size > 0) {
+        void* data = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            std::string msg = "Couldn't map claimed event payload "+path+": "+strerror(errno);
+            close(fd);
+            throw LSST_EXCEPT(pexExceptions::RuntimeError, msg);
+        }
+        _data = static_cast<unsigned char const*>(data);
+        _size = status.st_size;
+    }
+    close(fd);
+}
+
+MappedPayload::~MappedPayload() {
+    if (_data != NULL)
+        munmap(const_cast<unsigned char*>(_data), _size);
+}
+
+}}}
@@ -0,0 +1,143 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file NameDecoder.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Expansion of the property name codes written by NameEncoder
+ *
+ */
+
+#include <cstdlib>
+
+#include "lsst/ctrl/events/NameDecoder.h"
+#include "lsst/ctrl/events/Event.h"
+
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+namespace {
+
+/* parse text, which must be all decimal digits, into value */
+bool parseCount(std::string const& text, size_t& value) {
+    if (text.empty() || (text.size() > 9) || (text.find_first_not_of("0123456789") != std::string::npos))
+        return false;
+    value = strtoul(text.c_str(), NULL, 10);
+    return true;
+}
+
+}
+
+NameDecoder::NameDecoder() : _clock(0) {
+}
+
+bool NameDecoder::read(Event& event, std::string const& dictionary, std::string const& definitions) {
+    size_t colon = dictionary.rfind(':');
+    size_t size;
+    if ((colon == std::string::npos) || !parseCount(dictionary.substr(colon + 1), size))
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "malformed "+Event::DICTIONARY+" \""+dictionary+"\"");
+    std::string id = dictionary.substr(0, colon);
+
+    std::map<std::string, State>::iterator it = _dictionaries.find(id);
+    if (it == _dictionaries.end()) {
+        if (_dictionaries.size() >= MAX_DICTIONARIES)
+            evict();
+        State state;
+        state.names.reset(new std::vector<std::string>);
+        it = _dictionaries.insert(std::make_pair(id, state)).first;
+    }
+    State& state = it->second;
+    state.lastUsed = ++_clock;
+
+    if (!definitions.empty()) {
+        size_t end = definitions.find('\n');
+        size_t first;
+        if ((end == std::string::npos) || !parseCount(definitions.substr(0, end), first))
+            throw LSST_EXCEPT(pexExceptions::RuntimeError, "malformed "+Event::NAMES);
+
+        // definitions which follow codes that were missed can not be used
+        if (first <= state.names->size()) {
+            // events which have already been received keep the dictionary
+            // they were given, so it is replaced rather than changed
+            PTR(std::vector<std::string>) names(new std::vector<std::string>(state.names->begin(),
+                                                                             state.names->begin() + first));
+            size_t start = end + 1;
+            for (;;) {
+                end = definitions.find('\n', start);
+                names->push_back(definitions.substr(start, end - start));
+                if (end == std::string::npos)
+                    break;
+                start = end + 1;
+            }
+            for (size_t i = names->size(); i < state.names->size(); i++)
+                names->push_back((*state.names)[i]);
+            state.names = names;
+        }
+    }
+
+    if (size > state.names->size())
+        return false;
+    event._bodyNames = state.names;
+    return true;
+}
+
+void NameDecoder::expand(std::vector<std::string> const& names, std::string& key) {
+    if (key.empty() || (key[0] != '#'))
+        return;
+    if ((key.size() > 1) && (key[1] == '#')) {
+        key.erase(0, 1);
+        return;
+    }
+
+    size_t code;
+    if (!parseCount(key.substr(1), code) || (code >= names.size()))
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "Couldn't unmarshall event: unknown property name code "+key);
+    key = names[code];
+}
+
+void NameDecoder::reset() {
+    _dictionaries.clear();
+}
+
+/** private method to forget the dictionary which has gone longest without
+  * being used
+  */
+void NameDecoder::evict() {
+    std::map<std::string, State>::iterator oldest = _dictionaries.begin();
+    for (std::map<std::string, State>::iterator it = _dictionaries.begin(); it != _dictionaries.end(); ++it) {
+        if (it->second.lastUsed < oldest->second.lastUsed)
+            oldest = it;
+    }
+    if (oldest != _dictionaries.end())
+        _dictionaries.erase(oldest);
+}
+
+}}}
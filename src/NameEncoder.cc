@@ -0,0 +1,113 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file NameEncoder.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Replacement of repeated property names by short codes
+ *
+ */
+
+#include <sstream>
+
+#include "lsst/ctrl/events/NameEncoder.h"
+#include "lsst/ctrl/events/LocationId.h"
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+namespace dafBase = lsst::daf::base;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+NameEncoder::NameEncoder() : _defined(0), _interval(DEFAULT_DEFINITION_INTERVAL), _written(0) {
+    // unique to this process, and to this start of it
+    LocationId location;
+    std::ostringstream id;
+    id << location.getHostName() << "/" << location.getProcessID() << "/" << location.getLocalID() << "/"
+       << dafBase::DateTime::now().nsecs();
+    _id = id.str();
+}
+
+std::string const& NameEncoder::encode(std::string const& name) {
+    std::map<std::string, size_t>::const_iterator it = _codes.find(name);
+    if (it != _codes.end())
+        return _keys[it->second];
+
+    if ((name.size() >= MIN_NAME_LENGTH) && (_names.size() < MAX_NAMES) &&
+        (name.find('\n') == std::string::npos)) {
+        if (_seen.size() >= 4 * MAX_NAMES)
+            _seen.clear();
+
+        std::map<std::string, int>::iterator seen = _seen.find(name);
+        if (seen == _seen.end()) {
+            _seen[name] = 1;
+        } else {
+            _seen.erase(seen);
+
+            std::ostringstream key;
+            key << "#" << _names.size();
+            _codes[name] = _names.size();
+            _names.push_back(name);
+            _keys.push_back(key.str());
+            return _keys.back();
+        }
+    }
+
+    if ((name.empty()) || (name[0] != '#'))
+        return name;
+    _escaped = "#" + name;
+    return _escaped;
+}
+
+void NameEncoder::finish(std::string& dictionary, std::string& definitions) {
+    size_t first = (_written++ % _interval == 0) ? 0 : _defined;
+
+    definitions.clear();
+    if (first < _names.size()) {
+        std::ostringstream text;
+        text << first;
+        for (size_t i = first; i < _names.size(); i++)
+            text << "\n" << _names[i];
+        definitions = text.str();
+    }
+    _defined = _names.size();
+
+    std::ostringstream header;
+    header << _id << ":" << _names.size();
+    dictionary = header.str();
+}
+
+void NameEncoder::setDefinitionInterval(int interval) {
+    if (interval < 1)
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "name definition interval must be at least 1");
+    _interval = interval;
+}
+
+}}}
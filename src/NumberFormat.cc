@@ -0,0 +1,318 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file NumberFormat.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Exact conversion of numbers to and from the text of JSON event bodies
+ *
+ */
+
+#include <cerrno>
+#include <cfloat>
+#include <climits>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__has_include)
+#if __has_include(<charconv>) && (__cplusplus >= 201703L)
+#include <charconv>
+#endif
+#endif
+
+#if defined(__cpp_lib_to_chars) && (__cpp_lib_to_chars >= 201611L)
+#define LSST_CTRL_EVENTS_CHARCONV 1
+#endif
+
+#include "lsst/ctrl/events/NumberFormat.h"
+#include "lsst/ctrl/events/JSONScanner.h"
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+namespace {
+
+/* numbers longer than this are copied to the heap to be terminated for strtod */
+const size_t TEXT_SIZE = 64;
+
+/* write the decimal digits of value so that they end at end
+ * @return the position of the first digit */
+char* writeDigits(unsigned long long value, char* end) {
+    do {
+        *--end = '0' + (value % 10);
+        value /= 10;
+    } while (value != 0);
+    return end;
+}
+
+/* get a terminated copy of [begin, end) in text, or in spill if it is too long */
+char const* terminate(char const* begin, char const* end, char* text, std::string& spill) {
+    size_t length = end - begin;
+    if (length < TEXT_SIZE) {
+        memcpy(text, begin, length);
+        text[length] = '\0';
+        return text;
+    }
+    spill.assign(begin, length);
+    return spill.c_str();
+}
+
+/* true if the conversion which stopped at stop consumed all of the length
+ * characters of text, other than trailing whitespace */
+bool consumed(char const* text, size_t length, char const* stop) {
+    if (stop == text)
+        return false;
+    while ((*stop == ' ') || (*stop == '\t') || (*stop == '\n') || (*stop == '\r'))
+        stop++;
+    return stop == text + length;
+}
+
+/* convert [begin, end) with strtod or strtof, which are told about a decimal
+ * point other than '.' in the current locale */
+template<typename T>
+bool parseStdio(char const* begin, char const* end, T (*convert)(char const*, char**), T& result) {
+    char buf[TEXT_SIZE];
+    std::string spill;
+    char* text = const_cast<char*>(terminate(begin, end, buf, spill));
+
+    char point = *localeconv()->decimal_point;
+    if (point != '.') {
+        for (char* p = text; *p != '\0'; p++) {
+            if (*p == point)
+                return false;
+            if (*p == '.')
+                *p = point;
+        }
+    }
+
+    char* stop;
+    errno = 0;
+    T value = convert(text, &stop);
+    if (!consumed(text, end - begin, stop))
+        return false;
+    // subnormal values are set along with ERANGE
+    if ((errno == ERANGE) && ((value == 0) || std::isinf(value)))
+        return false;
+    result = value;
+    return true;
+}
+
+bool parseStdio(char const* begin, char const* end, long long& result) {
+    char buf[TEXT_SIZE];
+    std::string spill;
+    char const* text = terminate(begin, end, buf, spill);
+
+    char* stop;
+    errno = 0;
+    long long value = strtoll(text, &stop, 10);
+    if ((errno == ERANGE) || !consumed(text, end - begin, stop))
+        return false;
+    result = value;
+    return true;
+}
+
+#ifdef LSST_CTRL_EVENTS_CHARCONV
+
+template<typename T>
+bool parseChars(char const* begin, char const* end, T& result) {
+    T value;
+    std::from_chars_result converted = std::from_chars(begin, end, value);
+    if ((converted.ec != std::errc()) || (converted.ptr != end))
+        return false;
+    result = value;
+    return true;
+}
+
+#else
+
+// powers of ten which are exactly representable
+double const doublePowers[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+float const floatPowers[] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+/* write value, with at most maxScale digits after the decimal point, if it
+ * is exactly the quotient of an integer no larger than limit and a power of
+ * ten.  A single correctly rounded division then gives value, as strtod does
+ * for the text, and the smallest such power gives the shortest text.
+ * @return the number of characters written, or 0 if value is not of that form
+ */
+template<typename T>
+size_t formatDecimal(T value, T const* powers, int maxScale, T limit, char* buf) {
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+    T magnitude = std::fabs(value);
+    for (int scale = 0; scale <= maxScale; scale++) {
+        T scaled = magnitude * powers[scale];
+        if (!(scaled <= limit))
+            return 0;
+        T whole = std::floor(scaled + static_cast<T>(0.5));
+        if (whole / powers[scale] != magnitude)
+            continue;
+
+        char digits[24];
+        char* end = digits + sizeof(digits);
+        char* first = writeDigits(static_cast<unsigned long long>(whole), end);
+        size_t count = end - first;
+
+        char* out = buf;
+        if (std::signbit(value))
+            *out++ = '-';
+        if (scale == 0) {
+            memcpy(out, first, count);
+            out += count;
+        } else if (count > static_cast<size_t>(scale)) {
+            memcpy(out, first, count - scale);
+            out += count - scale;
+            *out++ = '.';
+            memcpy(out, end - scale, scale);
+            out += scale;
+        } else {
+            *out++ = '0';
+            *out++ = '.';
+            memset(out, '0', scale - count);
+            out += scale - count;
+            memcpy(out, first, count);
+            out += count;
+        }
+        return out - buf;
+    }
+#endif
+    return 0;
+}
+
+/* write value with snprintf, which gives enough digits to read back exactly */
+size_t formatStdio(char const* format, double value, char* buf) {
+    int length = snprintf(buf, NumberFormat::MAX_LENGTH, format, value);
+    // the decimal point is the only character which depends on the locale
+    for (int i = 0; i < length; i++) {
+        char c = buf[i];
+        if (((c < '0') || (c > '9')) && ((c < 'a') || (c > 'z')) && ((c < 'A') || (c > 'Z')) &&
+            (c != '-') && (c != '+'))
+            buf[i] = '.';
+    }
+    return length;
+}
+
+#endif
+
+}
+
+size_t NumberFormat::format(double value, char* buf) {
+#ifdef LSST_CTRL_EVENTS_CHARCONV
+    return std::to_chars(buf, buf + MAX_LENGTH, value).ptr - buf;
+#else
+    size_t length = formatDecimal(value, doublePowers, 17, 9007199254740992.0, buf);
+    if (length == 0)
+        length = formatStdio("%.17g", value, buf);
+    return length;
+#endif
+}
+
+size_t NumberFormat::format(float value, char* buf) {
+#ifdef LSST_CTRL_EVENTS_CHARCONV
+    return std::to_chars(buf, buf + MAX_LENGTH, value).ptr - buf;
+#else
+    size_t length = formatDecimal(value, floatPowers, 10, 16777216.0f, buf);
+    if (length == 0)
+        length = formatStdio("%.9g", value, buf);
+    return length;
+#endif
+}
+
+size_t NumberFormat::format(long long value, char* buf) {
+    char digits[24];
+    char* end = digits + sizeof(digits);
+    unsigned long long magnitude = (value < 0) ? -static_cast<unsigned long long>(value) : value;
+    char* first = writeDigits(magnitude, end);
+
+    char* out = buf;
+    if (value < 0)
+        *out++ = '-';
+    memcpy(out, first, end - first);
+    return (out - buf) + (end - first);
+}
+
+bool NumberFormat::parse(char const* begin, char const* end, double& result) {
+    if (JSONScanner::parseDouble(begin, end, result))
+        return true;
+#ifdef LSST_CTRL_EVENTS_CHARCONV
+    if (parseChars(begin, end, result))
+        return true;
+#endif
+    return parseStdio(begin, end, strtod, result);
+}
+
+bool NumberFormat::parse(char const* begin, char const* end, float& result) {
+#ifdef LSST_CTRL_EVENTS_CHARCONV
+    if (parseChars(begin, end, result))
+        return true;
+#endif
+    return parseStdio(begin, end, strtof, result);
+}
+
+bool NumberFormat::parse(char const* begin, char const* end, long long& result) {
+    if (JSONScanner::parseInteger(begin, end, result))
+        return true;
+#ifdef LSST_CTRL_EVENTS_CHARCONV
+    if (parseChars(begin, end, result))
+        return true;
+#endif
+    return parseStdio(begin, end, result);
+}
+
+bool NumberFormat::parse(char const* begin, char const* end, long& result) {
+    long long value;
+    if (!parse(begin, end, value) || (value < LONG_MIN) || (value > LONG_MAX))
+        return false;
+    result = value;
+    return true;
+}
+
+bool NumberFormat::parse(char const* begin, char const* end, int& result) {
+    long long value;
+    if (!parse(begin, end, value) || (value < INT_MIN) || (value > INT_MAX))
+        return false;
+    result = value;
+    return true;
+}
+
+std::string NumberFormat::getImplementation() {
+#ifdef LSST_CTRL_EVENTS_CHARCONV
+    return "charconv";
+#else
+    return "stdio";
+#endif
+}
+
+}}}
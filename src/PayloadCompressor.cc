@@ -0,0 +1,173 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file PayloadCompressor.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Compression of event bodies
+ *
+ */
+
+#include "decaf/lang/Exception.h"
+#include "decaf/util/zip/Deflater.h"
+#include "decaf/util/zip/Inflater.h"
+
+#include "lsst/ctrl/events/PayloadCompressor.h"
+#include "lsst/ctrl/events/BinaryWriter.h"
+
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+namespace {
+
+// bodies which do not shrink below this fraction of their size are not worth compressing
+const double MAX_RATIO = 0.9;
+
+// weight of each new body in the running ratio
+const double RATIO_WEIGHT = 0.125;
+
+// number of bodies compressed before the running ratio is trusted
+const int MIN_SAMPLES = 8;
+
+// number of bodies sent uncompressed before compression is tried again
+const int PAUSE_LENGTH = 256;
+
+// deflate can not shrink data by more than this factor
+const size_t MAX_DEFLATE_FACTOR = 1032;
+
+}
+
+const std::string PayloadCompressor::DEFLATE = "deflate";
+
+PayloadCompressor::PayloadCompressor(size_t threshold) : _threshold(threshold), _ratio(1.0), _samples(0), _paused(0) {
+}
+
+void PayloadCompressor::setThreshold(size_t threshold) {
+    _threshold = threshold;
+    _ratio = 1.0;
+    _samples = 0;
+    _paused = 0;
+}
+
+bool PayloadCompressor::compress(std::string const& payload, std::string& out) {
+    if ((_threshold == 0) || (payload.size() < _threshold))
+        return false;
+
+    if (_paused > 0) {
+        _paused--;
+        return false;
+    }
+
+    deflate(reinterpret_cast<unsigned char const*>(payload.data()), payload.size(), out);
+
+    double ratio = static_cast<double>(out.size()) / payload.size();
+    if (_samples == 0)
+        _ratio = ratio;
+    else
+        _ratio += RATIO_WEIGHT * (ratio - _ratio);
+    _samples++;
+
+    if ((_samples >= MIN_SAMPLES) && (_ratio > MAX_RATIO)) {
+        _paused = PAUSE_LENGTH;
+        _samples = 0;
+    }
+    return ratio <= MAX_RATIO;
+}
+
+void PayloadCompressor::deflate(unsigned char const* data, size_t length, std::string& out) {
+    out.clear();
+    BinaryWriter::writeFixed(length, 4, out);
+
+    try {
+        decaf::util::zip::Deflater deflater(decaf::util::zip::Deflater::BEST_SPEED);
+        deflater.setInput(data, length, 0, length);
+        deflater.finish();
+
+        unsigned char buffer[8192];
+        while (!deflater.finished()) {
+            int n = deflater.deflate(buffer, sizeof(buffer), 0, sizeof(buffer));
+            out.append(reinterpret_cast<char*>(buffer), n);
+        }
+        deflater.end();
+    } catch (decaf::lang::Exception& e) {
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "Couldn't compress event: "+e.getMessage());
+    }
+}
+
+std::string PayloadCompressor::deflate(std::string const& data) {
+    std::string out;
+    deflate(reinterpret_cast<unsigned char const*>(data.data()), data.size(), out);
+    return out;
+}
+
+void PayloadCompressor::inflate(unsigned char const* data, size_t length, std::string& out) {
+    if (length < 4)
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "Couldn't decompress event: truncated body");
+
+    size_t rawLength = static_cast<size_t>(data[0]) | (static_cast<size_t>(data[1]) << 8) |
+                       (static_cast<size_t>(data[2]) << 16) | (static_cast<size_t>(data[3]) << 24);
+    if (rawLength / MAX_DEFLATE_FACTOR > length)
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "Couldn't decompress event: bad length");
+
+    // one spare byte, so that a stream longer than its stated length is caught
+    out.resize(rawLength + 1);
+    unsigned char* buffer = reinterpret_cast<unsigned char*>(&out[0]);
+    size_t n = 0;
+
+    try {
+        decaf::util::zip::Inflater inflater;
+        inflater.setInput(data, length, 4, length - 4);
+
+        while (!inflater.finished()) {
+            int count = inflater.inflate(buffer, rawLength + 1, n, rawLength + 1 - n);
+            if ((count == 0) && !inflater.finished() && inflater.needsInput())
+                throw LSST_EXCEPT(pexExceptions::RuntimeError, "Couldn't decompress event: truncated body");
+            n += count;
+            if (n > rawLength)
+                throw LSST_EXCEPT(pexExceptions::RuntimeError, "Couldn't decompress event: body longer than stated");
+        }
+        inflater.end();
+    } catch (decaf::lang::Exception& e) {
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "Couldn't decompress event: "+e.getMessage());
+    }
+
+    if (n != rawLength)
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "Couldn't decompress event: body shorter than stated");
+    out.resize(rawLength);
+}
+
+std::string PayloadCompressor::inflate(std::string const& data) {
+    std::string out;
+    inflate(reinterpret_cast<unsigned char const*>(data.data()), data.size(), out);
+    return out;
+}
+
+}}}
@@ -31,6 +31,7 @@
  *
  */
 #include <iomanip>
+#include <sys/time.h>
 
 #include "lsst/ctrl/events/Receiver.h"
 
@@ -38,10 +39,16 @@
 
 #include "lsst/ctrl/events/EventLibrary.h"
 #include "lsst/ctrl/events/EventFactory.h"
+#include "lsst/ctrl/events/CommandEvent.h"
+#include "lsst/ctrl/events/HostTable.h"
+#include "lsst/ctrl/events/LocationId.h"
+#include "lsst/ctrl/events/StatusEvent.h"
 
 #include <activemq/core/ActiveMQConnectionFactory.h>
 #include <activemq/exceptions/ActiveMQException.h>
 
+#include "boost/scoped_ptr.hpp"
+
 namespace pexExceptions = lsst::pex::exceptions;
 
 namespace activemqCore = activemq::core;
@@ -112,22 +119,187 @@ PTR(Event) Receiver::receiveEvent() {
 }
 
 PTR(Event) Receiver::receiveEvent(long timeout) {
+    return receiveEvent(timeout, true);
+}
 
-    cms::TextMessage* textMessage;
-    try {
-        cms::Message* msg = _consumer->receive(timeout);
-        if (msg == NULL) return NULL;
-        textMessage = dynamic_cast<cms::TextMessage* >(msg);
-        if (textMessage == NULL)
-            throw LSST_EXCEPT(pexExceptions::RuntimeError, "Unexpected JMS Message type");
-    } catch (activemq::exceptions::ActiveMQException& e) {
-        throw LSST_EXCEPT(pexExceptions::RuntimeError, e.getMessage());
+PTR(EventBatch) Receiver::receiveEvents(int count, long timeout) {
+    PTR(EventBatch) batch(new EventBatch(count));
+    if (count <= 0)
+        return batch;
+
+    PTR(Event) event = receiveEvent(timeout, true);
+    while (event) {
+        batch->_events.push_back(event);
+        if (batch->size() == count)
+            break;
+        event = receiveEvent(0, false);
+    }
+    return batch;
+}
+
+/** private class which keeps the Event received
+  */
+class Receiver::EventTarget : public Receiver::Target {
+public:
+    virtual void take(PTR(Event) const& event) { _event = event; }
+    PTR(Event) _event;
+};
+
+/** private method to receive an event; if wait is false, only messages
+  * which have already arrived are taken
+  */
+PTR(Event) Receiver::receiveEvent(long timeout, bool wait) {
+    EventTarget target;
+    receive(timeout, wait, target);
+    return target._event;
+}
+
+/** private method to receive an event into target; false if none arrived
+  * in time
+  */
+bool Receiver::receive(long timeout, bool wait, Target& target) {
+
+    long long deadline = 0;
+    if (timeout > 0)
+        deadline = currentMillis() + timeout;
+
+    for (;;) {
+        // sets of chunks run out of time even if no more of their chunks arrive
+        _chunkReader.expire(currentMillis());
+
+        cms::Message* msg;
+        try {
+            msg = wait ? _consumer->receive(timeout) : _consumer->receiveNoWait();
+            if (msg == NULL) return false;
+            if ((dynamic_cast<cms::TextMessage* >(msg) == NULL) && (dynamic_cast<cms::BytesMessage* >(msg) == NULL)) {
+                delete msg;
+                throw LSST_EXCEPT(pexExceptions::RuntimeError, "Unexpected JMS Message type");
+            }
+        } catch (activemq::exceptions::ActiveMQException& e) {
+            throw LSST_EXCEPT(pexExceptions::RuntimeError, e.getMessage());
+        }
+
+        boost::scoped_ptr<cms::Message> message(msg);
+        if (msg->propertyExists(Event::CHUNKSET)) {
+            msg = _chunkReader.read(msg, currentMillis(), _session);
+            message.reset(msg);
+        }
+
+        if ((msg != NULL) && knowsHosts(msg)) {
+            if (target.read(msg))
+                return true;
+            PTR(Event) event(EventFactory::createEvent(msg));
+            // the claim is checked before completing the event reads its body,
+            // and the file is only removed once the body can be decoded; the
+            // files of events which can not be completed are left to the sweep
+            bool claimed = !msg->propertyExists(Event::CLAIMCHECK) ||
+                _claimCheckReader.read(*event, msg->getStringProperty(Event::CLAIMCHECK), currentMillis());
+            if (claimed && completeEvent(*event, msg)) {
+                if (msg->propertyExists(Event::CLAIMCHECK))
+                    _claimCheckReader.release(*event, msg->getStringProperty(Event::CLAIMCHECK));
+                target.take(event);
+                return true;
+            }
+        }
+
+        // the event could not be completed; wait for the rest of the timeout
+        if (wait && (timeout > 0)) {
+            timeout = deadline - currentMillis();
+            if (timeout <= 0)
+                return false;
+        }
     }
+}
 
-    PTR(Event) event(EventFactory().createEvent(textMessage));
-    delete textMessage;
+/** private method to check that the hosts of the packed locations of msg
+  * are known, once those it defines are added; as with property names,
+  * events which use codes that are not known are discarded.  A code shared
+  * by two hosts is known, though neither can be named, and its events are
+  * received with the ID left packed.
+  */
+bool Receiver::knowsHosts(cms::Message const* msg) {
+    HostTable& hosts = HostTable::getDefaultHostTable();
+    if (msg->propertyExists(Event::HOSTS))
+        hosts.define(msg->getStringProperty(Event::HOSTS));
+
+    std::string hostname;
+    for (std::string const* name : {&StatusEvent::ORIG_ID, &CommandEvent::DEST_ID}) {
+        if (!msg->propertyExists(*name))
+            continue;
+        unsigned int code = LocationId::getHostCode(msg->getLongProperty(*name));
+        if (!hosts.lookup(code, hostname) && !hosts.isConflicting(code))
+            return false;
+    }
+    return true;
+}
+
+/** private method to rebuild the full custom properties of an event sent
+  * with name compression or as a delta
+  * \return false if the event can not be rebuilt
+  */
+bool Receiver::completeEvent(Event& event, cms::Message const* msg) {
+    // a selector may filter out the events which define codes; the events
+    // which use them are discarded until the whole dictionary is sent again
+    if (msg->propertyExists(Event::DICTIONARY)) {
+        std::string definitions;
+        if (msg->propertyExists(Event::NAMES))
+            definitions = msg->getStringProperty(Event::NAMES);
+        if (!_nameDecoder.read(event, msg->getStringProperty(Event::DICTIONARY), definitions))
+            return false;
+    }
+    // a selector may filter out the events a delta follows on from, which
+    // the sequence shows, so that it is discarded as if they had been missed
+    if (msg->propertyExists(Event::SEQUENCE))
+        return _deltaReader.read(event, msg->getLongProperty(Event::SEQUENCE), msg->getBooleanProperty(Event::DELTA));
+    return true;
+}
+
+/** private method to get the current time in milliseconds
+  */
+long long Receiver::currentMillis() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return static_cast<long long>(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+}
+
+void Receiver::setChunkBufferSize(size_t size) {
+    _chunkReader.setBufferSize(size);
+}
+
+size_t Receiver::getChunkBufferSize() {
+    return _chunkReader.getBufferSize();
+}
+
+void Receiver::setChunkTimeout(long timeout) {
+    _chunkReader.setTimeout(timeout);
+}
+
+long Receiver::getChunkTimeout() {
+    return _chunkReader.getTimeout();
+}
+
+void Receiver::addClaimCheckDirectory(std::string const& directory) {
+    _claimCheckReader.addDirectory(directory);
+}
+
+std::vector<std::string> Receiver::getClaimCheckDirectories() {
+    return _claimCheckReader.getDirectories();
+}
+
+void Receiver::setClaimCheckRetention(long retention) {
+    _claimCheckReader.setRetention(retention);
+}
+
+long Receiver::getClaimCheckRetention() {
+    return _claimCheckReader.getRetention();
+}
+
+void Receiver::setClaimCheckRemoval(bool remove) {
+    _claimCheckReader.setRemoveOnRead(remove);
+}
 
-    return event;
+bool Receiver::getClaimCheckRemoval() {
+    return _claimCheckReader.getRemoveOnRead();
 }
 
 std::string Receiver::getDestinationName() {
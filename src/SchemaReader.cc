@@ -0,0 +1,85 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file SchemaReader.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Reader of the schema event body encoding
+ *
+ */
+
+#include <sstream>
+
+#include "lsst/ctrl/events/SchemaReader.h"
+#include "lsst/ctrl/events/SchemaWriter.h"
+#include "lsst/ctrl/events/BinaryReader.h"
+#include "lsst/ctrl/events/EventSchema.h"
+#include "lsst/ctrl/events/SchemaRegistry.h"
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+PTR(PropertySet) SchemaReader::read(std::string const& data) {
+    PTR(PropertySet) psp(new PropertySet);
+    read(reinterpret_cast<unsigned char const*>(data.data()), data.size(), *psp);
+    return psp;
+}
+
+void SchemaReader::read(unsigned char const* data, size_t length, PropertySet& ps) {
+    BinaryReader reader(data, length);
+
+    if (reader.readByte() != SchemaWriter::VERSION)
+        reader.error("unsupported version");
+
+    unsigned long long id = reader.readFixed(8);
+    unsigned char flag = reader.readByte();
+
+    SchemaRegistry& registry = SchemaRegistry::getDefaultSchemaRegistry();
+    PTR(EventSchema) schema;
+    if (flag == 1) {
+        schema = EventSchema::read(reader);
+        if (schema->getId() != id)
+            reader.error("schema definition does not match its ID");
+        schema = registry.registerSchema(schema);
+    } else if (flag == 0) {
+        schema = registry.getSchema(id);
+        if (!schema) {
+            std::ostringstream msg;
+            msg << "unknown event schema " << id;
+            reader.error(msg.str());
+        }
+    } else {
+        reader.error("bad schema definition flag");
+    }
+
+    for (EventSchema::Field const& field : schema->getFields()) {
+        reader.readValues(field.tag, field.name, ps);
+    }
+    reader.finish();
+}
+
+}}}
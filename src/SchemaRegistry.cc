@@ -0,0 +1,80 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file SchemaRegistry.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Per-process cache of event schemas
+ *
+ */
+
+#include "lsst/ctrl/events/SchemaRegistry.h"
+
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+SchemaRegistry& SchemaRegistry::getDefaultSchemaRegistry() {
+    static SchemaRegistry registry;
+    return registry;
+}
+
+PTR(EventSchema) SchemaRegistry::registerSchema(PTR(EventSchema) schema) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::map<unsigned long long, PTR(EventSchema)>::iterator it = _schemas.find(schema->getId());
+    if (it == _schemas.end()) {
+        _schemas[schema->getId()] = schema;
+        return schema;
+    }
+    if (!(*it->second == *schema))
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "event schema ID collision");
+    return it->second;
+}
+
+PTR(EventSchema) SchemaRegistry::registerSchema(PropertySet const& ps) {
+    return registerSchema(EventSchema::create(ps));
+}
+
+PTR(EventSchema) SchemaRegistry::getSchema(unsigned long long id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::map<unsigned long long, PTR(EventSchema)>::iterator it = _schemas.find(id);
+    if (it == _schemas.end())
+        return PTR(EventSchema)();
+    return it->second;
+}
+
+size_t SchemaRegistry::size() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _schemas.size();
+}
+
+}}}
@@ -0,0 +1,80 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file SchemaWriter.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Writer of PropertySets into the schema event body encoding
+ *
+ */
+
+#include "lsst/ctrl/events/SchemaWriter.h"
+#include "lsst/ctrl/events/BinaryWriter.h"
+#include "lsst/ctrl/events/EventSchema.h"
+#include "lsst/ctrl/events/SchemaRegistry.h"
+
+#include "lsst/pex/exceptions.h"
+
+namespace pexExceptions = lsst::pex::exceptions;
+
+namespace lsst {
+namespace ctrl {
+namespace events {
+
+SchemaWriter::SchemaWriter(int interval) {
+    setDefinitionInterval(interval);
+}
+
+void SchemaWriter::setDefinitionInterval(int interval) {
+    if (interval < 1)
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "schema definition interval must be at least 1");
+    _interval = interval;
+}
+
+std::string SchemaWriter::write(PropertySet const& ps) {
+    std::string out;
+    write(ps, out);
+    return out;
+}
+
+void SchemaWriter::write(PropertySet const& ps, std::string& out) {
+    PTR(EventSchema) schema = SchemaRegistry::getDefaultSchemaRegistry().registerSchema(ps);
+
+    bool definition = (_written[schema->getId()]++ % _interval) == 0;
+
+    out.clear();
+    out.push_back(VERSION);
+    BinaryWriter::writeFixed(schema->getId(), 8, out);
+    out.push_back(definition ? 1 : 0);
+    if (definition)
+        schema->write(out);
+
+    for (EventSchema::Field const& field : schema->getFields()) {
+        BinaryWriter::writeValues(ps, field.name, field.tag, out);
+    }
+}
+
+}}}
@@ -31,6 +31,8 @@
  *
  */
 
+#include <utility>
+
 #include "lsst/ctrl/events/StatusEvent.h"
 #include "lsst/ctrl/events/EventTypes.h"
 
@@ -41,6 +43,7 @@ namespace events {
 std::string const StatusEvent::ORIG_HOSTNAME = "ORIG_HOSTNAME";
 std::string const StatusEvent::ORIG_PROCESSID = "ORIG_PROCESSID";
 std::string const StatusEvent::ORIG_LOCALID = "ORIG_LOCALID";
+std::string const StatusEvent::ORIG_ID = "ORIG_ID";
 
 StatusEvent::StatusEvent() : Event() {
     _init();
@@ -48,17 +51,16 @@ StatusEvent::StatusEvent() : Event() {
 
 
 void StatusEvent::_init() {
-    _keywords.insert(ORIG_HOSTNAME);
-    _keywords.insert(ORIG_PROCESSID);
-    _keywords.insert(ORIG_LOCALID);
+    _keywords.add(KeywordSet::STATUS_KEYWORDS);
 }
 
-StatusEvent::StatusEvent(cms::TextMessage *msg) : Event(msg) {
+/**
+ * @brief Constructor to take a JMS Message and turn it into a StatusEvent;
+ *        the ORIG_* header properties have already been copied by Event(msg),
+ *        and are only marked as the keywords of this type, which reset() keeps
+ */
+StatusEvent::StatusEvent(cms::Message *msg) : Event(msg) {
     _init();
-
-    _psp->set(ORIG_HOSTNAME, (std::string)msg->getStringProperty(ORIG_HOSTNAME));
-    _psp->set(ORIG_PROCESSID, (int)msg->getIntProperty(ORIG_PROCESSID));
-    _psp->set(ORIG_LOCALID, (int)msg->getIntProperty(ORIG_LOCALID));
 }
 
 StatusEvent::StatusEvent(LocationId const& originatorID, 
@@ -98,28 +100,48 @@ StatusEvent::StatusEvent(std::string const& runID,
     _constructor(originatorID);
 }
 
+StatusEvent::StatusEvent(LocationId const& originatorID,
+                         PTR(PropertySet)&& psp) : Event(std::move(psp)) {
+    _constructor(originatorID);
+}
+
+StatusEvent::StatusEvent(LocationId const& originatorID,
+                         PTR(PropertySet)&& psp,
+                         PropertySet const& filterable) : Event(std::move(psp), filterable) {
+    _constructor(originatorID);
+}
+
+StatusEvent::StatusEvent(std::string const& runID,
+                         LocationId const& originatorID,
+                         PTR(PropertySet)&& psp) : Event(runID, std::move(psp)) {
+    _constructor(originatorID);
+}
+
+StatusEvent::StatusEvent(std::string const& runID,
+                         LocationId const& originatorID,
+                         PTR(PropertySet)&& psp,
+                         PropertySet const& filterable) : Event(runID, std::move(psp), filterable) {
+    _constructor(originatorID);
+}
+
 void StatusEvent::_constructor(LocationId const& originatorID) {
     _init();
 
     _psp->set(ORIG_HOSTNAME, originatorID.getHostName());
     _psp->set(ORIG_PROCESSID, originatorID.getProcessID());
     _psp->set(ORIG_LOCALID, originatorID.getLocalID());
-    _psp->set(TYPE, EventTypes::STATUS);
-
-}
-
-void StatusEvent::populateHeader(cms::TextMessage* msg) const {
-    Event::populateHeader(msg);
+    _setType(EventTypes::STATUS);
 
-    msg->setStringProperty(ORIG_HOSTNAME, _psp->get<std::string>(ORIG_HOSTNAME));
-    msg->setIntProperty(ORIG_PROCESSID, _psp->get<int>(ORIG_PROCESSID));
-    msg->setIntProperty(ORIG_LOCALID, _psp->get<int>(ORIG_LOCALID));
 }
 
-LocationId *StatusEvent::getOriginator() {
-    std::string hostname = _psp->get<std::string>(ORIG_HOSTNAME);
-    int pid = _psp->get<int>(ORIG_PROCESSID);
-    int local = _psp->get<int>(ORIG_LOCALID);
+LocationId *StatusEvent::getOriginator() const {
+    CONST_PTR(PropertySet) psp = _properties();
+    // a location whose host code is shared by two hosts is left packed
+    if (psp->exists(ORIG_ID))
+        return new LocationId(psp->get<long long>(ORIG_ID));
+    std::string hostname = psp->get<std::string>(ORIG_HOSTNAME);
+    int pid = psp->get<int>(ORIG_PROCESSID);
+    int local = psp->get<int>(ORIG_LOCALID);
     return new LocationId(hostname, pid, local);
 }
 
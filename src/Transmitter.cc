@@ -31,12 +31,23 @@
  *
  */
 
+#include <algorithm>
+
 #include "lsst/ctrl/events/Transmitter.h"
 #include "lsst/ctrl/events/EventLibrary.h"
+#include "lsst/ctrl/events/EventEncodings.h"
+#include "lsst/ctrl/events/BinaryWriter.h"
+#include "lsst/ctrl/events/JSONWriter.h"
+#include "lsst/ctrl/events/CommandEvent.h"
+#include "lsst/ctrl/events/HostTable.h"
+#include "lsst/ctrl/events/LocationId.h"
+#include "lsst/ctrl/events/StatusEvent.h"
 
 #include "lsst/daf/base/DateTime.h"
 #include "lsst/pex/exceptions.h"
 
+#include "boost/scoped_ptr.hpp"
+
 #include <activemq/core/ActiveMQConnectionFactory.h>
 
 namespace dafBase = lsst::daf::base;
@@ -65,6 +76,12 @@ void Transmitter::init( const std::string& hostName, const std::string& destinat
     _producer = NULL;
     _destinationName = destinationName;
     _destination = NULL;
+    _encoding = EventEncodings::JSON;
+    _deltaEncoding = false;
+    _arrayPacking = false;
+    _nameCompression = false;
+    _compactOriginator = false;
+    _compactEvents = 0;
 
     // set up a connection to the ActiveMQ server for message transmission
     try {
@@ -114,25 +131,269 @@ void Transmitter::init( const std::string& hostName, const std::string& destinat
 }
 
 void Transmitter::publishEvent(Event& event) {
-    long long pubtime;
-    cms::TextMessage* message = _session->createTextMessage();
+    cms::Message* message;
+
+    std::string encoding = _encoding;
+    std::string originator;
+    long long sequence = 0;
+    PTR(PropertySet) delta;
+    bool sequenced = _deltaEncoding && DeltaWriter::getOriginator(event, originator);
+    if (sequenced)
+        delta = _deltaWriter.write(originator, *event.getCustomPropertySet(), sequence);
+
+    // deltas differ in shape from one to the next, so they are never
+    // schema encoded
+    if (delta && (encoding == EventEncodings::SCHEMA))
+        encoding = EventEncodings::BINARY;
+    bool named = _nameCompression && (encoding == EventEncodings::JSON);
+
+    std::string body;
+    std::string const* payload;
+    if (delta || named) {
+        CONST_PTR(PropertySet) psp = delta ? delta : event.getCustomPropertySet();
+        if (named)
+            JSONWriter::write(*psp, _nameEncoder, body, _arrayPacking);
+        else if (encoding == EventEncodings::BINARY)
+            BinaryWriter::write(*psp, body);
+        else
+            JSONWriter::write(*psp, body, _arrayPacking);
+        payload = &body;
+    } else {
+        payload = &event.marshallPayload(encoding, _schemaWriter, _arrayPacking);
+    }
+
+    // a body sent by claim check stays out of the message, and is neither
+    // compressed nor chunked
+    std::string claim;
+    if (_claimCheckWriter.isClaimed(payload->size()))
+        claim = _claimCheckWriter.write(*payload);
+    bool claimed = !claim.empty();
+
+    std::string compressed;
+    bool deflated = !claimed && _compressor.compress(*payload, compressed);
+    if (deflated)
+        payload = &compressed;
+    bool chunked = !claimed && (_chunkWriter.getChunkCount(payload->size()) > 1);
+
+    // the body of a chunked event is set on each of its chunks
+    if ((encoding == EventEncodings::JSON) && !deflated && !chunked && !claimed) {
+        cms::TextMessage* textMessage = _session->createTextMessage();
+        message = textMessage;
+        event.populateHeader(textMessage, _compactOriginator);
+        textMessage->setText(*payload);
+    } else {
+        cms::BytesMessage* bytesMessage = _session->createBytesMessage();
+        message = bytesMessage;
+        event.populateHeader(bytesMessage, _compactOriginator);
+        if (!chunked && !claimed)
+            bytesMessage->setBodyBytes(reinterpret_cast<unsigned char const*>(payload->data()), payload->size());
+        if (deflated)
+            bytesMessage->setStringProperty(Event::COMPRESSION, PayloadCompressor::DEFLATE);
+        bytesMessage->setStringProperty(Event::ENCODING, encoding);
+    }
 
-    event.marshall(message);
+    if (claimed)
+        message->setStringProperty(Event::CLAIMCHECK, claim);
+
+    if (_compactOriginator)
+        defineHosts(message);
+
+    if (sequenced) {
+        message->setLongProperty(Event::SEQUENCE, sequence);
+        message->setBooleanProperty(Event::DELTA, delta != 0);
+    }
+
+    if (named) {
+        std::string dictionary;
+        std::string definitions;
+        _nameEncoder.finish(dictionary, definitions);
+        message->setStringProperty(Event::DICTIONARY, dictionary);
+        if (!definitions.empty())
+            message->setStringProperty(Event::NAMES, definitions);
+    }
 
     message->setStringProperty(getDestinationPropertyName(), _destinationName);
 
+    if (chunked)
+        sendChunks(message, *payload);
+    else
+        sendMessage(message);
+    delete message;
+}
+
+/** private method to timestamp and send a message
+  */
+void Transmitter::sendMessage(cms::Message* message) {
     // wait until the last moment to timestamp publication time
-    pubtime = dafBase::DateTime::now().nsecs();
+    long long pubtime = dafBase::DateTime::now().nsecs();
     message->setLongProperty("PUBTIME", pubtime);
 
     _producer->send(_destination, message);
-    delete message;
+}
+
+/** private method to add the definitions of the hosts in the packed
+  * locations of message which receivers have not been sent recently
+  */
+void Transmitter::defineHosts(cms::Message* message) {
+    std::string definitions;
+    for (std::string const* name : {&StatusEvent::ORIG_ID, &CommandEvent::DEST_ID}) {
+        if (!message->propertyExists(*name))
+            continue;
+        unsigned int code = LocationId::getHostCode(message->getLongProperty(*name));
+        std::map<unsigned int, long long>::iterator it = _hostsDefined.find(code);
+        if ((it != _hostsDefined.end()) && (_compactEvents - it->second < HostTable::DEFINITION_INTERVAL))
+            continue;
+
+        std::string definition = HostTable::getDefaultHostTable().getDefinition(code);
+        if (definition.empty())
+            continue;
+        if (!definitions.empty())
+            definitions += '\n';
+        definitions += definition;
+        _hostsDefined[code] = _compactEvents;
+    }
+    _compactEvents++;
+
+    if (!definitions.empty())
+        message->setStringProperty(Event::HOSTS, definitions);
+}
+
+/** private method to send body in chunks, each a BytesMessage with the
+  * properties of header and those which place it in its set
+  */
+void Transmitter::sendChunks(cms::Message const* header, std::string const& body) {
+    size_t chunkSize = _chunkWriter.getChunkSize();
+    int count = _chunkWriter.getChunkCount(body.size());
+    std::string chunkSet = _chunkWriter.nextChunkSet();
+
+    for (int i = 0; i < count; i++) {
+        size_t offset = i * chunkSize;
+        size_t length = std::min(chunkSize, body.size() - offset);
+        boost::scoped_ptr<cms::BytesMessage> chunk(_session->createBytesMessage(
+            reinterpret_cast<unsigned char const*>(body.data() + offset), length));
+        ChunkWriter::copyProperties(header, chunk.get());
+        chunk->setStringProperty(Event::CHUNKSET, chunkSet);
+        chunk->setIntProperty(Event::CHUNK, i);
+        chunk->setIntProperty(Event::CHUNKS, count);
+        chunk->setLongProperty("PUBTIME", dafBase::DateTime::now().nsecs());
+
+        _producer->send(_destination, chunk.get());
+    }
 }
 
 std::string Transmitter::getDestinationName() {
     return _destinationName;
 }
 
+void Transmitter::setEncoding(std::string const& encoding) {
+    if ((encoding != EventEncodings::JSON) && (encoding != EventEncodings::BINARY) &&
+        (encoding != EventEncodings::SCHEMA))
+        throw LSST_EXCEPT(pexExceptions::RuntimeError, "Unknown event encoding \""+encoding+"\"");
+    _encoding = encoding;
+}
+
+std::string Transmitter::getEncoding() {
+    return _encoding;
+}
+
+void Transmitter::setSchemaDefinitionInterval(int interval) {
+    _schemaWriter.setDefinitionInterval(interval);
+}
+
+int Transmitter::getSchemaDefinitionInterval() {
+    return _schemaWriter.getDefinitionInterval();
+}
+
+void Transmitter::setDeltaEncoding(bool enabled) {
+    if (enabled != _deltaEncoding)
+        _deltaWriter.reset();
+    _deltaEncoding = enabled;
+}
+
+bool Transmitter::getDeltaEncoding() {
+    return _deltaEncoding;
+}
+
+void Transmitter::setKeyframeInterval(int interval) {
+    _deltaWriter.setKeyframeInterval(interval);
+}
+
+int Transmitter::getKeyframeInterval() {
+    return _deltaWriter.getKeyframeInterval();
+}
+
+void Transmitter::setNameCompression(bool enabled) {
+    _nameCompression = enabled;
+}
+
+bool Transmitter::getNameCompression() {
+    return _nameCompression;
+}
+
+void Transmitter::setNameDefinitionInterval(int interval) {
+    _nameEncoder.setDefinitionInterval(interval);
+}
+
+int Transmitter::getNameDefinitionInterval() {
+    return _nameEncoder.getDefinitionInterval();
+}
+
+void Transmitter::setCompressionThreshold(size_t threshold) {
+    _compressor.setThreshold(threshold);
+}
+
+size_t Transmitter::getCompressionThreshold() {
+    return _compressor.getThreshold();
+}
+
+void Transmitter::setChunkSize(size_t size) {
+    _chunkWriter.setChunkSize(size);
+}
+
+size_t Transmitter::getChunkSize() {
+    return _chunkWriter.getChunkSize();
+}
+
+void Transmitter::setClaimCheckDirectory(std::string const& directory) {
+    _claimCheckWriter.setDirectory(directory);
+}
+
+std::string Transmitter::getClaimCheckDirectory() {
+    return _claimCheckWriter.getDirectory();
+}
+
+void Transmitter::setClaimCheckThreshold(size_t threshold) {
+    _claimCheckWriter.setThreshold(threshold);
+}
+
+size_t Transmitter::getClaimCheckThreshold() {
+    return _claimCheckWriter.getThreshold();
+}
+
+void Transmitter::setCompactOriginator(bool enabled) {
+    _compactOriginator = enabled;
+}
+
+bool Transmitter::getCompactOriginator() {
+    return _compactOriginator;
+}
+
+void Transmitter::setArrayPacking(bool enabled) {
+    _arrayPacking = enabled;
+}
+
+bool Transmitter::getArrayPacking() {
+    return _arrayPacking;
+}
+
+double Transmitter::getCompressionRatio() {
+    return _compressor.getRatio();
+}
+
+bool Transmitter::isCompressing() {
+    return _compressor.isCompressing();
+}
+
 Transmitter::~Transmitter() {
 
     if (_destination != NULL)
@@ -0,0 +1,104 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file ArrayPacking.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Test that the JSON bodies of events carry numeric arrays as
+ *        type-tagged values, which every receiver can read, unless packing
+ *        is asked for.
+ */
+
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ArrayPacking
+#include "boost/test/unit_test.hpp"
+
+#include "activemq/commands/ActiveMQTextMessage.h"
+
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/ctrl/events.h"
+#include "lsst/ctrl/events/EventEncodings.h"
+#include "lsst/ctrl/events/JSONReader.h"
+#include "lsst/ctrl/events/JSONWriter.h"
+#include "lsst/ctrl/events/SchemaWriter.h"
+
+using lsst::daf::base::PropertySet;
+namespace ctrlEvents = lsst::ctrl::events;
+
+namespace {
+
+std::vector<double> values() {
+    std::vector<double> vec;
+    for (size_t i = 0; i < 2 * ctrlEvents::JSONWriter::PACK_THRESHOLD; i++) {
+        vec.push_back(i * 0.25);
+    }
+    return vec;
+}
+
+void checkValues(std::string const& body) {
+    PropertySet ps;
+    ctrlEvents::JSONReader::read(body.data(), body.size(), ps);
+    std::vector<double> vec = ps.getArray<double>("values");
+    std::vector<double> expected = values();
+    BOOST_CHECK_EQUAL_COLLECTIONS(vec.begin(), vec.end(), expected.begin(), expected.end());
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(unpackedByDefault) {
+    PropertySet ps;
+    ps.set("values", values());
+    ctrlEvents::Event event("run", ps);
+
+    // the body of a marshalled event has one tagged item for each value
+    activemq::commands::ActiveMQTextMessage msg;
+    event.marshall(&msg);
+    std::string body = msg.getText();
+    BOOST_CHECK(body.find("packed") == std::string::npos);
+    BOOST_CHECK(body.find("\"double\":\"0.25\"") != std::string::npos);
+    checkValues(body);
+
+    BOOST_CHECK(ctrlEvents::JSONWriter::write(ps).find("packed") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(packedOnRequest) {
+    PropertySet ps;
+    ps.set("values", values());
+    ctrlEvents::Event event("run", ps);
+    ctrlEvents::SchemaWriter writer;
+
+    std::string packed = event.marshallPayload(ctrlEvents::EventEncodings::JSON, writer, true);
+    BOOST_CHECK(packed.find("\"packed double\"") != std::string::npos);
+    checkValues(packed);
+
+    // the kept body is not reused when packing is turned off again
+    std::string unpacked = event.marshallPayload(ctrlEvents::EventEncodings::JSON, writer);
+    BOOST_CHECK(unpacked.find("packed") == std::string::npos);
+    checkValues(unpacked);
+}
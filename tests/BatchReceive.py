@@ -0,0 +1,96 @@
+#!/usr/bin/env python
+
+# 
+# LSST Data Management System
+#
+# Copyright 2008-2014  AURA/LSST.
+# 
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the LSST License Statement and 
+# the GNU General Public License along with this program.  If not, 
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import os
+import platform
+import unittest
+import lsst.ctrl.events as events
+from lsst.daf.base import PropertySet
+import lsst.utils.tests as tests
+from testEnvironment import TestEnvironment
+
+class BatchReceiveTestCase(unittest.TestCase):
+    """Test receiving events in batches"""
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testBatchReceive(self):
+        """Send events, and receive them in batches"""
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        thisHost = platform.node()
+
+        topic = "test_events_batch_%s_%d" % (thisHost, os.getpid())
+        recv = events.EventReceiver(broker, topic)
+        trans = events.EventTransmitter(broker, topic)
+
+        originator = events.LocationId()
+        count = 10
+        for i in range(count):
+            root = PropertySet()
+            root.set("number", i)
+            if i % 2 == 0:
+                event = events.Event("batchrun", root)
+            else:
+                event = events.StatusEvent("batchrun", originator, root)
+            trans.publishEvent(event)
+
+        # the first event of a batch is waited for, the others are taken
+        # only if they have already arrived, so the batches may be short
+        received = []
+        while len(received) < count:
+            batch = recv.receiveEvents(4, 5000)
+            self.assertGreater(batch.size(), 0)
+            self.assertLessEqual(batch.size(), 4)
+            for i in range(batch.size()):
+                received.append(batch.getEvent(i))
+
+        # the events outlive their batches
+        del batch
+        for i, event in enumerate(received):
+            self.assertEqual(event.getCustomPropertySet().get("number"), i)
+            self.assertEqual(event.getRunId(), "batchrun")
+            if i % 2 == 0:
+                self.assertEqual(event.getType(), events.EventTypes.EVENT)
+            else:
+                self.assertEqual(event.getType(), events.EventTypes.STATUS)
+
+        # nothing else was sent
+        batch = recv.receiveEvents(4, 1000)
+        self.assertEqual(batch.size(), 0)
+
+def suite():
+    """Returns a suite containing all the tests cases in this module."""
+    tests.init()
+    suites = []
+    suites += unittest.makeSuite(BatchReceiveTestCase)
+    suites += unittest.makeSuite(tests.MemoryTestCase)
+    return unittest.TestSuite(suites)
+
+def run(shouldExit=False):
+    """Run the tests."""
+    tests.run(suite(), shouldExit)
+
+if __name__ == "__main__":
+    run(True)
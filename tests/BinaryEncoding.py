@@ -0,0 +1,112 @@
+#!/usr/bin/env python
+
+# 
+# LSST Data Management System
+#
+# Copyright 2008-2014  AURA/LSST.
+# 
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the LSST License Statement and 
+# the GNU General Public License along with this program.  If not, 
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+
+import os
+import platform
+import unittest
+import lsst.ctrl.events as events
+from lsst.daf.base import PropertySet
+import lsst.pex.exceptions as ex
+import lsst.utils.tests as tests
+from testEnvironment import TestEnvironment
+
+class BinaryEncodingTestCase(unittest.TestCase):
+    """Test the binary encoding of event bodies"""
+
+    def createPropertySet(self):
+        ps = PropertySet()
+        ps.set("myname", "myname")
+        ps.setInt("value", -12)
+        ps.setLongLong("big", 123456789012)
+        ps.setFloat("single", 1.5)
+        ps.setBool("flag", True)
+        ps.set("values", [0.1, 0.2, 0.3, 0.4])
+        ps.set("logger.status", "my logger special status")
+        ps.setInt("logger.pid.xyzzy", 1)
+        return ps
+
+    def testRoundTrip(self):
+        ps = self.createPropertySet()
+
+        result = events.BinaryReader.read(events.BinaryWriter.write(ps))
+
+        self.assertEqual(result.nameCount(), ps.nameCount())
+        for name in ps.paramNames(False):
+            self.assertEqual(result.typeOf(name), ps.typeOf(name))
+            self.assertEqual(result.getArray(name), ps.getArray(name))
+
+    def testSize(self):
+        ps = PropertySet()
+        ps.set("values", [x * 0.5 for x in range(100)])
+        ps.set("counts", range(100))
+
+        self.assertLess(len(events.BinaryWriter.write(ps)), len(events.JSONWriter.write(ps)) / 3)
+
+    def testMalformed(self):
+        data = events.BinaryWriter.write(self.createPropertySet())
+        for bad in ['', data[:-1], data + 'x', '\xff' + data[1:]]:
+            self.assertRaises(ex.Exception, events.BinaryReader.read, bad)
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testTransmitReceive(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = "test_events_binary_%s_%d" % (platform.node(), os.getpid())
+
+        recv = events.EventReceiver(broker, topic)
+        trans = events.EventTransmitter(broker, topic)
+        self.assertEqual(trans.getEncoding(), events.EventEncodings.JSON)
+        self.assertRaises(ex.Exception, trans.setEncoding, "unknown")
+
+        ps = self.createPropertySet()
+        trans.setEncoding(events.EventEncodings.BINARY)
+        trans.publishEvent(events.Event("binaryrunid", ps))
+        trans.setEncoding(events.EventEncodings.JSON)
+        trans.publishEvent(events.Event("jsonrunid", ps))
+
+        for runid in ["binaryrunid", "jsonrunid"]:
+            val = recv.receiveEvent()
+            self.assertIsNotNone(val)
+            self.assertEqual(val.getRunId(), runid)
+            self.assertNotIn(events.Event.ENCODING, val.getFilterablePropertyNames())
+            custom = val.getCustomPropertySet()
+            for name in ps.paramNames(False):
+                self.assertEqual(custom.getArray(name), ps.getArray(name))
+
+def suite():
+    """Returns a suite containing all the tests cases in this module."""
+    tests.init()
+    suites = []
+    suites += unittest.makeSuite(BinaryEncodingTestCase)
+    suites += unittest.makeSuite(tests.MemoryTestCase)
+    return unittest.TestSuite(suites)
+
+def run(shouldExit=False):
+    """Run the tests."""
+    tests.run(suite(), shouldExit)
+
+if __name__ == "__main__":
+    run(True)
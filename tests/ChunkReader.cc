@@ -0,0 +1,105 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file ChunkReader.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Test that a ChunkReader drops sets with more chunks than its
+ *        buffer could hold before making room for them, and drops sets
+ *        which run out of time even when no more of their chunks arrive.
+ */
+
+#include <string>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ChunkReader
+#include "boost/test/unit_test.hpp"
+
+#include "activemq/commands/ActiveMQBytesMessage.h"
+
+#include "lsst/ctrl/events.h"
+#include "lsst/ctrl/events/ChunkReader.h"
+#include "lsst/ctrl/events/ChunkWriter.h"
+
+namespace ctrlEvents = lsst::ctrl::events;
+
+namespace {
+
+/* a chunk of size bytes; no session is needed while the set is incomplete */
+struct Chunk : public activemq::commands::ActiveMQBytesMessage {
+    Chunk(std::string const& chunkSet, int chunk, int count, size_t size) {
+        std::string body(size, 'x');
+        setBodyBytes(reinterpret_cast<unsigned char const*>(body.data()), body.size());
+        setStringProperty(ctrlEvents::Event::CHUNKSET, chunkSet);
+        setIntProperty(ctrlEvents::Event::CHUNK, chunk);
+        setIntProperty(ctrlEvents::Event::CHUNKS, count);
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(tooManyChunks) {
+    ctrlEvents::ChunkReader reader;
+    reader.setBufferSize(4 * ctrlEvents::ChunkWriter::MIN_CHUNK_SIZE);
+    BOOST_CHECK_EQUAL(reader.getMaxChunks(), 4u);
+
+    Chunk first("large", 0, 5, 10);
+    BOOST_CHECK(reader.read(&first, 0, NULL) == NULL);
+    BOOST_CHECK_EQUAL(reader.getBufferedSize(), 0u);
+
+    // the rest of the set is ignored, even a chunk small enough to keep
+    Chunk second("large", 1, 5, 10);
+    BOOST_CHECK(reader.read(&second, 0, NULL) == NULL);
+    BOOST_CHECK_EQUAL(reader.getBufferedSize(), 0u);
+
+    // a set which could fit is kept
+    Chunk fits("fits", 0, 4, 10);
+    BOOST_CHECK(reader.read(&fits, 0, NULL) == NULL);
+    BOOST_CHECK_EQUAL(reader.getBufferedSize(), 10u);
+
+    // no buffer is too small for a single chunk
+    reader.setBufferSize(1);
+    BOOST_CHECK_EQUAL(reader.getMaxChunks(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(expiry) {
+    ctrlEvents::ChunkReader reader;
+    reader.setTimeout(1000);
+
+    Chunk first("late", 0, 2, 100);
+    BOOST_CHECK(reader.read(&first, 0, NULL) == NULL);
+    BOOST_CHECK_EQUAL(reader.getBufferedSize(), 100u);
+
+    reader.expire(1000);
+    BOOST_CHECK_EQUAL(reader.getBufferedSize(), 100u);
+    reader.expire(1001);
+    BOOST_CHECK_EQUAL(reader.getBufferedSize(), 0u);
+
+    // the chunk which arrives afterwards is ignored
+    Chunk second("late", 1, 2, 100);
+    BOOST_CHECK(reader.read(&second, 1500, NULL) == NULL);
+    BOOST_CHECK_EQUAL(reader.getBufferedSize(), 0u);
+}
@@ -0,0 +1,112 @@
+#!/usr/bin/env python
+
+# 
+# LSST Data Management System
+#
+# Copyright 2008-2014  AURA/LSST.
+# 
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the LSST License Statement and 
+# the GNU General Public License along with this program.  If not, 
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+
+import os
+import platform
+import unittest
+import lsst.ctrl.events as events
+from lsst.daf.base import PropertySet
+import lsst.utils.tests as tests
+from testEnvironment import TestEnvironment
+
+class ChunkedEventsTestCase(unittest.TestCase):
+    """Test sending large events in chunks"""
+
+    def createTopicName(self, template):
+        return template % ("%s_%d" % (platform.node(), os.getpid()))
+
+    def createEvent(self, locationID, size):
+        ps = PropertySet()
+        ps.setInt("size", size)
+        ps.set("text", "".join([chr(ord("a") + (i * 7919) % 26) for i in range(size)]))
+        return events.StatusEvent("chunkrunid", locationID, ps)
+
+    def assertComplete(self, val, size):
+        self.assertIsNotNone(val)
+        for name in [events.Event.CHUNKSET, events.Event.CHUNK, events.Event.CHUNKS]:
+            self.assertNotIn(name, val.getFilterablePropertyNames())
+        self.assertEqual(val.getRunId(), "chunkrunid")
+
+        ps = val.getCustomPropertySet()
+        self.assertEqual(ps.getInt("size"), size)
+        self.assertEqual(ps.get("text"), "".join([chr(ord("a") + (i * 7919) % 26) for i in range(size)]))
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testTransmitReceive(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = self.createTopicName("test_events_chunks_%s.A")
+
+        recv = events.EventReceiver(broker, topic)
+        trans = events.EventTransmitter(broker, topic)
+        self.assertEqual(trans.getChunkSize(), 0)
+        self.assertRaises(Exception, trans.setChunkSize, 10)
+        trans.setChunkSize(4096)
+        self.assertEqual(trans.getChunkSize(), 4096)
+
+        locationID = events.EventSystem.getDefaultEventSystem().createOriginatorId()
+        for encoding in [events.EventEncodings.JSON, events.EventEncodings.BINARY, events.EventEncodings.SCHEMA]:
+            trans.setEncoding(encoding)
+            trans.publishEvent(self.createEvent(locationID, 100000))
+            trans.publishEvent(self.createEvent(locationID, 10))
+            self.assertComplete(recv.receiveStatusEvent(5000), 100000)
+            self.assertComplete(recv.receiveStatusEvent(5000), 10)
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testBufferSize(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = self.createTopicName("test_events_chunks_%s.B")
+
+        recv = events.EventReceiver(broker, topic)
+        recv.setChunkBufferSize(50000)
+        self.assertEqual(recv.getChunkBufferSize(), 50000)
+        recv.setChunkTimeout(1000)
+        self.assertEqual(recv.getChunkTimeout(), 1000)
+
+        trans = events.EventTransmitter(broker, topic)
+        trans.setChunkSize(4096)
+
+        # the large event does not fit in the buffer, and is dropped
+        locationID = events.EventSystem.getDefaultEventSystem().createOriginatorId()
+        trans.publishEvent(self.createEvent(locationID, 100000))
+        trans.publishEvent(self.createEvent(locationID, 10))
+        self.assertComplete(recv.receiveStatusEvent(5000), 10)
+
+def suite():
+    """Returns a suite containing all the tests cases in this module."""
+    tests.init()
+    suites = []
+    suites += unittest.makeSuite(ChunkedEventsTestCase)
+    suites += unittest.makeSuite(tests.MemoryTestCase)
+    return unittest.TestSuite(suites)
+
+def run(shouldExit=False):
+    """Run the tests."""
+    tests.run(suite(), shouldExit)
+
+if __name__ == "__main__":
+    run(True)
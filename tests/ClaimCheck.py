@@ -0,0 +1,177 @@
+#!/usr/bin/env python
+
+# 
+# LSST Data Management System
+#
+# Copyright 2008-2014  AURA/LSST.
+# 
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the LSST License Statement and 
+# the GNU General Public License along with this program.  If not, 
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+
+import os
+import platform
+import shutil
+import tempfile
+import unittest
+import lsst.ctrl.events as events
+from lsst.daf.base import PropertySet
+import lsst.utils.tests as tests
+from testEnvironment import TestEnvironment
+
+class ClaimCheckTestCase(unittest.TestCase):
+    """Test sending large event bodies by claim check"""
+
+    def setUp(self):
+        self.directory = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.directory)
+
+    def createTopicName(self, template):
+        return template % ("%s_%d" % (platform.node(), os.getpid()))
+
+    def createEvent(self, locationID, size):
+        ps = PropertySet()
+        ps.setInt("size", size)
+        ps.set("values", [float(i) for i in range(size)])
+        return events.StatusEvent("claimrunid", locationID, ps)
+
+    def assertComplete(self, val, size):
+        self.assertIsNotNone(val)
+        self.assertNotIn(events.Event.CLAIMCHECK, val.getFilterablePropertyNames())
+        self.assertEqual(val.getRunId(), "claimrunid")
+
+        ps = val.getCustomPropertySet()
+        self.assertEqual(ps.getInt("size"), size)
+        self.assertEqual(ps.getArray("values"), [float(i) for i in range(size)])
+
+    def claimFiles(self):
+        return [name for name in os.listdir(self.directory) if name.endswith(".claim")]
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testTransmitReceive(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = self.createTopicName("test_events_claim_%s.A")
+
+        recv = events.EventReceiver(broker, topic)
+        self.assertRaises(Exception, recv.addClaimCheckDirectory, os.path.join(self.directory, "missing"))
+        recv.addClaimCheckDirectory(self.directory)
+        trans = events.EventTransmitter(broker, topic)
+        self.assertEqual(trans.getClaimCheckDirectory(), "")
+        self.assertRaises(Exception, trans.setClaimCheckDirectory, os.path.join(self.directory, "missing"))
+        trans.setClaimCheckDirectory(self.directory)
+        trans.setClaimCheckThreshold(10000)
+        self.assertEqual(trans.getClaimCheckThreshold(), 10000)
+
+        locationID = events.EventSystem.getDefaultEventSystem().createOriginatorId()
+        for encoding in [events.EventEncodings.JSON, events.EventEncodings.BINARY, events.EventEncodings.SCHEMA]:
+            trans.setEncoding(encoding)
+            trans.publishEvent(self.createEvent(locationID, 10000))
+            trans.publishEvent(self.createEvent(locationID, 10))
+            self.assertComplete(recv.receiveStatusEvent(5000), 10000)
+            self.assertComplete(recv.receiveStatusEvent(5000), 10)
+
+        # small bodies are sent in their messages
+        self.assertEqual(len(self.claimFiles()), 3)
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testRemoval(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = self.createTopicName("test_events_claim_%s.B")
+
+        recv = events.EventReceiver(broker, topic)
+        recv.addClaimCheckDirectory(self.directory)
+        self.assertFalse(recv.getClaimCheckRemoval())
+        recv.setClaimCheckRemoval(True)
+        recv.setClaimCheckRetention(1000)
+        self.assertEqual(recv.getClaimCheckRetention(), 1000)
+
+        trans = events.EventTransmitter(broker, topic)
+        trans.setClaimCheckDirectory(self.directory)
+        trans.setClaimCheckThreshold(10000)
+
+        locationID = events.EventSystem.getDefaultEventSystem().createOriginatorId()
+        trans.publishEvent(self.createEvent(locationID, 10000))
+        self.assertComplete(recv.receiveStatusEvent(5000), 10000)
+        self.assertEqual(self.claimFiles(), [])
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testRemovalWithNameCompression(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = self.createTopicName("test_events_claim_%s.D")
+
+        recv = events.EventReceiver(broker, topic)
+        recv.addClaimCheckDirectory(self.directory)
+        recv.setClaimCheckRemoval(True)
+
+        trans = events.EventTransmitter(broker, topic)
+        trans.setClaimCheckDirectory(self.directory)
+        trans.setClaimCheckThreshold(10000)
+        trans.setNameCompression(True)
+
+        # the body is only decoded, to remove its file, once the receiver
+        # has the name codes it was written with
+        locationID = events.EventSystem.getDefaultEventSystem().createOriginatorId()
+        for i in range(2):
+            ps = PropertySet()
+            ps.setInt("size", 10000)
+            ps.set("values", [float(j) for j in range(10000)])
+            ps.set("##hash", "a name which starts with a code marker")
+            trans.publishEvent(events.StatusEvent("claimrunid", locationID, ps))
+        for i in range(2):
+            val = recv.receiveStatusEvent(5000)
+            self.assertComplete(val, 10000)
+            self.assertEqual(val.getCustomPropertySet().get("##hash"), "a name which starts with a code marker")
+        self.assertEqual(self.claimFiles(), [])
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testUnknownDirectory(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = self.createTopicName("test_events_claim_%s.C")
+
+        # a receiver which was not given the directory discards the event
+        recv = events.EventReceiver(broker, topic)
+        trans = events.EventTransmitter(broker, topic)
+        trans.setClaimCheckDirectory(self.directory)
+        trans.setClaimCheckThreshold(10000)
+
+        locationID = events.EventSystem.getDefaultEventSystem().createOriginatorId()
+        trans.publishEvent(self.createEvent(locationID, 10000))
+        trans.publishEvent(self.createEvent(locationID, 10))
+        self.assertComplete(recv.receiveStatusEvent(5000), 10)
+        self.assertEqual(len(self.claimFiles()), 1)
+
+def suite():
+    """Returns a suite containing all the tests cases in this module."""
+    tests.init()
+    suites = []
+    suites += unittest.makeSuite(ClaimCheckTestCase)
+    suites += unittest.makeSuite(tests.MemoryTestCase)
+    return unittest.TestSuite(suites)
+
+def run(shouldExit=False):
+    """Run the tests."""
+    tests.run(suite(), shouldExit)
+
+if __name__ == "__main__":
+    run(True)
@@ -0,0 +1,144 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file ClaimCheckReader.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Test that a ClaimCheckReader only accepts the paths of claim check
+ *        files directly in the directories it was given, once symbolic
+ *        links are resolved, and only removes files from those.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ClaimCheckReader
+#include "boost/test/unit_test.hpp"
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/ctrl/events.h"
+#include "lsst/ctrl/events/ClaimCheckReader.h"
+#include "lsst/ctrl/events/ClaimCheckWriter.h"
+
+namespace ctrlEvents = lsst::ctrl::events;
+
+namespace {
+
+/* a temporary directory holding a claim check directory, a file outside of
+ * it, and links from inside it to the outside */
+struct Directories {
+    Directories() {
+        char name[] = "/tmp/claimCheckReaderXXXXXX";
+        root = mkdtemp(name);
+        claims = root + "/claims";
+        mkdir(claims.c_str(), 0700);
+        claim = claims + "/event" + ctrlEvents::ClaimCheckWriter::SUFFIX;
+        outside = root + "/secret" + ctrlEvents::ClaimCheckWriter::SUFFIX;
+        touch(claim);
+        touch(outside);
+        touch(claims + "/other.txt");
+        symlink(outside.c_str(), (claims + "/link" + ctrlEvents::ClaimCheckWriter::SUFFIX).c_str());
+        symlink(root.c_str(), (claims + "/up").c_str());
+    }
+
+    ~Directories() {
+        std::string command = "rm -rf " + root;
+        BOOST_CHECK_EQUAL(system(command.c_str()), 0);
+    }
+
+    static void touch(std::string const& path) {
+        FILE* file = fopen(path.c_str(), "w");
+        fclose(file);
+    }
+
+    static bool exists(std::string const& path) {
+        struct stat status;
+        return lstat(path.c_str(), &status) == 0;
+    }
+
+    std::string root;
+    std::string claims;
+    std::string claim;
+    std::string outside;
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(paths) {
+    Directories dirs;
+    ctrlEvents::ClaimCheckReader reader;
+
+    // nothing is accepted until a directory is added
+    BOOST_CHECK(!reader.accepts(dirs.claim));
+    BOOST_CHECK_THROW(reader.addDirectory(dirs.root + "/missing"), lsst::pex::exceptions::RuntimeError);
+    BOOST_CHECK_THROW(reader.addDirectory(dirs.claim), lsst::pex::exceptions::RuntimeError);
+    reader.addDirectory(dirs.claims);
+
+    BOOST_CHECK(reader.accepts(dirs.claim));
+    BOOST_CHECK(reader.accepts(dirs.claims + "/../claims/event" + ctrlEvents::ClaimCheckWriter::SUFFIX));
+    BOOST_CHECK(!reader.accepts(dirs.outside));
+    BOOST_CHECK(!reader.accepts(dirs.claims + "/other.txt"));
+    BOOST_CHECK(!reader.accepts(dirs.claims + "/missing" + ctrlEvents::ClaimCheckWriter::SUFFIX));
+    BOOST_CHECK(!reader.accepts(dirs.claims + "/link" + ctrlEvents::ClaimCheckWriter::SUFFIX));
+    BOOST_CHECK(!reader.accepts(dirs.claims + "/up/secret" + ctrlEvents::ClaimCheckWriter::SUFFIX));
+    BOOST_CHECK(!reader.accepts("/etc/passwd"));
+    BOOST_CHECK(!reader.accepts(""));
+}
+
+BOOST_AUTO_TEST_CASE(removal) {
+    Directories dirs;
+    ctrlEvents::ClaimCheckReader reader;
+    reader.addDirectory(dirs.claims);
+    reader.setRemoveOnRead(true);
+    reader.setRetention(1000);
+
+    // a rejected claim leaves its file alone
+    ctrlEvents::Event event;
+    BOOST_CHECK(!reader.read(event, dirs.outside, 0));
+    BOOST_CHECK(Directories::exists(dirs.outside));
+
+    // the sweep only removes claim check files from the added directory,
+    // and not the targets of links in it
+    reader.setRemoveOnRead(false);
+    BOOST_CHECK(reader.read(event, dirs.claim, 0));
+    reader.sweep(time(NULL) * 1000LL + 10000);
+    BOOST_CHECK(!Directories::exists(dirs.claim));
+    BOOST_CHECK(Directories::exists(dirs.claims + "/other.txt"));
+    BOOST_CHECK(Directories::exists(dirs.outside));
+
+    // a file removed on receipt is kept until its event is complete
+    Directories::touch(dirs.claim);
+    reader.setRemoveOnRead(true);
+    BOOST_CHECK(reader.read(event, dirs.claim, 0));
+    BOOST_CHECK(Directories::exists(dirs.claim));
+    reader.release(event, dirs.claim);
+    BOOST_CHECK(!Directories::exists(dirs.claim));
+}
@@ -0,0 +1,170 @@
+#!/usr/bin/env python
+
+# 
+# LSST Data Management System
+#
+# Copyright 2008-2016  AURA/LSST.
+# 
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the LSST License Statement and 
+# the GNU General Public License along with this program.  If not, 
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+
+import os
+import platform
+import unittest
+import lsst.ctrl.events as events
+from lsst.daf.base import PropertySet
+import lsst.utils.tests as tests
+from testEnvironment import TestEnvironment
+
+class CompactOriginatorTestCase(unittest.TestCase):
+    """Test sending originators and destinations as packed IDs"""
+
+    def createTopicName(self, template):
+        return template % ("%s_%d" % (platform.node(), os.getpid()))
+
+    def assertSameLocation(self, location, expected):
+        self.assertEqual(location.getHostName(), expected.getHostName())
+        self.assertEqual(location.getProcessID(), expected.getProcessID())
+        self.assertEqual(location.getLocalID(), expected.getLocalID())
+
+    def testPackedId(self):
+        location = events.LocationId("compact.example", 1234, 5)
+        events.HostTable.getDefaultHostTable().intern("compact.example")
+        packed = location.getId()
+        self.assertGreaterEqual(packed, 0)
+        self.assertEqual(events.LocationId.getHostCode(packed),
+                         events.HostTable.getCode("compact.example"))
+        self.assertSameLocation(events.LocationId(packed), location)
+        self.assertEqual(events.LocationId(location).getId(), packed)
+
+        # a host which has not been defined has no name
+        unknown = events.LocationId(events.LocationId.pack(events.HostTable.getCode("unknown.example"), 1, 2))
+        self.assertEqual(unknown.getHostName(), "")
+        self.assertEqual(unknown.getProcessID(), 1)
+        self.assertEqual(unknown.getLocalID(), 2)
+
+        # a local id which does not fit has no ID
+        self.assertEqual(events.LocationId("compact.example", 1234, 1 << events.LocationId.LOCAL_BITS).getId(), -1)
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testTransmitReceive(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = self.createTopicName("test_events_compact_%s")
+
+        system = events.EventSystem.getDefaultEventSystem()
+        first = system.createOriginatorId()
+        second = system.createOriginatorId()
+
+        sel = "%s = %d" % (events.StatusEvent.ORIG_ID, second.getId())
+        recv = events.EventReceiver(broker, topic, sel)
+        trans = events.EventTransmitter(broker, topic)
+        self.assertFalse(trans.getCompactOriginator())
+        trans.setCompactOriginator(True)
+        self.assertTrue(trans.getCompactOriginator())
+
+        ps = PropertySet()
+        ps.set("myname", "myname")
+        trans.publishEvent(events.StatusEvent("compactrunid", first, ps))
+        trans.publishEvent(events.StatusEvent("compactrunid", second, ps))
+
+        # only the event of the selected originator is received, with the
+        # properties of its originator
+        val = recv.receiveStatusEvent(5000)
+        self.assertIsNotNone(val)
+        names = val.getFilterablePropertyNames()
+        self.assertNotIn(events.StatusEvent.ORIG_ID, names)
+        self.assertNotIn(events.Event.HOSTS, names)
+        self.assertIn(events.StatusEvent.ORIG_HOSTNAME, names)
+        self.assertSameLocation(val.getOriginator(), second)
+        self.assertIsNone(recv.receiveStatusEvent(1))
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testCommandEvent(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = self.createTopicName("test_events_compact_command_%s")
+
+        system = events.EventSystem.getDefaultEventSystem()
+        originator = system.createOriginatorId()
+        destination = system.createOriginatorId()
+
+        sel = "%s = %d" % (events.CommandEvent.DEST_ID, destination.getId())
+        recv = events.EventReceiver(broker, topic, sel)
+        trans = events.EventTransmitter(broker, topic)
+        trans.setCompactOriginator(True)
+
+        ps = PropertySet()
+        ps.set("command", "stop")
+        trans.publishEvent(events.CommandEvent("compactrunid", originator, destination, ps))
+
+        val = recv.receiveCommandEvent(5000)
+        self.assertIsNotNone(val)
+        self.assertSameLocation(val.getOriginator(), originator)
+        self.assertSameLocation(val.getDestination(), destination)
+        self.assertEqual(val.getCustomPropertySet().get("command"), "stop")
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testConflictingHost(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = self.createTopicName("test_events_compact_conflict_%s")
+
+        # these two names have the same code
+        first = "host53866.example"
+        second = "host1018390.example"
+        code = events.HostTable.getCode(first)
+        self.assertEqual(events.HostTable.getCode(second), code)
+
+        recv = events.EventReceiver(broker, topic)
+        trans = events.EventTransmitter(broker, topic)
+        trans.setCompactOriginator(True)
+
+        ps = PropertySet()
+        ps.set("myname", "myname")
+        trans.publishEvent(events.StatusEvent("compactrunid", events.LocationId(first, 1, 1), ps))
+
+        # once the receiver learns of the second host, the event which was
+        # sent packed is still received, with its ID left packed
+        events.HostTable.getDefaultHostTable().intern(second)
+        self.assertTrue(events.HostTable.getDefaultHostTable().isConflicting(code))
+        val = recv.receiveStatusEvent(5000)
+        self.assertIsNotNone(val)
+        self.assertNotIn(events.StatusEvent.ORIG_HOSTNAME, val.getFilterablePropertyNames())
+        self.assertEqual(val.getPropertySet().getLongLong(events.StatusEvent.ORIG_ID),
+                         events.LocationId.pack(code, 1, 1))
+        originator = val.getOriginator()
+        self.assertEqual(originator.getHostName(), "")
+        self.assertEqual(originator.getProcessID(), 1)
+        self.assertEqual(originator.getLocalID(), 1)
+
+def suite():
+    """Returns a suite containing all the tests cases in this module."""
+    tests.init()
+    suites = []
+    suites += unittest.makeSuite(CompactOriginatorTestCase)
+    suites += unittest.makeSuite(tests.MemoryTestCase)
+    return unittest.TestSuite(suites)
+
+def run(shouldExit=False):
+    """Run the tests."""
+    tests.run(suite(), shouldExit)
+
+if __name__ == "__main__":
+    run(True)
@@ -0,0 +1,110 @@
+#!/usr/bin/env python
+
+# 
+# LSST Data Management System
+#
+# Copyright 2008-2014  AURA/LSST.
+# 
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the LSST License Statement and 
+# the GNU General Public License along with this program.  If not, 
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import os
+import platform
+import unittest
+import lsst.ctrl.events as events
+from lsst.daf.base import PropertySet
+import lsst.pex.exceptions as ex
+import lsst.utils.tests as tests
+from testEnvironment import TestEnvironment
+
+class CompressionTestCase(unittest.TestCase):
+    """Test the compression of large event bodies"""
+
+    def createTrace(self):
+        return "".join(["  at frame %d in lsst::ctrl::events::Event\n" % (i % 37) for i in range(2000)])
+
+    def testRoundTrip(self):
+        for text in ["", "x", self.createTrace()]:
+            self.assertEqual(events.PayloadCompressor.inflate(events.PayloadCompressor.deflate(text)), text)
+
+        text = self.createTrace()
+        self.assertLess(len(events.PayloadCompressor.deflate(text)), len(text) / 10)
+
+    def testMalformed(self):
+        data = events.PayloadCompressor.deflate(self.createTrace())
+        for bad in ['', data[:3], data[:-4], '\x01\x00\x00\x00' + data[4:], data[:4] + 'garbage']:
+            self.assertRaises(ex.Exception, events.PayloadCompressor.inflate, bad)
+
+    def testThreshold(self):
+        compressor = events.PayloadCompressor()
+        self.assertEqual(compressor.getThreshold(), 0)
+        self.assertFalse(compressor.isCompressing())
+
+        compressor.setThreshold(1024)
+        self.assertEqual(compressor.getThreshold(), 1024)
+        self.assertTrue(compressor.isCompressing())
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testTransmitReceive(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = "test_events_compression_%s_%d" % (platform.node(), os.getpid())
+
+        recv = events.EventReceiver(broker, topic)
+        trans = events.EventTransmitter(broker, topic)
+        self.assertEqual(trans.getCompressionThreshold(), 0)
+        trans.setCompressionThreshold(4096)
+
+        trace = self.createTrace()
+        small = PropertySet()
+        small.set("trace", "short")
+        large = PropertySet()
+        large.set("trace", trace)
+        large.setInt("value", 12)
+
+        for encoding in [events.EventEncodings.JSON, events.EventEncodings.BINARY]:
+            trans.setEncoding(encoding)
+            trans.publishEvent(events.Event("compressrunid", large))
+            trans.publishEvent(events.Event("compressrunid", small))
+        self.assertLess(trans.getCompressionRatio(), 0.1)
+
+        for i in range(2):
+            val = recv.receiveEvent()
+            self.assertIsNotNone(val)
+            self.assertNotIn(events.Event.COMPRESSION, val.getFilterablePropertyNames())
+            self.assertEqual(val.getCustomPropertySet().getString("trace"), trace)
+            self.assertEqual(val.getCustomPropertySet().getInt("value"), 12)
+
+            val = recv.receiveEvent()
+            self.assertIsNotNone(val)
+            self.assertEqual(val.getCustomPropertySet().getString("trace"), "short")
+
+def suite():
+    """Returns a suite containing all the tests cases in this module."""
+    tests.init()
+    suites = []
+    suites += unittest.makeSuite(CompressionTestCase)
+    suites += unittest.makeSuite(tests.MemoryTestCase)
+    return unittest.TestSuite(suites)
+
+def run(shouldExit=False):
+    """Run the tests."""
+    tests.run(suite(), shouldExit)
+
+if __name__ == "__main__":
+    run(True)
@@ -0,0 +1,148 @@
+#!/usr/bin/env python
+
+# 
+# LSST Data Management System
+#
+# Copyright 2008-2014  AURA/LSST.
+# 
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the LSST License Statement and 
+# the GNU General Public License along with this program.  If not, 
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+
+import os
+import platform
+import unittest
+import lsst.ctrl.events as events
+from lsst.daf.base import PropertySet
+import lsst.utils.tests as tests
+from testEnvironment import TestEnvironment
+
+class DeltaEncodingTestCase(unittest.TestCase):
+    """Test the delta encoding of StatusEvents"""
+
+    def createTopicName(self, template):
+        return template % ("%s_%d" % (platform.node(), os.getpid()))
+
+    def createEvent(self, locationID, counter):
+        ps = PropertySet()
+        ps.setInt("counter", counter)
+        ps.set("stage", "processing")
+        ps.set("values", [0.5] * 100)
+        ps.set("logger.status", "my logger special status")
+        return events.StatusEvent("deltarunid", locationID, ps)
+
+    def assertComplete(self, val, counter):
+        self.assertIsNotNone(val)
+        self.assertNotIn(events.Event.SEQUENCE, val.getFilterablePropertyNames())
+        self.assertNotIn(events.Event.DELTA, val.getFilterablePropertyNames())
+        self.assertEqual(val.getRunId(), "deltarunid")
+
+        ps = val.getCustomPropertySet()
+        self.assertEqual(ps.getInt("counter"), counter)
+        self.assertEqual(ps.get("stage"), "processing")
+        self.assertEqual(ps.getArray("values"), [0.5] * 100)
+        self.assertEqual(ps.get("logger.status"), "my logger special status")
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testTransmitReceive(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = self.createTopicName("test_events_delta_%s.A")
+
+        recv = events.EventReceiver(broker, topic)
+        trans = events.EventTransmitter(broker, topic)
+        self.assertFalse(trans.getDeltaEncoding())
+        trans.setDeltaEncoding(True)
+        trans.setKeyframeInterval(4)
+        self.assertEqual(trans.getKeyframeInterval(), 4)
+
+        locationID = events.EventSystem.getDefaultEventSystem().createOriginatorId()
+        for encoding in [events.EventEncodings.JSON, events.EventEncodings.BINARY, events.EventEncodings.SCHEMA]:
+            trans.setEncoding(encoding)
+            for i in range(10):
+                trans.publishEvent(self.createEvent(locationID, i / 3))
+            for i in range(10):
+                self.assertComplete(recv.receiveStatusEvent(), i / 3)
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testLateSubscriber(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = self.createTopicName("test_events_delta_%s.B")
+
+        trans = events.EventTransmitter(broker, topic)
+        trans.setDeltaEncoding(True)
+        trans.setKeyframeInterval(4)
+
+        locationID = events.EventSystem.getDefaultEventSystem().createOriginatorId()
+        trans.publishEvent(self.createEvent(locationID, 0))
+
+        # the deltas which follow the missed keyframe can not be completed,
+        # so the first event received is the next keyframe
+        recv = events.EventReceiver(broker, topic)
+        for i in range(1, 6):
+            trans.publishEvent(self.createEvent(locationID, i))
+
+        self.assertComplete(recv.receiveStatusEvent(5000), 4)
+        self.assertComplete(recv.receiveStatusEvent(5000), 5)
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testSelector(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = self.createTopicName("test_events_delta_%s.C")
+
+        # the selector passes every other event of the originator, so the
+        # deltas it receives follow one it missed, and only the keyframes
+        # are received
+        recv = events.EventReceiver(broker, topic, "RUNID = 'deltarunid'")
+        trans = events.EventTransmitter(broker, topic)
+        trans.setDeltaEncoding(True)
+        trans.setKeyframeInterval(4)
+
+        locationID = events.EventSystem.getDefaultEventSystem().createOriginatorId()
+        for i in range(10):
+            event = self.createEvent(locationID, i)
+            if i % 2 == 1:
+                event.setRunId("otherrunid")
+            trans.publishEvent(event)
+        self.assertComplete(recv.receiveStatusEvent(5000), 0)
+        self.assertComplete(recv.receiveStatusEvent(5000), 4)
+        self.assertComplete(recv.receiveStatusEvent(5000), 8)
+        self.assertIsNone(recv.receiveStatusEvent(1000))
+
+        # an unfiltered run of events after a keyframe is received whole
+        for i in range(10, 14):
+            trans.publishEvent(self.createEvent(locationID, i))
+        self.assertComplete(recv.receiveStatusEvent(5000), 12)
+        self.assertComplete(recv.receiveStatusEvent(5000), 13)
+
+def suite():
+    """Returns a suite containing all the tests cases in this module."""
+    tests.init()
+    suites = []
+    suites += unittest.makeSuite(DeltaEncodingTestCase)
+    suites += unittest.makeSuite(tests.MemoryTestCase)
+    return unittest.TestSuite(suites)
+
+def run(shouldExit=False):
+    """Run the tests."""
+    tests.run(suite(), shouldExit)
+
+if __name__ == "__main__":
+    run(True)
@@ -104,6 +104,86 @@ class EventTestCase(unittest.TestCase):
         event.setEventTime(eventTime)
         self.assertEqual(event.getEventTime(), eventTime)
 
+    def testEventPropertySetShared(self):
+        status = "my special status"
+        root = PropertySet()
+        MYNAME = "myname"
+        root.set(MYNAME, MYNAME)
+        root.set(events.Event.STATUS, status)
+
+        event = events.Event("testrunid", root)
+
+        # the event hands out the same sets until it is changed
+        props = event.getPropertySet()
+        custom = event.getCustomPropertySet()
+        self.assertEqual(event.getPropertySet().toString(), props.toString())
+        self.assertEqual(event.getCustomPropertySet().toString(), custom.toString())
+
+        # changing the event does not change the sets already handed out
+        event.setStatus("changed")
+        self.assertEqual(props.get(events.Event.STATUS), status)
+        self.assertEqual(event.getPropertySet().get(events.Event.STATUS), "changed")
+        self.assertEqual(custom.get(MYNAME), MYNAME)
+        self.assertEqual(event.getCustomPropertySet().nameCount(), 1)
+
+        # nor the set the event was made from
+        self.assertEqual(root.nameCount(), 2)
+
+    def testEventPropertySetCopied(self):
+        root = PropertySet()
+        MYNAME = "myname"
+        root.set(MYNAME, MYNAME)
+        sub = PropertySet()
+        sub.set("value", 1)
+        root.set("sub", sub)
+
+        event = events.Event("testrunid", root)
+
+        # changing a set handed to Python does not change the event
+        props = event.getPropertySet()
+        props.set(MYNAME, "changed")
+        props.set("sub.value", 2)
+        props.set("added", 3)
+        custom = event.getCustomPropertySet()
+        custom.set(MYNAME, "changed")
+        custom.remove("sub")
+
+        props = event.getPropertySet()
+        self.assertEqual(props.get(MYNAME), MYNAME)
+        self.assertEqual(props.get("sub.value"), 1)
+        self.assertFalse(props.exists("added"))
+        custom = event.getCustomPropertySet()
+        self.assertEqual(custom.get(MYNAME), MYNAME)
+        self.assertEqual(custom.get("sub.value"), 1)
+
+    def testEventReset(self):
+        root = PropertySet()
+        MYNAME = "myname"
+        root.set(MYNAME, MYNAME)
+        filterable = PropertySet()
+        filterable.set("FOO", "bar")
+
+        event = events.Event("testrunid", root, filterable)
+        event.setStatus("done")
+
+        # reset leaves the event as if constructed without properties
+        event.reset()
+        self.assertEqual(event.getStatus(), "unknown")
+        self.assertEqual(event.getType(), events.EventTypes.EVENT)
+        self.assertEqual(event.getCustomPropertyNames(), [])
+        self.assertEqual(len(event.getFilterablePropertyNames()), 5)
+
+        # and it can be filled again
+        event.reset(root, filterable)
+        self.assertEqual(event.getCustomPropertyNames(), [MYNAME])
+        self.assertEqual(event.getPropertySet().get("FOO"), "bar")
+
+        originator = events.LocationId()
+        status = events.StatusEvent(originator, root)
+        status.reset()
+        self.assertEqual(status.getType(), events.EventTypes.STATUS)
+        self.assertEqual(status.getOriginator().getLocalID(), originator.getLocalID())
+
 
 def suite():
     """Returns a suite containing all the tests cases in this module."""
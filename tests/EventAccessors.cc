@@ -0,0 +1,261 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file EventAccessors.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Test that the accessors of the reserved header values of an Event
+ *        allocate nothing once the Event has its storage, by counting the
+ *        calls to operator new, that dates are written as asctime
+ *        writes them, from several threads at once, that several
+ *        threads may read one Event whose body has not been decoded yet,
+ *        and that a copy of the properties is made only once.
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE EventAccessors
+#include "boost/test/unit_test.hpp"
+#include "boost/scoped_ptr.hpp"
+
+#include "activemq/commands/ActiveMQTextMessage.h"
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/pex/exceptions.h"
+#include "lsst/ctrl/events.h"
+#include "lsst/ctrl/events/DateFormat.h"
+
+using lsst::daf::base::PropertySet;
+namespace dafBase = lsst::daf::base;
+namespace ctrlEvents = lsst::ctrl::events;
+
+namespace {
+
+std::atomic<long> allocations(0);
+
+/* the date of nsecs as written by asctime_r */
+std::string asctimeDate(long long nsecs) {
+    struct tm time = dafBase::DateTime(nsecs).gmtime();
+    char buf[64];
+    return asctime_r(&time, buf);
+}
+
+std::vector<long long> const& sampleTimes() {
+    static std::vector<long long> times;
+    if (times.empty()) {
+        long long const second = 1000000000LL;
+        // single and double digit days, hours and years around the epoch
+        times.push_back(0);
+        times.push_back(86399 * second);
+        times.push_back(951782400LL * second);   // 29 Feb 2000
+        times.push_back(1234567890LL * second);
+        times.push_back(dafBase::DateTime::now().nsecs());
+        for (long long t = 1000000000LL; t < 2000000000LL; t += 7654321) {
+            times.push_back(t * second);
+        }
+    }
+    return times;
+}
+
+}
+
+void* operator new(std::size_t size) {
+    allocations++;
+    void* p = malloc(size ? size : 1);
+    if (p == NULL)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+BOOST_AUTO_TEST_CASE(dates) {
+    for (long long nsecs : sampleTimes()) {
+        std::string date;
+        ctrlEvents::DateFormat::format(nsecs, date);
+        BOOST_CHECK_EQUAL(date, asctimeDate(nsecs));
+    }
+
+    PropertySet ps;
+    ctrlEvents::Event event("run", ps);
+    event.setEventTime(1234567890LL * 1000000000LL);
+    BOOST_CHECK_EQUAL(event.getEventDate(), asctimeDate(event.getEventTime()));
+
+    // an event which has not been published has no publication date
+    BOOST_CHECK_EQUAL(event.getPubDate(), "");
+    event.setPubTime(event.getEventTime());
+    BOOST_CHECK_EQUAL(event.getPubDate(), event.getEventDate());
+}
+
+BOOST_AUTO_TEST_CASE(concurrentDates) {
+    std::vector<long long> const& times = sampleTimes();
+    std::atomic<int> mismatches(0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.push_back(std::thread([&times, &mismatches, i]() {
+            std::string date;
+            for (size_t j = i; j < times.size(); j++) {
+                ctrlEvents::DateFormat::format(times[j], date);
+                if (date != asctimeDate(times[j]))
+                    mismatches++;
+            }
+        }));
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    BOOST_CHECK_EQUAL(mismatches.load(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(noAllocations) {
+    PropertySet ps;
+    ctrlEvents::Event event("a run id longer than short strings", ps);
+    event.setStatus("a status longer than short strings");
+    event.setTopic("a topic longer than short strings");
+    std::string date;
+    event.getEventDate(date);
+
+    long before = allocations;
+    size_t length = 0;
+    for (int i = 0; i < 100; i++) {
+        length += event.getType().size();
+        length += event.getStatus().size();
+        length += event.getTopic().size();
+        length += event.getRunId().size();
+        event.getEventDate(date);
+        event.setStatus("another status, no longer");
+        event.setTopic("another topic, no longer");
+        event.setRunId("another run id, no longer");
+    }
+    BOOST_CHECK_EQUAL(allocations - before, 0);
+    BOOST_CHECK(length > 0);
+
+    // the references stay valid until the values are set again
+    std::string const& status = event.getStatus();
+    BOOST_CHECK_EQUAL(status, "another status, no longer");
+    event.setStatus(std::string("done"));
+    BOOST_CHECK_EQUAL(status, "done");
+}
+
+BOOST_AUTO_TEST_CASE(copies) {
+    PropertySet ps;
+    for (int i = 0; i < 20; i++) {
+        ps.set("name" + std::to_string(i), i);
+    }
+    ctrlEvents::Event event("run", ps);
+
+    // a copy costs no more than the shared view, whether or not the view
+    // has been made
+    long before = allocations;
+    event.copyPropertySet();
+    long copyCost = allocations - before;
+    before = allocations;
+    CONST_PTR(PropertySet) view = event.getPropertySet();
+    long viewCost = allocations - before;
+    BOOST_CHECK(copyCost <= viewCost);
+    before = allocations;
+    PTR(PropertySet) copy = event.copyPropertySet();
+    BOOST_CHECK(allocations - before <= viewCost);
+
+    // and changing it changes neither the view nor the Event
+    copy->set("name0", 99);
+    BOOST_CHECK_EQUAL(view->get<int>("name0"), 0);
+    BOOST_CHECK_EQUAL(event.getPropertySet()->get<int>("name0"), 0);
+
+    PTR(PropertySet) custom = event.copyCustomPropertySet();
+    BOOST_CHECK(!custom->exists(ctrlEvents::Event::RUNID));
+    custom->set("name1", 99);
+    BOOST_CHECK_EQUAL(event.getCustomPropertySet()->get<int>("name1"), 1);
+    BOOST_CHECK_EQUAL(event.copyCustomPropertySet()->get<int>("name1"), 1);
+}
+
+BOOST_AUTO_TEST_CASE(customRunId) {
+    PropertySet ps;
+    ps.set(ctrlEvents::Event::RUNID, std::string("custom"));
+    ctrlEvents::Event event(ps);
+    BOOST_CHECK_EQUAL(event.getRunId(), "custom");
+
+    event.setRunId("reserved");
+    BOOST_CHECK_EQUAL(event.getRunId(), "reserved");
+    BOOST_CHECK(!event.getCustomPropertySet()->exists(ctrlEvents::Event::RUNID));
+
+    ctrlEvents::Event empty;
+    BOOST_CHECK_THROW(empty.getRunId(), lsst::pex::exceptions::RuntimeError);
+}
+
+BOOST_AUTO_TEST_CASE(concurrentReaders) {
+    ctrlEvents::LocationId originator;
+    PropertySet ps;
+    for (int i = 0; i < 20; i++)
+        ps.set("value" + std::to_string(i), i);
+    ctrlEvents::StatusEvent sent("run", originator, ps);
+    sent.setTopic("topic");
+    sent.setPubTime(1);
+    activemq::commands::ActiveMQTextMessage msg;
+    sent.marshall(&msg);
+
+    PropertySet custom;
+    custom.set(ctrlEvents::Event::RUNID, std::string("custom"));
+    ctrlEvents::Event customEvent(custom);
+
+    // each round reads a new event, whose body is decoded by whichever
+    // thread gets there first
+    std::atomic<int> mismatches(0);
+    for (int round = 0; round < 20; round++) {
+        ctrlEvents::StatusEvent received(&msg);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; i++) {
+            threads.push_back(std::thread([&received, &customEvent, &mismatches, i]() {
+                if ((i % 2) == 0) {
+                    if (received.getCustomPropertySet()->get<int>("value19") != 19)
+                        mismatches++;
+                } else if (received.getPropertySet()->get<int>("value0") != 0) {
+                    mismatches++;
+                }
+                boost::scoped_ptr<ctrlEvents::LocationId> id(received.getOriginator());
+                if ((received.getRunId() != "run") || (id->getHostName().empty()))
+                    mismatches++;
+                if (customEvent.getRunId() != "custom")
+                    mismatches++;
+            }));
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        BOOST_CHECK_EQUAL(received.getCustomPropertyNames().size(), 20u);
+    }
+    BOOST_CHECK_EQUAL(mismatches.load(), 0);
+}
@@ -189,6 +189,31 @@ class TestLog(unittest.TestCase):
         self.assertValidMessage(recv.receiveEvent(), "This is DEBUG")
 
 
+###############################################################################
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testOriginator(self):
+        testEnv = TestEnvironment()
+        topic = testEnv.getLoggingTopic()
+        confStr = "log4j.rootLogger=TRACE, EA\n"
+        confStr += "log4j.appender.EA=EventAppender\n"
+        confStr += "log4j.appender.EA.BROKER="+testEnv.getBroker()+"\n"
+        confStr += "log4j.appender.EA.TOPIC="+topic+"\n"
+
+        self.configure(confStr)
+
+        # every record is sent from the same originator, so that it keeps
+        # a local id which fits in a packed ID
+        recv = events.EventReceiver(testEnv.getBroker(), topic)
+        for i in range(600):
+            log.info("record %d" % i)
+        localIDs = set()
+        for i in range(600):
+            event = recv.receiveEvent()
+            self.assertValidMessage(event, "record %d" % i)
+            localIDs.add(event.getPropertySet().getInt(events.StatusEvent.ORIG_LOCALID))
+        self.assertEqual(len(localIDs), 1)
+
 ###############################################################################
 
     @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
@@ -0,0 +1,115 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file EventFactory.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Measure what receiving an Event allocates, by counting the calls
+ *        to operator new: the Event and its reference count take one
+ *        allocation, and the rest is its properties.
+ */
+
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE EventFactory
+#include "boost/test/unit_test.hpp"
+
+#include "activemq/commands/ActiveMQTextMessage.h"
+
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/ctrl/events.h"
+#include "lsst/ctrl/events/EventFactory.h"
+
+using lsst::daf::base::PropertySet;
+namespace ctrlEvents = lsst::ctrl::events;
+
+namespace {
+
+long allocations = 0;
+
+/* a message as a receiver gets it, with the body and header of event */
+void marshall(ctrlEvents::Event& event, activemq::commands::ActiveMQTextMessage& msg) {
+    event.setTopic("topic");
+    event.setPubTime(1);
+    event.marshall(&msg);
+}
+
+}
+
+void* operator new(std::size_t size) {
+    allocations++;
+    void* p = malloc(size ? size : 1);
+    if (p == NULL)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+BOOST_AUTO_TEST_CASE(createEvent) {
+    ctrlEvents::LocationId originator;
+    PropertySet ps;
+    for (int i = 0; i < 10; i++)
+        ps.set("value" + std::to_string(i), i);
+    ctrlEvents::StatusEvent sent("myrun", originator, ps);
+    activemq::commands::ActiveMQTextMessage msg;
+    marshall(sent, msg);
+
+    // warm up whatever is allocated once
+    ctrlEvents::EventFactory::createEvent(&msg)->getPropertySet();
+
+    long before = allocations;
+    {
+        ctrlEvents::StatusEvent event(&msg);
+    }
+    long constructed = allocations - before;
+
+    before = allocations;
+    {
+        PTR(ctrlEvents::Event) event = ctrlEvents::EventFactory::createEvent(&msg);
+        BOOST_CHECK(boost::dynamic_pointer_cast<ctrlEvents::StatusEvent>(event));
+    }
+    long created = allocations - before;
+
+    // the Event and its reference count are allocated together
+    BOOST_CHECK_EQUAL(created, constructed + 1);
+
+    before = allocations;
+    {
+        PTR(ctrlEvents::Event) event = ctrlEvents::EventFactory::createEvent(&msg);
+        BOOST_CHECK_EQUAL(event->getCustomPropertySet()->get<int>("value9"), 9);
+    }
+    long decoded = allocations - before;
+
+    // decoding the properties allocates many times more than the Event
+    BOOST_TEST_MESSAGE("allocations: event " << created << ", decoded with 10 properties " << decoded);
+    BOOST_CHECK_GT(decoded, 2 * created);
+}
@@ -0,0 +1,230 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file EventPool.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Test that Events reused through reset() and an EventPool reach a
+ *        steady state in which publishing allocates nothing, by counting
+ *        the calls to operator new.
+ */
+
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE EventPool
+#include "boost/test/unit_test.hpp"
+#include "boost/scoped_ptr.hpp"
+
+#include "activemq/commands/ActiveMQTextMessage.h"
+
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/pex/exceptions.h"
+#include "lsst/ctrl/events.h"
+#include "lsst/ctrl/events/EventPool.h"
+#include "lsst/ctrl/events/EventTypes.h"
+
+using lsst::daf::base::PropertySet;
+namespace ctrlEvents = lsst::ctrl::events;
+
+namespace {
+
+long allocations = 0;
+
+/* a message which keeps nothing, so that marshalling into it only
+ * allocates what the Event itself allocates */
+class NullMessage : public activemq::commands::ActiveMQTextMessage {
+public:
+    NullMessage() : properties(0) {}
+
+    virtual void setBooleanProperty(std::string const&, bool) { properties++; }
+    virtual void setShortProperty(std::string const&, short) { properties++; }
+    virtual void setIntProperty(std::string const&, int) { properties++; }
+    virtual void setLongProperty(std::string const&, long long) { properties++; }
+    virtual void setDoubleProperty(std::string const&, double) { properties++; }
+    virtual void setFloatProperty(std::string const&, float) { properties++; }
+    virtual void setStringProperty(std::string const&, std::string const&) { properties++; }
+
+    using activemq::commands::ActiveMQTextMessage::setText;
+    virtual void setText(std::string const&) {}
+
+    int properties;
+};
+
+}
+
+void* operator new(std::size_t size) {
+    allocations++;
+    void* p = malloc(size ? size : 1);
+    if (p == NULL)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+BOOST_AUTO_TEST_CASE(reset) {
+    ctrlEvents::LocationId originator;
+    PropertySet ps;
+    ps.set("myname", std::string("myname"));
+    PropertySet filterable;
+    filterable.set("FOO", 3);
+
+    ctrlEvents::StatusEvent event("myrun", originator, ps, filterable);
+    event.setStatus("done");
+    event.reset();
+
+    // the type and originator stay, everything else is as constructed
+    BOOST_CHECK_EQUAL(event.getType(), ctrlEvents::EventTypes::STATUS);
+    BOOST_CHECK_EQUAL(event.getStatus(), "unknown");
+    BOOST_CHECK_EQUAL(event.getTopic(), ctrlEvents::Event::UNINITIALIZED);
+    BOOST_CHECK(event.getCustomPropertyNames().empty());
+    BOOST_CHECK_EQUAL(event.getFilterablePropertyNames().size(), 8u);
+    BOOST_CHECK_THROW(event.getRunId(), lsst::pex::exceptions::RuntimeError);
+    boost::scoped_ptr<ctrlEvents::LocationId> id(event.getOriginator());
+    BOOST_CHECK_EQUAL(id->getLocalID(), originator.getLocalID());
+
+    ps.set(ctrlEvents::Event::STATUS, std::string("refilled"));
+    event.reset(ps, filterable);
+    BOOST_CHECK_EQUAL(event.getStatus(), "refilled");
+    BOOST_CHECK_EQUAL(event.getCustomPropertySet()->get<std::string>("myname"), "myname");
+    BOOST_CHECK_EQUAL(event.getPropertySet()->get<int>("FOO"), 3);
+}
+
+BOOST_AUTO_TEST_CASE(resetInPlace) {
+    PropertySet ps;
+    ps.set("value", 1);
+    ps.set("name", std::string("name"));
+    PTR(PropertySet) nested(new PropertySet);
+    nested->set("inner", 2);
+    ps.set("nested", nested);
+    PropertySet filterable;
+    filterable.set("value", 3);
+
+    ctrlEvents::Event event(ps);
+    ctrlEvents::Event copy(event);
+    event.reset(ps, filterable);
+
+    // the copy which shared the properties keeps them, and nothing of ps
+    // is shared with the event
+    BOOST_CHECK_EQUAL(copy.getCustomPropertySet()->get<int>("value"), 1);
+    BOOST_CHECK_EQUAL(copy.getPropertySet()->valueCount("value"), 1u);
+    nested->set("inner", 4);
+    BOOST_CHECK_EQUAL(event.getPropertySet()->get<int>("nested.inner"), 2);
+    BOOST_CHECK_EQUAL(event.getPropertySet()->getArray<int>("value").size(), 2u);
+    BOOST_CHECK_EQUAL(event.getPropertySet()->get<int>("value"), 3);
+
+    event.reset(ps);
+    BOOST_CHECK_EQUAL(event.getCustomPropertySet()->get<int>("value"), 1);
+    BOOST_CHECK_EQUAL(event.getCustomPropertySet()->get<int>("nested.inner"), 4);
+
+    // once the properties are its own, an event copies the values into
+    // them, next to the header properties its type keeps, which costs no
+    // more than emptying it and copying the whole PropertySet
+    ctrlEvents::LocationId originator;
+    ctrlEvents::StatusEvent status(originator, ps);
+    status.reset(ps);
+    long before = allocations;
+    status.reset(ps);
+    long refilled = allocations - before;
+
+    before = allocations;
+    status.reset();
+    PTR(PropertySet) copied = ps.deepCopy();
+    long deepCopied = allocations - before;
+
+    BOOST_CHECK_LE(refilled, deepCopied);
+    boost::scoped_ptr<ctrlEvents::LocationId> id(status.getOriginator());
+    BOOST_CHECK_EQUAL(id->getLocalID(), originator.getLocalID());
+}
+
+BOOST_AUTO_TEST_CASE(steadyState) {
+    ctrlEvents::Event prototype;
+    ctrlEvents::EventPool<ctrlEvents::Event> pool(prototype, 4);
+    NullMessage msg;
+    std::string const runid("run");
+    std::string const status("ok");
+
+    auto publish = [&]() {
+        PTR(ctrlEvents::Event) event = pool.acquire();
+        event->setRunId(runid);
+        event->setStatus(status);
+        event->updateEventTime();
+        event->marshall(&msg);
+        pool.release(std::move(event));
+    };
+
+    // the first publications size the storage which is kept
+    for (int i = 0; i < 10; i++) {
+        publish();
+    }
+    BOOST_CHECK_EQUAL(pool.size(), 1u);
+
+    long before = allocations;
+    for (int i = 0; i < 1000; i++) {
+        publish();
+    }
+    BOOST_CHECK_EQUAL(allocations - before, 0);
+    BOOST_CHECK_EQUAL(msg.properties, 1010 * 6);
+}
+
+BOOST_AUTO_TEST_CASE(refill) {
+    ctrlEvents::Event prototype;
+    ctrlEvents::EventPool<ctrlEvents::Event> pool(prototype);
+    NullMessage msg;
+    PropertySet ps;
+    ps.set("value", 1);
+    ps.set("name", std::string("name"));
+
+    for (int i = 0; i < 10; i++) {
+        PTR(ctrlEvents::Event) event = pool.acquire();
+        event->reset(ps);
+        event->marshall(&msg);
+        pool.release(std::move(event));
+    }
+
+    // the property values are still allocated by their PropertySet, but
+    // less is allocated than for a new Event
+    long before = allocations;
+    PTR(ctrlEvents::Event) event = pool.acquire();
+    event->reset(ps);
+    event->marshall(&msg);
+    pool.release(std::move(event));
+    long pooled = allocations - before;
+
+    before = allocations;
+    {
+        ctrlEvents::Event fresh(ps);
+        fresh.marshall(&msg);
+    }
+    long constructed = allocations - before;
+
+    BOOST_CHECK_LT(pooled, constructed);
+}
@@ -0,0 +1,135 @@
+#!/usr/bin/env python
+
+# 
+# LSST Data Management System
+#
+# Copyright 2008-2014  AURA/LSST.
+# 
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the LSST License Statement and 
+# the GNU General Public License along with this program.  If not, 
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import os
+import platform
+import unittest
+import lsst.ctrl.events as events
+from lsst.daf.base import PropertySet
+import lsst.pex.exceptions as ex
+import lsst.utils.tests as tests
+from testEnvironment import TestEnvironment
+
+class EventSchemaTestCase(unittest.TestCase):
+    """Test the schema encoding of event bodies"""
+
+    def createPropertySet(self, value):
+        ps = PropertySet()
+        ps.set("myname", "myname")
+        ps.setInt("value", value)
+        ps.set("values", [0.1, 0.2, 0.3, 0.4])
+        ps.set("logger.status", "my logger special status")
+        ps.setInt("logger.pid.xyzzy", 1)
+        return ps
+
+    def testSchemaId(self):
+        ps = self.createPropertySet(1)
+        other = PropertySet()
+        other.setInt("logger.pid.xyzzy", 2)
+        other.set("values", 0.5)
+        other.set("logger.status", "other")
+        other.setInt("value", 3)
+        other.set("myname", "other")
+
+        schema = events.EventSchema.create(ps)
+        self.assertEqual(schema.size(), 5)
+        self.assertEqual(events.EventSchema.create(other).getId(), schema.getId())
+
+        other.setLongLong("value", 3)
+        self.assertNotEqual(events.EventSchema.create(other).getId(), schema.getId())
+
+    def testRoundTrip(self):
+        writer = events.SchemaWriter(2)
+        self.assertEqual(writer.getDefinitionInterval(), 2)
+        self.assertRaises(ex.Exception, writer.setDefinitionInterval, 0)
+
+        ps = self.createPropertySet(1)
+        withDefinition = writer.write(ps)
+        withoutDefinition = writer.write(self.createPropertySet(2))
+        self.assertLess(len(withoutDefinition), len(withDefinition))
+        self.assertLess(len(withoutDefinition), len(events.BinaryWriter.write(ps)))
+
+        registry = events.SchemaRegistry.getDefaultSchemaRegistry()
+        self.assertIsNotNone(registry.getSchema(events.EventSchema.create(ps).getId()))
+
+        for data, value in [(withDefinition, 1), (withoutDefinition, 2)]:
+            result = events.SchemaReader.read(data)
+            self.assertEqual(result.getInt("value"), value)
+            for name in ps.paramNames(False):
+                if name != "value":
+                    self.assertEqual(result.getArray(name), ps.getArray(name))
+
+    def testUnknownSchema(self):
+        writer = events.SchemaWriter()
+        ps = PropertySet()
+        ps.set("unregistered", "value")
+        writer.write(ps)
+        data = writer.write(ps)
+        bad = data[0] + chr(ord(data[1]) ^ 1) + data[2:]
+        self.assertRaises(ex.Exception, events.SchemaReader.read, bad)
+        self.assertRaises(ex.Exception, events.SchemaReader.read, data[:-1])
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testTransmitReceive(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = "test_events_schema_%s_%d" % (platform.node(), os.getpid())
+
+        recv = events.EventReceiver(broker, topic)
+        trans = events.EventTransmitter(broker, topic)
+        trans.setEncoding(events.EventEncodings.SCHEMA)
+        self.assertEqual(trans.getSchemaDefinitionInterval(), events.SchemaWriter.DEFAULT_DEFINITION_INTERVAL)
+
+        ps = self.createPropertySet(1)
+        loc = events.LocationId()
+        trans.publishEvent(events.Event("schemarunid", ps))
+        trans.publishEvent(events.StatusEvent("schemarunid", loc, ps))
+        logps = self.createPropertySet(1)
+        logps.setInt(events.LogEvent.LEVEL, 10000)
+        logps.set(events.LogEvent.LOGGER, "schemalogger")
+        trans.publishEvent(events.LogEvent(loc, logps))
+
+        for eventType in [events.EventTypes.EVENT, events.EventTypes.STATUS, events.EventTypes.LOG]:
+            val = recv.receiveEvent()
+            self.assertIsNotNone(val)
+            self.assertEqual(val.getType(), eventType)
+            custom = val.getCustomPropertySet()
+            for name in ps.paramNames(False):
+                self.assertEqual(custom.getArray(name), ps.getArray(name))
+
+def suite():
+    """Returns a suite containing all the tests cases in this module."""
+    tests.init()
+    suites = []
+    suites += unittest.makeSuite(EventSchemaTestCase)
+    suites += unittest.makeSuite(tests.MemoryTestCase)
+    return unittest.TestSuite(suites)
+
+def run(shouldExit=False):
+    """Run the tests."""
+    tests.run(suite(), shouldExit)
+
+if __name__ == "__main__":
+    run(True)
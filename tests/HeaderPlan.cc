@@ -0,0 +1,272 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file HeaderPlan.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Test that the header properties of each event type are written
+ *        once each, with the types of their values, by HeaderPlans which
+ *        are shared by events of the same shape, and that compact plans
+ *        pack the locations of the event types only, and only those which
+ *        fit in an ID and whose hosts have codes of their own.
+ */
+
+#include <map>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE HeaderPlan
+#include "boost/test/unit_test.hpp"
+
+#include "boost/scoped_ptr.hpp"
+
+#include "activemq/commands/ActiveMQTextMessage.h"
+
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/pex/exceptions.h"
+#include "lsst/ctrl/events.h"
+#include "lsst/ctrl/events/HeaderPlan.h"
+#include "lsst/ctrl/events/HostTable.h"
+
+using lsst::daf::base::PropertySet;
+namespace ctrlEvents = lsst::ctrl::events;
+
+namespace {
+
+/* a message which records the type of each header property set, and how
+ * many times it was set */
+class RecordingMessage : public activemq::commands::ActiveMQTextMessage {
+public:
+    virtual void setBooleanProperty(std::string const& name, bool) { record(name, 'b'); }
+    virtual void setShortProperty(std::string const& name, short) { record(name, 's'); }
+    virtual void setIntProperty(std::string const& name, int) { record(name, 'i'); }
+    virtual void setLongProperty(std::string const& name, long long) { record(name, 'l'); }
+    virtual void setDoubleProperty(std::string const& name, double) { record(name, 'd'); }
+    virtual void setFloatProperty(std::string const& name, float) { record(name, 'f'); }
+    virtual void setStringProperty(std::string const& name, std::string const&) { record(name, 'S'); }
+
+    void record(std::string const& name, char type) {
+        counts[name]++;
+        types[name] = type;
+    }
+
+    std::map<std::string, int> counts;
+    std::map<std::string, char> types;
+};
+
+void checkWrittenOnce(ctrlEvents::Event& event) {
+    RecordingMessage msg;
+    event.populateHeader(&msg);
+
+    std::vector<std::string> names = event.getFilterablePropertyNames();
+    BOOST_CHECK_EQUAL(msg.counts.size(), names.size());
+    for (std::string const& name : names) {
+        BOOST_CHECK_EQUAL(msg.counts[name], 1);
+    }
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(writtenOnce) {
+    ctrlEvents::LocationId originator;
+    ctrlEvents::LocationId destination;
+    PropertySet ps;
+    ps.set("myname", std::string("myname"));
+    ps.set(ctrlEvents::LogEvent::LEVEL, 10000);
+    ps.set(ctrlEvents::LogEvent::LOGGER, std::string("ctrl.events.test"));
+    PropertySet filterable;
+    filterable.set("FOO", 3);
+
+    ctrlEvents::Event event("myrun", ps, filterable);
+    ctrlEvents::StatusEvent statusEvent("myrun", originator, ps, filterable);
+    ctrlEvents::CommandEvent commandEvent("myrun", originator, destination, ps, filterable);
+    ctrlEvents::LogEvent logEvent(originator, ps);
+    std::vector<ctrlEvents::Event*> events = {&event, &statusEvent, &commandEvent, &logEvent};
+    for (ctrlEvents::Event* ev : events) {
+        ev->setTopic("test");
+        checkWrittenOnce(*ev);
+    }
+
+    RecordingMessage msg;
+    logEvent.populateHeader(&msg);
+    BOOST_CHECK_EQUAL(msg.types[ctrlEvents::LogEvent::LEVEL], 'i');
+    BOOST_CHECK_EQUAL(msg.types[ctrlEvents::LogEvent::LOGGER], 'S');
+    BOOST_CHECK_EQUAL(msg.types[ctrlEvents::StatusEvent::ORIG_HOSTNAME], 'S');
+    BOOST_CHECK_EQUAL(msg.types[ctrlEvents::Event::EVENTTIME], 'l');
+}
+
+BOOST_AUTO_TEST_CASE(shared) {
+    ctrlEvents::LocationId originator;
+    PropertySet ps;
+    PropertySet filterable;
+    filterable.set("SHARED", 3);
+
+    RecordingMessage msg;
+    ctrlEvents::StatusEvent first("myrun", originator, ps, filterable);
+    first.populateHeader(&msg);
+    size_t cached = ctrlEvents::HeaderPlan::getCacheSize();
+
+    // the same names and types use the same plan
+    filterable.set("SHARED", 4);
+    ctrlEvents::StatusEvent second("otherrun", originator, ps, filterable);
+    second.populateHeader(&msg);
+    BOOST_CHECK_EQUAL(ctrlEvents::HeaderPlan::getCacheSize(), cached);
+
+    // a value of another type needs a plan of its own
+    filterable.set("SHARED", std::string("four"));
+    second.reset(ps, filterable);
+    second.setRunId("otherrun");
+    RecordingMessage text;
+    second.populateHeader(&text);
+    BOOST_CHECK_EQUAL(ctrlEvents::HeaderPlan::getCacheSize(), cached + 1);
+    BOOST_CHECK_EQUAL(text.types["SHARED"], 'S');
+    BOOST_CHECK_EQUAL(text.counts[ctrlEvents::Event::RUNID], 1);
+}
+
+BOOST_AUTO_TEST_CASE(compact) {
+    ctrlEvents::LocationId originator;
+    ctrlEvents::LocationId destination;
+    PropertySet ps;
+
+    RecordingMessage msg;
+    ctrlEvents::CommandEvent commandEvent("myrun", originator, destination, ps);
+    commandEvent.populateHeader(&msg, true);
+    BOOST_CHECK_EQUAL(msg.counts[ctrlEvents::CommandEvent::ORIG_ID], 1);
+    BOOST_CHECK_EQUAL(msg.counts[ctrlEvents::CommandEvent::DEST_ID], 1);
+    BOOST_CHECK_EQUAL(msg.types[ctrlEvents::CommandEvent::DEST_ID], 'l');
+    BOOST_CHECK_EQUAL(msg.counts.count(ctrlEvents::CommandEvent::ORIG_HOSTNAME), 0u);
+    BOOST_CHECK_EQUAL(msg.counts.count(ctrlEvents::CommandEvent::DEST_LOCALID), 0u);
+    BOOST_CHECK_EQUAL(msg.counts.size(), 8u);
+
+    // the same event is written in full again when asked to
+    RecordingMessage full;
+    commandEvent.populateHeader(&full);
+    BOOST_CHECK_EQUAL(full.counts[ctrlEvents::CommandEvent::DEST_HOSTNAME], 1);
+    BOOST_CHECK_EQUAL(full.counts.count(ctrlEvents::CommandEvent::DEST_ID), 0u);
+
+    // properties of the same names which an Event is given are not packed
+    PropertySet filterable;
+    filterable.set(ctrlEvents::StatusEvent::ORIG_HOSTNAME, std::string("host"));
+    filterable.set(ctrlEvents::StatusEvent::ORIG_PROCESSID, 1);
+    filterable.set(ctrlEvents::StatusEvent::ORIG_LOCALID, 2);
+    ctrlEvents::Event event("myrun", ps, filterable);
+    RecordingMessage plain;
+    event.populateHeader(&plain, true);
+    BOOST_CHECK_EQUAL(plain.counts[ctrlEvents::StatusEvent::ORIG_HOSTNAME], 1);
+    BOOST_CHECK_EQUAL(plain.counts.count(ctrlEvents::StatusEvent::ORIG_ID), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(compactFallback) {
+    ctrlEvents::HostTable& hosts = ctrlEvents::HostTable::getDefaultHostTable();
+    PropertySet ps;
+
+    // a local id which does not fit in an ID is sent as properties
+    ctrlEvents::LocationId large("fallback.example", 1234, 1 << ctrlEvents::LocationId::LOCAL_BITS);
+    BOOST_CHECK_EQUAL(large.getId(), -1);
+    ctrlEvents::StatusEvent largeEvent("myrun", large, ps);
+    RecordingMessage msg;
+    largeEvent.populateHeader(&msg, true);
+    BOOST_CHECK_EQUAL(msg.counts.count(ctrlEvents::StatusEvent::ORIG_ID), 0u);
+    BOOST_CHECK_EQUAL(msg.counts[ctrlEvents::StatusEvent::ORIG_HOSTNAME], 1);
+    BOOST_CHECK_EQUAL(msg.counts[ctrlEvents::StatusEvent::ORIG_LOCALID], 1);
+
+    // these two names have the same code; once both are known, neither is
+    // packed, and the code is not looked up
+    std::string const first("host53866.example");
+    std::string const second("host1018390.example");
+    unsigned int code = ctrlEvents::HostTable::getCode(first);
+    BOOST_REQUIRE_EQUAL(ctrlEvents::HostTable::getCode(second), code);
+
+    ctrlEvents::StatusEvent firstEvent("myrun", ctrlEvents::LocationId(first, 1, 1), ps);
+    RecordingMessage packed;
+    firstEvent.populateHeader(&packed, true);
+    BOOST_CHECK_EQUAL(packed.counts[ctrlEvents::StatusEvent::ORIG_ID], 1);
+    BOOST_CHECK(!hosts.isConflicting(code));
+
+    size_t conflicts = hosts.getConflictCount();
+    ctrlEvents::StatusEvent secondEvent("myrun", ctrlEvents::LocationId(second, 1, 1), ps);
+    RecordingMessage conflicting;
+    secondEvent.populateHeader(&conflicting, true);
+    BOOST_CHECK_EQUAL(conflicting.counts.count(ctrlEvents::StatusEvent::ORIG_ID), 0u);
+    BOOST_CHECK_EQUAL(conflicting.counts[ctrlEvents::StatusEvent::ORIG_HOSTNAME], 1);
+    BOOST_CHECK(hosts.isConflicting(code));
+    BOOST_CHECK_EQUAL(hosts.getConflictCount(), conflicts + 1);
+
+    RecordingMessage again;
+    firstEvent.populateHeader(&again, true);
+    BOOST_CHECK_EQUAL(again.counts.count(ctrlEvents::StatusEvent::ORIG_ID), 0u);
+    std::string hostname;
+    BOOST_CHECK(!hosts.lookup(code, hostname));
+    BOOST_CHECK_EQUAL(hosts.getDefinition(code), "");
+
+    // an event which was sent packed before the conflict was found is
+    // received with its ID left packed, rather than given either name
+    activemq::commands::ActiveMQTextMessage received;
+    received.setText("{}");
+    received.setLongProperty(ctrlEvents::StatusEvent::ORIG_ID, ctrlEvents::LocationId::pack(code, 7, 3));
+    ctrlEvents::StatusEvent receivedEvent(&received);
+    CONST_PTR(PropertySet) properties = receivedEvent.getPropertySet();
+    BOOST_CHECK(!properties->exists(ctrlEvents::StatusEvent::ORIG_HOSTNAME));
+    BOOST_CHECK_EQUAL(properties->get<long long>(ctrlEvents::StatusEvent::ORIG_ID),
+                      ctrlEvents::LocationId::pack(code, 7, 3));
+    boost::scoped_ptr<ctrlEvents::LocationId> originator(receivedEvent.getOriginator());
+    BOOST_CHECK_EQUAL(originator->getHostName(), "");
+    BOOST_CHECK_EQUAL(originator->getProcessID(), 7);
+    BOOST_CHECK_EQUAL(originator->getLocalID(), 3);
+    BOOST_CHECK_EQUAL(originator->getId(), ctrlEvents::LocationId::pack(code, 7, 3));
+
+    // and is sent on with the same ID
+    RecordingMessage forwarded;
+    receivedEvent.populateHeader(&forwarded, true);
+    BOOST_CHECK_EQUAL(forwarded.counts[ctrlEvents::StatusEvent::ORIG_ID], 1);
+    BOOST_CHECK_EQUAL(forwarded.counts.count(ctrlEvents::StatusEvent::ORIG_HOSTNAME), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(unknownHost) {
+    // a packed location is never given an empty or wrong host name
+    activemq::commands::ActiveMQTextMessage msg;
+    msg.setText("{}");
+    unsigned int code = ctrlEvents::HostTable::getCode("unknown.example");
+    msg.setLongProperty(ctrlEvents::StatusEvent::ORIG_ID, ctrlEvents::LocationId::pack(code, 1, 2));
+    BOOST_CHECK_THROW(ctrlEvents::Event event(&msg), lsst::pex::exceptions::RuntimeError);
+
+    msg.setStringProperty(ctrlEvents::Event::HOSTS, std::to_string(code) + " unknown.example");
+    ctrlEvents::Event event(&msg);
+    BOOST_CHECK_EQUAL(event.getPropertySet()->get<std::string>(ctrlEvents::StatusEvent::ORIG_HOSTNAME),
+                      "unknown.example");
+    BOOST_CHECK_EQUAL(event.getPropertySet()->get<int>(ctrlEvents::StatusEvent::ORIG_LOCALID), 2);
+}
+
+BOOST_AUTO_TEST_CASE(badType) {
+    PropertySet ps;
+    PropertySet filterable;
+    filterable.set("BAD", 3u);
+
+    ctrlEvents::Event event("myrun", ps, filterable);
+    RecordingMessage msg;
+    BOOST_CHECK_THROW(event.populateHeader(&msg), lsst::pex::exceptions::RuntimeError);
+}
@@ -0,0 +1,130 @@
+#!/usr/bin/env python
+
+# 
+# LSST Data Management System
+#
+# Copyright 2008-2014  AURA/LSST.
+# 
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the LSST License Statement and 
+# the GNU General Public License along with this program.  If not, 
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+
+import unittest
+import lsst.ctrl.events as events
+from lsst.daf.base import PropertySet, DateTime
+import lsst.pex.exceptions as ex
+import lsst.utils.tests as tests
+
+class JSONReaderTestCase(unittest.TestCase):
+    """A test case for decoding the JSON text of Event bodies"""
+
+    def testRoundTrip(self):
+        ps = PropertySet()
+        ps.set("myname", "myname")
+        ps.setInt("value", 12)
+        ps.setDouble("ratio", 0.1)
+        ps.setBool("flag", False)
+        ps.setLongLong("big", -123456789012)
+        ps.set("values", [1.5, 2.5, 3.5])
+        ps.set("text", 'a "quoted" \\ value/\n\t')
+        ps.set("logger.status", "my logger special status")
+        ps.setInt("logger.pid.xyzzy", 1)
+        ps.setDouble("logger.pid.plover", 3.14)
+
+        result = events.JSONReader.read(events.JSONWriter.write(ps))
+
+        self.assertEqual(result.nameCount(), ps.nameCount())
+        for name in ps.paramNames(False):
+            self.assertEqual(result.typeOf(name), ps.typeOf(name))
+            self.assertEqual(result.getArray(name), ps.getArray(name))
+
+    def testPackedRoundTrip(self):
+        ps = PropertySet()
+        doubles = [(i * 0.1) ** 3 - 1.0e5 for i in range(10000)]
+        ps.set("doubles", doubles)
+        ps.set("ints", range(-5000, 5000))
+        ps.setLongLong("longs", 0)
+        for i in range(1, 100):
+            ps.addLongLong("longs", -(2 ** 62) + i)
+        ps.setFloat("floats", 0.25)
+        for i in range(1, 100):
+            ps.addFloat("floats", i / 3.0)
+        ps.set("nested.doubles", doubles[:20])
+
+        for pack in [False, True]:
+            text = events.JSONWriter.write(ps, pack)
+            self.assertEqual("packed" in text, pack)
+            result = events.JSONReader.read(text)
+
+            for name in ps.paramNames(False):
+                self.assertEqual(result.typeOf(name), ps.typeOf(name))
+                # values are compared exactly; packed values must be bit for bit identical
+                self.assertEqual(result.getArray(name), ps.getArray(name))
+
+        # packed, each double takes under eleven characters, rather than 20 or more as text
+        packed = PropertySet()
+        packed.set("doubles", doubles)
+        self.assertTrue(len(events.JSONWriter.write(packed, True)) < 11 * len(doubles))
+
+    def testMalformedPacked(self):
+        for text in ['{"a":{"packed double":"AAAA"}}',
+                     '{"a":{"packed int":"AA!A"}}',
+                     '{"a":{"packed int":"AAAAA"}}',
+                     '{"a":{"packed int":""}}',
+                     '{"a":{"packed short":"AAAAAA=="}}',
+                     '{"a":{"packed int":"AAAAAA==","int":"1"}}']:
+            self.assertRaises(ex.Exception, events.JSONReader.read, text)
+
+    def testDateTime(self):
+        ps = PropertySet()
+        ps.set("date", DateTime(1234567890123456789L, DateTime.UTC))
+
+        result = events.JSONReader.read(events.JSONWriter.write(ps))
+        self.assertTrue(result.exists("date"))
+
+    def testPropertyTreeText(self):
+        # text as written by boost::property_tree::write_json
+        text = '{"myname":{"string":"myname"},"logger":{"pid":{"xyzzy":{"int":"1","int":"2"}}}}'
+        result = events.JSONReader.read(text)
+        self.assertEqual(result.get("myname"), "myname")
+        self.assertEqual(result.getArray("logger.pid.xyzzy"), [1, 2])
+
+    def testWhitespace(self):
+        text = '{ "a" : { "int" : "3" } ,\n "b" : { "c" : { "double" : "2.5" } } }'
+        result = events.JSONReader.read(text)
+        self.assertEqual(result.get("a"), 3)
+        self.assertEqual(result.get("b.c"), 2.5)
+
+    def testMalformed(self):
+        for text in ['', '{', '{"a":{"int":"x"}}', '{"a":{"int":"1"}} x', '{"a"}']:
+            self.assertRaises(ex.Exception, events.JSONReader.read, text)
+
+def suite():
+    """Returns a suite containing all the tests cases in this module."""
+    tests.init()
+    suites = []
+    suites += unittest.makeSuite(JSONReaderTestCase)
+    suites += unittest.makeSuite(tests.MemoryTestCase)
+    return unittest.TestSuite(suites)
+
+def run(shouldExit=False):
+    """Run the tests."""
+    tests.run(suite(), shouldExit)
+
+if __name__ == "__main__":
+    run(True)
@@ -0,0 +1,307 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+
+/**
+ * @file JSONScanner.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Test that JSONReader decodes event bodies as the boost::property_tree
+ *        unmarshaller of earlier releases did, with every JSONScanner
+ *        implementation the CPU supports.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JSONScanner
+#include "boost/test/unit_test.hpp"
+
+#include "boost/property_tree/ptree.hpp"
+#include "boost/property_tree/json_parser.hpp"
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/ctrl/events/Event.h"
+#include "lsst/ctrl/events/JSONReader.h"
+#include "lsst/ctrl/events/JSONScanner.h"
+#include "lsst/ctrl/events/JSONWriter.h"
+
+using lsst::daf::base::DateTime;
+using lsst::daf::base::PropertySet;
+namespace ctrlEvents = lsst::ctrl::events;
+namespace pt = boost::property_tree;
+
+namespace {
+
+// the boost::property_tree unmarshaller of Event, from before JSONReader
+
+bool addDataItem(std::string const& typeInfo, pt::ptree& item, std::string const& key, PropertySet& ps) {
+    if (typeInfo == "string") {
+        ps.add(key, item.get_value<std::string>());
+    } else if (typeInfo == "bool") {
+        ps.add(key, item.get_value<bool>());
+    } else if (typeInfo == "long") {
+        ps.add(key, item.get_value<long>());
+    } else if (typeInfo == "long long") {
+        ps.add(key, item.get_value<long long>());
+    } else if (typeInfo == "int") {
+        ps.add(key, item.get_value<int>());
+    } else if (typeInfo == "float") {
+        ps.add(key, item.get_value<float>());
+    } else if (typeInfo == "double") {
+        ps.add(key, item.get_value<double>());
+    } else if (typeInfo == "datetime") {
+        ps.add(key, DateTime(item.get_value<long long>(), DateTime::UTC));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+PTR(PropertySet) parsePropertySet(pt::ptree child) {
+    PTR(PropertySet) psp(new PropertySet);
+    for (pt::ptree::value_type const& v : child.get_child("")) {
+        std::string label = v.first;
+        for (pt::ptree::value_type& v2 : child.get_child(label)) {
+            if (!addDataItem(v2.first, v2.second, label, *psp)) {
+                psp->add(label, parsePropertySet(child.get_child(label)));
+                break;
+            }
+        }
+    }
+    return psp;
+}
+
+PTR(PropertySet) baselineRead(std::string const& text) {
+    pt::ptree tree;
+    std::istringstream is(text);
+    pt::read_json(is, tree);
+
+    PTR(PropertySet) psp(new PropertySet);
+    for (pt::ptree::value_type& v : tree) {
+        pt::ptree child = v.second;
+        for (pt::ptree::value_type& v2 : child) {
+            if (!addDataItem(v2.first, v2.second, v.first, *psp)) {
+                psp->add(v.first, parsePropertySet(child));
+                break;
+            }
+        }
+    }
+    return psp;
+}
+
+std::vector<std::string> implementations() {
+    std::string current = ctrlEvents::JSONScanner::getImplementation();
+    std::vector<std::string> names;
+    for (char const* name : {"scalar", "sse2", "avx2"}) {
+        try {
+            ctrlEvents::JSONScanner::setImplementation(name);
+            names.push_back(name);
+        } catch (lsst::pex::exceptions::RuntimeError&) {
+        }
+    }
+    ctrlEvents::JSONScanner::setImplementation(current);
+    return names;
+}
+
+template<typename T>
+bool sameValues(PropertySet const& result, PropertySet const& expected, std::string const& name) {
+    if (result.typeOf(name) != typeid(T))
+        return false;
+    std::vector<T> a = result.getArray<T>(name);
+    std::vector<T> b = expected.getArray<T>(name);
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        // compare the bits, so that -0 and 0 differ
+        T x = a[i];
+        T y = b[i];
+        if (memcmp(&x, &y, sizeof(T)) != 0)
+            return false;
+    }
+    return true;
+}
+
+template<>
+bool sameValues<std::string>(PropertySet const& result, PropertySet const& expected, std::string const& name) {
+    return (result.typeOf(name) == typeid(std::string)) &&
+        (result.getArray<std::string>(name) == expected.getArray<std::string>(name));
+}
+
+template<>
+bool sameValues<DateTime>(PropertySet const& result, PropertySet const& expected, std::string const& name) {
+    if (result.typeOf(name) != typeid(DateTime))
+        return false;
+    std::vector<DateTime> a = result.getArray<DateTime>(name);
+    std::vector<DateTime> b = expected.getArray<DateTime>(name);
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].nsecs() != b[i].nsecs())
+            return false;
+    }
+    return true;
+}
+
+bool sameValue(PropertySet const& result, PropertySet const& expected, std::string const& name) {
+    std::type_info const& type = expected.typeOf(name);
+    if (type == typeid(bool))
+        return sameValues<bool>(result, expected, name);
+    if (type == typeid(int))
+        return sameValues<int>(result, expected, name);
+    if (type == typeid(long))
+        return sameValues<long>(result, expected, name);
+    if (type == typeid(long long))
+        return sameValues<long long>(result, expected, name);
+    if (type == typeid(float))
+        return sameValues<float>(result, expected, name);
+    if (type == typeid(double))
+        return sameValues<double>(result, expected, name);
+    if (type == typeid(std::string))
+        return sameValues<std::string>(result, expected, name);
+    if (type == typeid(DateTime))
+        return sameValues<DateTime>(result, expected, name);
+    return false;
+}
+
+// decode text with every implementation, and check each result against
+// the baseline unmarshaller
+void checkConformant(std::string const& text) {
+    PTR(PropertySet) expected = baselineRead(text);
+    std::vector<std::string> names = expected->paramNames(false);
+    std::string current = ctrlEvents::JSONScanner::getImplementation();
+
+    for (std::string const& implementation : implementations()) {
+        ctrlEvents::JSONScanner::setImplementation(implementation);
+        PTR(PropertySet) result = ctrlEvents::JSONReader::read(text);
+        BOOST_CHECK_MESSAGE(result->paramNames(false).size() == names.size(), implementation);
+        for (std::string const& name : names) {
+            BOOST_CHECK_MESSAGE(result->exists(name) && sameValue(*result, *expected, name),
+                                implementation + " " + name + " in " + text.substr(0, 200));
+        }
+    }
+    ctrlEvents::JSONScanner::setImplementation(current);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(implementationsAvailable) {
+    std::vector<std::string> names = implementations();
+    BOOST_CHECK(std::find(names.begin(), names.end(), "scalar") != names.end());
+    BOOST_CHECK(std::find(names.begin(), names.end(), ctrlEvents::JSONScanner::getImplementation()) != names.end());
+    BOOST_CHECK_THROW(ctrlEvents::JSONScanner::setImplementation("unknown"), lsst::pex::exceptions::RuntimeError);
+}
+
+BOOST_AUTO_TEST_CASE(complexData) {
+    // payload shape from ComplexData.py
+    PropertySet ps;
+    ps.set(ctrlEvents::Event::TOPIC, std::string("test_events_12"));
+    ps.set("myname", std::string("myname"));
+    ps.set(ctrlEvents::Event::STATUS, std::string("my special status"));
+    ps.set("value", 12);
+    ps.set("logger.status", std::string("my logger special status"));
+    ps.set("logger.name", std::string("myname"));
+    ps.set("logger.pid.xyzzy", 1);
+    ps.set("logger.pid.plover", 3.14);
+    ps.set("logger.pid.plugh", std::string("a hollow voice says"));
+    checkConformant(ctrlEvents::JSONWriter::write(ps));
+}
+
+BOOST_AUTO_TEST_CASE(filterData) {
+    // payload shape from EventFilters.py
+    PropertySet ps;
+    ps.set("date", std::string("2007-07-01T14:28:32.546012"));
+    ps.set("blank", std::string(""));
+    ps.set("pid", 12345);
+    ps.set("host", std::string("lsstcorp.org"));
+    ps.set("ip", std::string("1.2.3.4"));
+    ps.set("evnt", std::string("test"));
+    ps.set("misc1", std::string("data 1"));
+    ps.set("misc3", std::string(""));
+    ps.set("data", 3.14);
+    ps.set("FOO", std::string("bar"));
+    ps.set("XYZZY", 123);
+    ps.set("PLOUGH", 0.867);
+    ps.set("flag", true);
+    ps.set("big", 1234567890123LL);
+    ps.set("ratio", 0.25f);
+    ps.set("when", DateTime(1234567890123456789LL, DateTime::UTC));
+    ps.set("list", std::vector<int>({1, -2, 3}));
+    checkConformant(ctrlEvents::JSONWriter::write(ps));
+}
+
+BOOST_AUTO_TEST_CASE(escapes) {
+    // quotes and backslashes on either side of every 16 and 32 byte boundary
+    PropertySet ps;
+    for (int offset = 0; offset < 70; offset++) {
+        std::ostringstream name;
+        name << "escape" << offset;
+        ps.set(name.str(), std::string(offset, 'x') + "\"\\/\n\t" + std::string(70 - offset, 'y'));
+    }
+    ps.set("long", std::string(1000, 'z'));
+    checkConformant(ctrlEvents::JSONWriter::write(ps));
+}
+
+BOOST_AUTO_TEST_CASE(numbers) {
+    // the fast paths must give the same bits as the baseline conversions
+    for (char const* value : {"0", "-0", "0.5", "3.14", "-2.5e-3", "1e22", "1e23", "1e-22", "0.1",
+                              "9007199254740992", "9007199254740993", "3.1400000000000001",
+                              "1.7976931348623157e+308", "123456.789", "2.2250738585072014e-308"}) {
+        checkConformant(std::string("{\"d\":{\"double\":\"") + value + "\"}}");
+    }
+    for (char const* value : {"0", "-1", "2147483647", "-2147483648", "123456789012345678",
+                              "-9223372036854775808", "9223372036854775807"}) {
+        checkConformant(std::string("{\"l\":{\"long long\":\"") + value + "\"}}");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(switchWhileDecoding) {
+    // threads which are decoding see setImplementation take effect safely
+    PropertySet ps;
+    ps.set("value", std::string(100, 'v') + "\\\"" + std::string(100, 'w'));
+    std::string text = ctrlEvents::JSONWriter::write(ps);
+    std::vector<std::string> names = implementations();
+    std::string current = ctrlEvents::JSONScanner::getImplementation();
+
+    bool decoded = true;
+    std::thread reader([&text, &ps, &decoded]() {
+        for (int i = 0; i < 20000; i++) {
+            if (ctrlEvents::JSONReader::read(text)->get<std::string>("value") != ps.get<std::string>("value"))
+                decoded = false;
+        }
+    });
+    for (int i = 0; i < 20000; i++) {
+        ctrlEvents::JSONScanner::setImplementation(names[i % names.size()]);
+    }
+    reader.join();
+    ctrlEvents::JSONScanner::setImplementation(current);
+    BOOST_CHECK(decoded);
+}
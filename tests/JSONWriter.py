@@ -0,0 +1,123 @@
+#!/usr/bin/env python
+
+# 
+# LSST Data Management System
+#
+# Copyright 2008-2014  AURA/LSST.
+# 
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the LSST License Statement and 
+# the GNU General Public License along with this program.  If not, 
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+
+import base64
+import json
+import struct
+import unittest
+import lsst.ctrl.events as events
+from lsst.daf.base import PropertySet
+import lsst.utils.tests as tests
+
+class JSONWriterTestCase(unittest.TestCase):
+    """A test case for the JSON text written for Event bodies"""
+
+    def parse(self, ps, pack=False):
+        text = events.JSONWriter.write(ps, pack)
+        # keep duplicate keys; each value of an array is written with the same type tag
+        return json.loads(text, object_pairs_hook=lambda pairs: pairs)
+
+    def testScalars(self):
+        ps = PropertySet()
+        ps.set("myname", "myname")
+        ps.setInt("value", 12)
+        ps.setDouble("ratio", 0.25)
+        ps.setBool("flag", True)
+        ps.setLongLong("big", 123456789012)
+
+        obj = dict(self.parse(ps))
+        self.assertEqual(obj["myname"], [("string", "myname")])
+        self.assertEqual(obj["value"], [("int", "12")])
+        self.assertEqual(obj["ratio"], [("double", "0.25")])
+        self.assertEqual(obj["flag"], [("bool", "true")])
+        self.assertEqual(obj["big"], [("long long", "123456789012")])
+
+    def testArray(self):
+        ps = PropertySet()
+        ps.set("values", [1, 2, 3])
+
+        obj = dict(self.parse(ps))
+        self.assertEqual(obj["values"], [("int", "1"), ("int", "2"), ("int", "3")])
+
+    def testPackedArray(self):
+        threshold = events.JSONWriter.PACK_THRESHOLD
+
+        ps = PropertySet()
+        ps.set("short", [0.5] * (threshold - 1))
+        ps.set("long", [0.5 * i for i in range(threshold)])
+        ps.set("ints", range(-threshold, threshold))
+        ps.set("names", ["a"] * threshold)
+
+        # arrays are only packed when asked for, since older receivers can not read them
+        obj = dict(self.parse(ps))
+        self.assertEqual([float(value) for tag, value in obj["long"]], [0.5 * i for i in range(threshold)])
+        self.assertEqual(len(obj["ints"]), 2 * threshold)
+
+        obj = dict(self.parse(ps, True))
+        self.assertEqual(obj["short"], [("double", "0.5")] * (threshold - 1))
+        self.assertEqual(len(obj["long"]), 1)
+        tag, value = obj["long"][0]
+        self.assertEqual(tag, "packed double")
+        self.assertEqual(list(struct.unpack("<%dd" % threshold, base64.b64decode(value))),
+                         [0.5 * i for i in range(threshold)])
+        tag, value = obj["ints"][0]
+        self.assertEqual(tag, "packed int")
+        self.assertEqual(list(struct.unpack("<%di" % (2 * threshold), base64.b64decode(value))),
+                         range(-threshold, threshold))
+        self.assertEqual(obj["names"], [("string", "a")] * threshold)
+
+    def testNested(self):
+        ps = PropertySet()
+        ps.set("logger.status", "my logger special status")
+        ps.setInt("logger.pid.xyzzy", 1)
+
+        obj = dict(self.parse(ps))
+        logger = dict(obj["logger"])
+        self.assertEqual(logger["status"], [("string", "my logger special status")])
+        self.assertEqual(dict(logger["pid"])["xyzzy"], [("int", "1")])
+
+    def testEscapes(self):
+        ps = PropertySet()
+        value = 'a "quoted" \\ value/\n\t'
+        ps.set("text", value)
+
+        obj = dict(self.parse(ps))
+        self.assertEqual(obj["text"], [("string", value)])
+
+def suite():
+    """Returns a suite containing all the tests cases in this module."""
+    tests.init()
+    suites = []
+    suites += unittest.makeSuite(JSONWriterTestCase)
+    suites += unittest.makeSuite(tests.MemoryTestCase)
+    return unittest.TestSuite(suites)
+
+def run(shouldExit=False):
+    """Run the tests."""
+    tests.run(suite(), shouldExit)
+
+if __name__ == "__main__":
+    run(True)
@@ -0,0 +1,141 @@
+#!/usr/bin/env python
+
+# 
+# LSST Data Management System
+#
+# Copyright 2008-2014  AURA/LSST.
+# 
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the LSST License Statement and 
+# the GNU General Public License along with this program.  If not, 
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+
+import os
+import platform
+import unittest
+import lsst.ctrl.events as events
+from lsst.daf.base import PropertySet
+import lsst.utils.tests as tests
+from testEnvironment import TestEnvironment
+
+class NameCompressionTestCase(unittest.TestCase):
+    """Test the compression of property names in JSON bodies"""
+
+    def createTopicName(self, template):
+        return template % ("%s_%d" % (platform.node(), os.getpid()))
+
+    def createEvent(self, locationID, counter):
+        ps = PropertySet()
+        ps.setInt("counter", counter)
+        ps.set("#comment", "names which start with a code marker")
+        ps.set("logger.filename", "NameCompression.py")
+        ps.setInt("logger.linenumber", 100 + counter)
+        return events.StatusEvent("namesrunid", locationID, ps)
+
+    def assertComplete(self, val, counter):
+        self.assertIsNotNone(val)
+        self.assertNotIn(events.Event.DICTIONARY, val.getFilterablePropertyNames())
+        self.assertNotIn(events.Event.NAMES, val.getFilterablePropertyNames())
+        self.assertEqual(val.getRunId(), "namesrunid")
+
+        ps = val.getCustomPropertySet()
+        self.assertEqual(set(ps.names()), set(["counter", "#comment", "logger"]))
+        self.assertEqual(ps.getInt("counter"), counter)
+        self.assertEqual(ps.get("#comment"), "names which start with a code marker")
+        self.assertEqual(ps.get("logger.filename"), "NameCompression.py")
+        self.assertEqual(ps.getInt("logger.linenumber"), 100 + counter)
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testTransmitReceive(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = self.createTopicName("test_events_names_%s.A")
+
+        recv = events.EventReceiver(broker, topic)
+        trans = events.EventTransmitter(broker, topic)
+        self.assertFalse(trans.getNameCompression())
+        trans.setNameCompression(True)
+        trans.setNameDefinitionInterval(4)
+        self.assertEqual(trans.getNameDefinitionInterval(), 4)
+
+        locationID = events.EventSystem.getDefaultEventSystem().createOriginatorId()
+        for i in range(10):
+            trans.publishEvent(self.createEvent(locationID, i))
+        for i in range(10):
+            self.assertComplete(recv.receiveStatusEvent(), i)
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testLateSubscriber(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = self.createTopicName("test_events_names_%s.B")
+
+        trans = events.EventTransmitter(broker, topic)
+        trans.setNameCompression(True)
+        trans.setNameDefinitionInterval(4)
+
+        locationID = events.EventSystem.getDefaultEventSystem().createOriginatorId()
+        trans.publishEvent(self.createEvent(locationID, 0))
+        trans.publishEvent(self.createEvent(locationID, 1))
+
+        # the events which follow use codes defined in the ones missed,
+        # so the first event received is the one carrying all of the codes
+        recv = events.EventReceiver(broker, topic)
+        for i in range(2, 6):
+            trans.publishEvent(self.createEvent(locationID, i))
+
+        self.assertComplete(recv.receiveStatusEvent(5000), 4)
+        self.assertComplete(recv.receiveStatusEvent(5000), 5)
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testSelector(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+        topic = self.createTopicName("test_events_names_%s.C")
+
+        # the selector filters out the second event, which defines the codes
+        # of the names sent twice, so the events which use them are discarded
+        # until the next one carrying the whole dictionary
+        recv = events.EventReceiver(broker, topic, "RUNID = 'namesrunid'")
+        trans = events.EventTransmitter(broker, topic)
+        trans.setNameCompression(True)
+        trans.setNameDefinitionInterval(3)
+
+        locationID = events.EventSystem.getDefaultEventSystem().createOriginatorId()
+        for i in range(8):
+            event = self.createEvent(locationID, i)
+            if i % 2 == 1:
+                event.setRunId("otherrunid")
+            trans.publishEvent(event)
+        for i in [0, 6]:
+            self.assertComplete(recv.receiveStatusEvent(5000), i)
+        self.assertIsNone(recv.receiveStatusEvent(1000))
+
+def suite():
+    """Returns a suite containing all the tests cases in this module."""
+    tests.init()
+    suites = []
+    suites += unittest.makeSuite(NameCompressionTestCase)
+    suites += unittest.makeSuite(tests.MemoryTestCase)
+    return unittest.TestSuite(suites)
+
+def run(shouldExit=False):
+    """Run the tests."""
+    tests.run(suite(), shouldExit)
+
+if __name__ == "__main__":
+    run(True)
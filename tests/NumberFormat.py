@@ -0,0 +1,132 @@
+#!/usr/bin/env python
+
+# 
+# LSST Data Management System
+#
+# Copyright 2008-2014  AURA/LSST.
+# 
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the LSST License Statement and 
+# the GNU General Public License along with this program.  If not, 
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import json
+import math
+import random
+import struct
+import unittest
+import lsst.ctrl.events as events
+from lsst.daf.base import PropertySet
+import lsst.utils.tests as tests
+
+class NumberFormatTestCase(unittest.TestCase):
+    """Test that numbers in JSON event bodies read back bit for bit"""
+
+    def setUp(self):
+        self.random = random.Random(20161017)
+
+    def randomDouble(self):
+        return struct.unpack("<d", struct.pack("<Q", self.random.getrandbits(64)))[0]
+
+    def randomFloat(self):
+        return struct.unpack("<f", struct.pack("<I", self.random.getrandbits(32)))[0]
+
+    def assertSameDouble(self, result, value):
+        if math.isnan(value):
+            self.assertTrue(math.isnan(result))
+        else:
+            self.assertEqual(struct.pack("<d", result), struct.pack("<d", value))
+
+    def assertSameFloat(self, result, value):
+        if math.isnan(value):
+            self.assertTrue(math.isnan(result))
+        else:
+            self.assertEqual(struct.pack("<f", result), struct.pack("<f", value))
+
+    def roundTrip(self, values, setter):
+        # fewer values than JSONWriter packs into a single block, so each is written as text
+        ps = PropertySet()
+        for i, value in enumerate(values):
+            getattr(ps, setter)("v%d" % i, value)
+        return events.JSONReader.read(events.JSONWriter.write(ps))
+
+    def testSpecialDoubles(self):
+        values = [0.0, -0.0, 0.1, 0.1 + 0.2, 1.0 / 3, 5e-324, 2.2250738585072014e-308,
+                  1.7976931348623157e308, 1e22, 1e23, 2.0 ** 53 + 2, float("inf"), float("-inf"),
+                  float("nan")]
+        result = self.roundTrip(values, "setDouble")
+        for i, value in enumerate(values):
+            self.assertSameDouble(result.getDouble("v%d" % i), value)
+
+    def testRandomDoubles(self):
+        for n in range(200):
+            values = [self.randomDouble() for i in range(10)]
+            result = self.roundTrip(values, "setDouble")
+            for i, value in enumerate(values):
+                self.assertSameDouble(result.getDouble("v%d" % i), value)
+
+    def testRandomFloats(self):
+        for n in range(200):
+            values = [self.randomFloat() for i in range(10)]
+            result = self.roundTrip(values, "setFloat")
+            for i, value in enumerate(values):
+                self.assertSameFloat(result.getFloat("v%d" % i), value)
+
+    def testIntegers(self):
+        values = [0, -1, 2 ** 63 - 1, -2 ** 63] + [self.random.getrandbits(64) - 2 ** 63 for i in range(10)]
+        result = self.roundTrip(values, "setLongLong")
+        for i, value in enumerate(values):
+            self.assertEqual(result.getLongLong("v%d" % i), value)
+
+        values = [0, 2 ** 31 - 1, -2 ** 31, 12345]
+        result = self.roundTrip(values, "setInt")
+        for i, value in enumerate(values):
+            self.assertEqual(result.getInt("v%d" % i), value)
+
+    def testShortest(self):
+        values = [0.1, 1.5, -250.125, 1.0 / 3, 0.1 + 0.2, 6.02214076e23]
+        ps = PropertySet()
+        for i, value in enumerate(values):
+            ps.setDouble("v%d" % i, value)
+        written = json.loads(events.JSONWriter.write(ps))
+        for i, value in enumerate(values):
+            text = written["v%d" % i]["double"]
+            self.assertEqual(float(text), value)
+            if events.NumberFormat.getImplementation() == "charconv":
+                # repr gives the shortest text which reads back exactly
+                self.assertTrue(len(text) <= len(repr(value)))
+            else:
+                self.assertTrue(len(text) <= 24)
+
+        # short decimals are written as they would be typed, in either implementation
+        self.assertEqual(written["v0"]["double"], "0.1")
+        self.assertEqual(written["v1"]["double"], "1.5")
+        self.assertEqual(written["v2"]["double"], "-250.125")
+
+def suite():
+    """Returns a suite containing all the tests cases in this module."""
+    tests.init()
+    suites = []
+    suites += unittest.makeSuite(NumberFormatTestCase)
+    suites += unittest.makeSuite(tests.MemoryTestCase)
+    return unittest.TestSuite(suites)
+
+def run(shouldExit=False):
+    """Run the tests."""
+    tests.run(suite(), shouldExit)
+
+if __name__ == "__main__":
+    run(True)
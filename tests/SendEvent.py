@@ -125,6 +125,37 @@ class SendEventTestCase(unittest.TestCase):
         val = recv.receiveEvent(1000)
         self.assertIsNone(val)
 
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testChangedPropertySet(self):
+        """Change the PropertySet of an Event between publishes"""
+        testEnv = TestEnvironment()
+        self.thisHost = platform.node()
+        self.broker = testEnv.getBroker()
+
+        topic = "test_events_3a_%s_%d" % (self.thisHost, os.getpid())
+
+        recv = events.EventReceiver(self.broker, topic)
+        trans = events.EventTransmitter(self.broker, topic)
+
+        root = PropertySet()
+        root.set("misc1", "data 1")
+        event = events.Event("test3_runid", root)
+        trans.publishEvent(event)
+
+        # the sets handed out are copies, so changing them is not published
+        props = event.getPropertySet()
+        props.set("misc1", "changed")
+        props.set("misc2", "added")
+        event.getCustomPropertySet().set("misc1", "changed")
+        trans.publishEvent(event)
+
+        for i in range(2):
+            val = recv.receiveEvent()
+            self.assertIsNotNone(val)
+            ps = val.getPropertySet()
+            self.assertEqual(ps.get("misc1"), "data 1")
+            self.assertFalse(ps.exists("misc2"))
+
 def suite():
     """Returns a suite containing all the tests cases in this module."""
     tests.init()
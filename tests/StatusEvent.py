@@ -176,6 +176,63 @@ class StatusEventTestCase(unittest.TestCase):
         self.assertValid(val, values, customValues)
 
 
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testHeadersBeforeBody(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+
+        topic = self.createTopicName("test_events_10_%s.E")
+
+        receiver = self.createReceiver(broker, topic)
+
+        self.sendPlainStatusEvent(broker, topic, "test_runID_10")
+
+        val = receiver.receiveStatusEvent()
+        self.assertIsNotNone(val)
+
+        # the body is decoded on first use, after the header has been changed
+        self.assertEqual(val.getRunId(), "test_runID_10")
+        self.assertEqual(val.getStatus(), "my special status")
+        val.setStatus("routed")
+
+        ps = val.getPropertySet()
+        self.assertEqual(ps.get(events.Event.STATUS), "routed")
+        self.assertEqual(ps.get("myname"), "myname")
+
+    @unittest.skipUnless(TestEnvironment().validTestDomain(), "not within valid domain")
+    def testRepublish(self):
+        testEnv = TestEnvironment()
+        broker = testEnv.getBroker()
+
+        topicA = self.createTopicName("test_events_10_%s.F")
+        topicB = self.createTopicName("test_events_10_%s.G")
+        receiverA = self.createReceiver(broker, topicA)
+        receiverB = self.createReceiver(broker, topicB)
+
+        root = PropertySet()
+        root.set("myname", "myname")
+        root.set("values", range(100))
+
+        eventSystem = events.EventSystem.getDefaultEventSystem();
+        locationID = eventSystem.createOriginatorId()
+        event = events.StatusEvent("test_runID_10", locationID, root)
+
+        # the same event to two destinations, and again after it is changed
+        events.EventTransmitter(broker, topicA).publishEvent(event)
+        events.EventTransmitter(broker, topicB).publishEvent(event)
+        event.setStatus("changed")
+        events.EventTransmitter(broker, topicA).publishEvent(event)
+
+        for receiver, status in [(receiverA, "unknown"), (receiverB, "unknown"), (receiverA, "changed")]:
+            val = receiver.receiveStatusEvent()
+            self.assertIsNotNone(val)
+            self.assertEqual(val.getStatus(), status)
+            ps = val.getCustomPropertySet()
+            self.assertEqual(ps.get("myname"), "myname")
+            self.assertEqual(ps.getArray("values"), range(100))
+        self.assertEqual(ps.get("logger.status"), "my logger special status")
+        self.assertEqual(val.getCustomPropertySet().nameCount(), 2)
+
     def assertValid(self, val, values, customValues):
         customCount = len(customValues)
         # get custom property names
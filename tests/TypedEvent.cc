@@ -0,0 +1,180 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2016  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/**
+ * @file TypedEvent.cc
+ *
+ * @ingroup ctrl/events
+ *
+ * @brief Test that a TypedEvent is sent in a form every Receiver decodes,
+ *        reads back only messages in that form, and is set from an Event
+ *        carrying its fields otherwise.
+ */
+
+#include <array>
+#include <string>
+#include <tuple>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE TypedEvent
+#include "boost/test/unit_test.hpp"
+
+#include "activemq/commands/ActiveMQTextMessage.h"
+
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/pex/exceptions.h"
+#include "lsst/ctrl/events.h"
+#include "lsst/ctrl/events/EventFactory.h"
+#include "lsst/ctrl/events/TypedEvent.h"
+
+using lsst::daf::base::PropertySet;
+namespace ctrlEvents = lsst::ctrl::events;
+
+namespace {
+
+struct CcdTemperature {
+    typedef std::tuple<int, double, std::string, bool> Types;
+    static std::array<ctrlEvents::TypedField, 4> const& fields() {
+        static constexpr std::array<ctrlEvents::TypedField, 4> f = {{
+            { "ccd", true }, { "temperature", false }, { "state", false }, { "cooling", false }
+        }};
+        return f;
+    }
+};
+
+typedef ctrlEvents::TypedEvent<CcdTemperature> CcdEvent;
+
+void fill(CcdEvent& event) {
+    event.set<0>(12);
+    event.set<1>(-98.5);
+    event.set<2>(std::string("cooling"));
+    event.set<3>(true);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(roundTrip) {
+    CcdEvent sent("myrun");
+    fill(sent);
+    activemq::commands::ActiveMQTextMessage msg;
+    sent.marshall(&msg);
+
+    // the filterable field is only in the header
+    BOOST_CHECK_EQUAL(msg.getIntProperty("ccd"), 12);
+    BOOST_CHECK_EQUAL(msg.getText().find("\"ccd\""), std::string::npos);
+
+    CcdEvent received;
+    BOOST_CHECK(received.unmarshall(&msg));
+    BOOST_CHECK_EQUAL(received.get<0>(), 12);
+    BOOST_CHECK_EQUAL(received.get<1>(), -98.5);
+    BOOST_CHECK_EQUAL(received.get<2>(), "cooling");
+    BOOST_CHECK_EQUAL(received.get<3>(), true);
+    BOOST_CHECK_EQUAL(received.getRunId(), "myrun");
+    BOOST_CHECK_EQUAL(received.getEventTime(), sent.getEventTime());
+}
+
+BOOST_AUTO_TEST_CASE(decodedAsEvent) {
+    CcdEvent sent("myrun");
+    fill(sent);
+    sent.set<2>(std::string("cooling \"down\""));
+    activemq::commands::ActiveMQTextMessage msg;
+    sent.marshall(&msg);
+
+    // a string with escapes is not read back directly
+    CcdEvent received;
+    BOOST_CHECK(!received.unmarshall(&msg));
+
+    // but any receiver decodes a TypedEvent as an ordinary Event
+    PTR(ctrlEvents::Event) event = ctrlEvents::EventFactory::createEvent(&msg);
+    CONST_PTR(PropertySet) ps = event->getPropertySet();
+    BOOST_CHECK_EQUAL(ps->get<int>("ccd"), 12);
+    BOOST_CHECK_EQUAL(ps->get<double>("temperature"), -98.5);
+    BOOST_CHECK_EQUAL(ps->get<std::string>("state"), "cooling \"down\"");
+    BOOST_CHECK_EQUAL(event->getRunId(), "myrun");
+
+    // and is set from one
+    CcdEvent assigned;
+    assigned.assign(*event);
+    BOOST_CHECK_EQUAL(assigned.get<0>(), 12);
+    BOOST_CHECK_EQUAL(assigned.get<2>(), "cooling \"down\"");
+    BOOST_CHECK_EQUAL(assigned.get<3>(), true);
+    BOOST_CHECK_EQUAL(assigned.getRunId(), "myrun");
+
+    PropertySet partial;
+    partial.set("ccd", 3);
+    ctrlEvents::Event missing(partial);
+    BOOST_CHECK_THROW(assigned.assign(missing), lsst::pex::exceptions::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(otherForms) {
+    CcdEvent sent("myrun");
+    fill(sent);
+
+    // messages which a Receiver has to complete first are left to it
+    std::vector<std::string> headers = {ctrlEvents::Event::COMPRESSION, ctrlEvents::Event::DICTIONARY,
+                                        ctrlEvents::Event::DELTA, ctrlEvents::Event::SEQUENCE,
+                                        ctrlEvents::Event::CHUNKSET, ctrlEvents::Event::CLAIMCHECK};
+    for (std::string const& header : headers) {
+        activemq::commands::ActiveMQTextMessage msg;
+        sent.marshall(&msg);
+        msg.setStringProperty(header, "1");
+        CcdEvent received;
+        received.set<0>(7);
+        BOOST_CHECK(!received.unmarshall(&msg));
+        BOOST_CHECK_EQUAL(received.get<0>(), 7);
+    }
+
+    // as are bodies in another form
+    std::vector<std::string> bodies = {
+        "{\"temperature\":{\"double\":\"1\"},\"state\":{\"string\":\"s\"}}",
+        "{\"temperature\":{\"int\":\"1\"},\"state\":{\"string\":\"s\"},\"cooling\":{\"bool\":\"true\"}}",
+        "{\"temperature\":{\"double\":\"1\"},\"state\":{\"string\":\"s\\\"\"},\"cooling\":{\"bool\":\"true\"}}",
+        "{\"temperature\":{\"double\":\"1\"},\"state\":{\"string\":\"s\"},\"cooling\":{\"bool\":\"true\"},"
+            "\"extra\":{\"int\":\"1\"}}"};
+    for (std::string const& body : bodies) {
+        activemq::commands::ActiveMQTextMessage msg;
+        sent.marshall(&msg);
+        msg.setText(body);
+        CcdEvent received;
+        BOOST_CHECK(!received.unmarshall(&msg));
+    }
+
+    // and headers without the filterable fields
+    activemq::commands::ActiveMQTextMessage msg;
+    msg.setText("{\"temperature\":{\"double\":\"1\"},\"state\":{\"string\":\"s\"},\"cooling\":{\"bool\":\"true\"}}");
+    CcdEvent received;
+    BOOST_CHECK(!received.unmarshall(&msg));
+    msg.setIntProperty("ccd", 4);
+    BOOST_CHECK(received.unmarshall(&msg));
+    BOOST_CHECK_EQUAL(received.get<0>(), 4);
+    BOOST_CHECK_EQUAL(received.get<2>(), "s");
+}
+
+BOOST_AUTO_TEST_CASE(fieldNames) {
+    typedef ctrlEvents::TypedFields<CcdTemperature, 1> Temperature;
+
+    // the names are made once, not for each event
+    BOOST_CHECK_EQUAL(Temperature::name(), "temperature");
+    BOOST_CHECK_EQUAL(&Temperature::name(), &Temperature::name());
+}